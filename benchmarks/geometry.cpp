@@ -0,0 +1,243 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+/* Microbenchmarks of the geometric operations that the packing spends most of
+its time in. Each is measured across a range of vertex counts, so that the
+complexity of the algorithms shows up as well as their constant factors. */
+
+#include <benchmark/benchmark.h> //To run and time the benchmarks.
+#include <cmath> //To generate regular polygons.
+#include <convack/convex_polygon.hpp> //The convex polygons to measure.
+#include <convack/point2.hpp> //To generate convex polygons.
+#include <convack/transformation.hpp> //To measure transforming points.
+#include <random> //To generate random point clouds.
+#include <vector> //To store the generated geometry.
+
+/*!
+ * Generate a regular polygon.
+ * \param num_vertices How many vertices the regular polygon gets.
+ * \param radius The distance from the centre to the vertices.
+ * \return The vertices of the regular polygon, counter-clockwise.
+ */
+std::vector<convack::Point2> regular_polygon(const size_t num_vertices, const double radius) {
+	const double pi = std::acos(-1);
+	std::vector<convack::Point2> vertices;
+	vertices.reserve(num_vertices);
+	for(size_t i = 0; i < num_vertices; ++i) {
+		const double angle = 2.0 * pi / num_vertices * i;
+		vertices.emplace_back(std::cos(angle) * radius, std::sin(angle) * radius);
+	}
+	return vertices;
+}
+
+/*!
+ * Generate random points in a square.
+ * \param num_points How many points to generate.
+ * \return The random points. The same number of points always gives the same
+ * points.
+ */
+std::vector<convack::Point2> random_points(const size_t num_points) {
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> distribution(-100, 100);
+	std::vector<convack::Point2> points;
+	points.reserve(num_points);
+	for(size_t i = 0; i < num_points; ++i) {
+		points.emplace_back(distribution(generator), distribution(generator));
+	}
+	return points;
+}
+
+/*!
+ * Measure a benchmark with the vertex counts to measure the operations on
+ * convex polygons with.
+ * \param benchmark The benchmark to give the vertex counts.
+ */
+void vertex_counts(benchmark::internal::Benchmark* benchmark) {
+	benchmark->DenseRange(3, 9)->RangeMultiplier(4)->Range(16, 4096)->Complexity(); //Dense at the bottom, where most parts are and where the kernels for small convex polygons are used.
+}
+
+/*!
+ * Measure computing the area of a convex polygon.
+ */
+void area(benchmark::State& state) {
+	const convack::ConvexPolygon convex_polygon(regular_polygon(state.range(0), 100));
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(convex_polygon.area());
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(area)->Apply(vertex_counts);
+
+/*!
+ * Measure testing whether a point is inside a convex polygon.
+ *
+ * The point is inside of the bounding box, so that the test doesn't end with
+ * the bounding box check.
+ */
+void contains(benchmark::State& state) {
+	const convack::ConvexPolygon convex_polygon(regular_polygon(state.range(0), 100));
+	const convack::Point2 point(50, 50);
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(convex_polygon.contains(point));
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(contains)->Apply(vertex_counts);
+
+/*!
+ * Measure testing whether two convex polygons collide, when they do.
+ *
+ * They overlap only slightly, so that all separating axes have to be tried.
+ */
+void collides_overlapping(benchmark::State& state) {
+	const convack::ConvexPolygon a(regular_polygon(state.range(0), 100));
+	convack::ConvexPolygon b(regular_polygon(state.range(0), 100));
+	b.translate(199, 0);
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a.collides(b));
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(collides_overlapping)->Apply(vertex_counts);
+
+/*!
+ * Measure testing whether two convex polygons collide, when they are close but
+ * don't.
+ *
+ * Their bounding boxes overlap, so the test doesn't end with the bounding box
+ * check.
+ */
+void collides_apart(benchmark::State& state) {
+	const convack::ConvexPolygon a(regular_polygon(state.range(0), 100));
+	convack::ConvexPolygon b(regular_polygon(state.range(0), 100));
+	b.translate(150, 150);
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a.collides(b));
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(collides_apart)->Apply(vertex_counts);
+
+/*!
+ * Measure constructing the convex hull around random points.
+ *
+ * Only few of the points end up in the result.
+ */
+void convex_hull_random(benchmark::State& state) {
+	const std::vector<convack::Point2> points = random_points(state.range(0));
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(convack::ConvexPolygon::convex_hull(points));
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(convex_hull_random)->DenseRange(2, 16, 2)->RangeMultiplier(4)->Range(64, 16384)->Complexity(); //Dense at the bottom, to see where the algorithm switches.
+
+/*!
+ * Measure constructing the convex hull around points on a circle.
+ *
+ * All of the points end up in the result, which is the worst case for gift
+ * wrapping.
+ */
+void convex_hull_circle(benchmark::State& state) {
+	const std::vector<convack::Point2> points = regular_polygon(state.range(0), 100);
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(convack::ConvexPolygon::convex_hull(points));
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(convex_hull_circle)->DenseRange(2, 16, 2)->RangeMultiplier(4)->Range(64, 16384)->Complexity();
+
+/*!
+ * Measure constructing the convex hull around two convex polygons, like the
+ * beam search does when it adds a convex polygon to a packing.
+ */
+void convex_hull_pair(benchmark::State& state) {
+	std::vector<convack::ConvexPolygon> convex_polygons = {
+		convack::ConvexPolygon(regular_polygon(state.range(0), 100)),
+		convack::ConvexPolygon(regular_polygon(state.range(0), 100))
+	};
+	convex_polygons[1].translate(200, 0);
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(convack::ConvexPolygon::convex_hull(convex_polygons));
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(convex_hull_pair)->Apply(vertex_counts);
+
+/*!
+ * Measure merging the convex hull of two convex polygons directly, without
+ * putting them in a list.
+ */
+void convex_hull_merge(benchmark::State& state) {
+	const convack::ConvexPolygon a(regular_polygon(state.range(0), 100));
+	convack::ConvexPolygon b(regular_polygon(state.range(0), 100));
+	b.translate(200, 0);
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(convack::ConvexPolygon::convex_hull(a, b));
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(convex_hull_merge)->Apply(vertex_counts);
+
+/*!
+ * Measure constructing the convex hull around many small convex polygons.
+ */
+void convex_hull_many(benchmark::State& state) {
+	std::vector<convack::ConvexPolygon> convex_polygons;
+	const std::vector<convack::Point2> offsets = random_points(state.range(0));
+	for(const convack::Point2& offset : offsets) {
+		convex_polygons.emplace_back(regular_polygon(8, 5));
+		convex_polygons.back().translate(offset.x, offset.y);
+	}
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(convack::ConvexPolygon::convex_hull(convex_polygons));
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(convex_hull_many)->RangeMultiplier(4)->Range(2, 2048)->Complexity();
+
+/*!
+ * Measure transforming points one by one.
+ */
+void transformation_apply(benchmark::State& state) {
+	const std::vector<convack::Point2> points = random_points(state.range(0));
+	convack::Transformation transformation;
+	transformation.rotate(0.5).translate(10, 20);
+	for(auto _ : state) {
+		for(const convack::Point2& point : points) {
+			benchmark::DoNotOptimize(transformation.apply(point));
+		}
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(transformation_apply)->Apply(vertex_counts);
+
+/*!
+ * Measure transforming a list of points at once.
+ */
+void transformation_apply_list(benchmark::State& state) {
+	std::vector<convack::Point2> points = random_points(state.range(0));
+	convack::Transformation transformation;
+	transformation.rotate(0.5).translate(10, 20);
+	for(auto _ : state) {
+		transformation.apply(points);
+		benchmark::ClobberMemory();
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(transformation_apply_list)->Apply(vertex_counts);
+
+/*!
+ * Measure rotating a convex polygon.
+ */
+void rotate(benchmark::State& state) {
+	convack::ConvexPolygon convex_polygon(regular_polygon(state.range(0), 100));
+	for(auto _ : state) {
+		convex_polygon.rotate(0.5);
+		benchmark::ClobberMemory();
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(rotate)->Apply(vertex_counts);
\ No newline at end of file
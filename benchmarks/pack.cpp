@@ -0,0 +1,119 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+/* End-to-end benchmarks of packing synthetic sets of convex polygons, across
+beam widths. The first argument of each benchmark is the beam width, the second
+the number of convex polygons to pack. */
+
+#include <benchmark/benchmark.h> //To run and time the benchmarks.
+#include <cmath> //To generate regular polygons.
+#include <convack/convex_polygon.hpp> //The convex polygons to pack.
+#include <convack/point2.hpp> //To generate convex polygons.
+#include <convack/scene.hpp> //To pack the convex polygons.
+#include <random> //To generate random convex polygons.
+#include <vector> //To store the convex polygons to pack.
+
+/*!
+ * Generate regular polygons, like in the regular_polygons example.
+ * \param num_polygons How many regular polygons to generate. They get 3 up to
+ * 10 sides, repeating.
+ * \return The regular polygons, all around the coordinate origin.
+ */
+std::vector<convack::ConvexPolygon> regular_polygons(const size_t num_polygons) {
+	const double pi = std::acos(-1);
+	std::vector<convack::ConvexPolygon> result;
+	for(size_t polygon = 0; polygon < num_polygons; ++polygon) {
+		const size_t num_sides = 3 + polygon % 8;
+		std::vector<convack::Point2> vertices;
+		for(size_t i = 0; i < num_sides; ++i) {
+			const double angle = 2.0 * pi / num_sides * i;
+			vertices.emplace_back(std::cos(angle) * 10, std::sin(angle) * 10);
+		}
+		result.emplace_back(vertices);
+	}
+	return result;
+}
+
+/*!
+ * Generate random convex polygons, as the convex hulls around random points.
+ * \param num_polygons How many convex polygons to generate.
+ * \return The random convex polygons. The same number always gives the same
+ * convex polygons.
+ */
+std::vector<convack::ConvexPolygon> random_polygons(const size_t num_polygons) {
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> coordinate(-10, 10);
+	std::uniform_int_distribution<size_t> num_points(3, 20);
+	std::vector<convack::ConvexPolygon> result;
+	for(size_t polygon = 0; polygon < num_polygons; ++polygon) {
+		std::vector<convack::Point2> points;
+		const size_t size = num_points(generator);
+		for(size_t i = 0; i < size; ++i) {
+			points.emplace_back(coordinate(generator), coordinate(generator));
+		}
+		result.push_back(convack::ConvexPolygon::convex_hull(points));
+	}
+	return result;
+}
+
+/*!
+ * Generate many copies of a few shapes, like an order batch with repeated
+ * parts.
+ * \param num_polygons How many convex polygons to generate.
+ * \return Copies of four random convex polygons.
+ */
+std::vector<convack::ConvexPolygon> repeated_polygons(const size_t num_polygons) {
+	const std::vector<convack::ConvexPolygon> shapes = random_polygons(4);
+	std::vector<convack::ConvexPolygon> result;
+	for(size_t polygon = 0; polygon < num_polygons; ++polygon) {
+		result.push_back(shapes[polygon % shapes.size()]);
+	}
+	return result;
+}
+
+/*!
+ * Measure packing a set of convex polygons.
+ * \param state The benchmark state, with the beam width and the number of
+ * convex polygons as arguments.
+ * \param generate The function that generates the convex polygons to pack.
+ */
+void pack(benchmark::State& state, std::vector<convack::ConvexPolygon> (*generate)(const size_t)) {
+	const std::vector<convack::ConvexPolygon> convex_polygons = generate(state.range(1));
+	convack::Scene scene;
+	scene.set_beam_width(state.range(0));
+	for(auto _ : state) {
+		state.PauseTiming(); //Don't measure copying the input.
+		std::vector<convack::ConvexPolygon> packing = convex_polygons;
+		state.ResumeTiming();
+		scene.pack(packing);
+		benchmark::DoNotOptimize(packing.data());
+	}
+}
+BENCHMARK_CAPTURE(pack, regular_polygons, regular_polygons)->ArgsProduct({{1, 10, 100}, {8, 32}})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(pack, random_polygons, random_polygons)->ArgsProduct({{1, 10, 100}, {8, 32}})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(pack, repeated_polygons, repeated_polygons)->ArgsProduct({{1, 10, 100}, {8, 32}})->Unit(benchmark::kMillisecond);
+
+/*!
+ * Measure packing a batch of small jobs, compared to packing them one by one.
+ * \param state The benchmark state, with the number of jobs and the number of
+ * threads as arguments. A thread count of 0 uses all processor cores.
+ */
+void pack_batch(benchmark::State& state) {
+	std::vector<std::vector<convack::ConvexPolygon>> jobs;
+	for(int64_t job = 0; job < state.range(0); ++job) {
+		jobs.push_back(repeated_polygons(8));
+	}
+	convack::Scene scene;
+	scene.set_num_threads(state.range(1));
+	for(auto _ : state) {
+		state.PauseTiming(); //Don't measure copying the input.
+		std::vector<std::vector<convack::ConvexPolygon>> batch = jobs;
+		state.ResumeTiming();
+		scene.pack_batch(batch);
+		benchmark::DoNotOptimize(batch.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(pack_batch)->ArgsProduct({{16, 64}, {1, 0}})->Unit(benchmark::kMillisecond)->UseRealTime();
\ No newline at end of file
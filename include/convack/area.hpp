@@ -6,12 +6,26 @@
 #ifndef CONVACK_AREA
 #define CONVACK_AREA
 
+#ifdef CONVACK_FIXED_POINT
+#include <cstdint> //For int64_t.
+#endif
+
 namespace convack {
 
+#ifdef CONVACK_FIXED_POINT
+/*!
+ * Type to use to denote two-dimensional areas.
+ *
+ * With the `CONVACK_FIXED_POINT` option, areas are integers that are wide
+ * enough to hold the product of two coordinates without overflowing.
+ */
+typedef int64_t area_t;
+#else
 /*!
  * Type to use to denote two-dimensional areas.
  */
 typedef float area_t;
+#endif
 
 }
 
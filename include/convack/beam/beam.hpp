@@ -0,0 +1,149 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_BEAM
+#define CONVACK_BEAM
+
+#include <cstddef> //For size_t.
+#include <vector> //To store the candidates in the beam.
+
+namespace convack {
+
+class PackingCandidate;
+
+/*!
+ * The collection of the best candidates found so far at one depth of the beam
+ * search.
+ *
+ * The beam has a fixed capacity, equal to the beam width of the search. Once it
+ * is full, a new candidate is only accepted if it is better than the worst
+ * candidate in the beam, which is then pushed out. This way the beam never
+ * holds more than its capacity, no matter how many candidates are offered to
+ * it.
+ *
+ * Before constructing a candidate, the search can ask whether the beam would
+ * accept a candidate with a certain score. If not, the candidate doesn't need
+ * to be constructed at all.
+ *
+ * Candidates are ordered by their score. If two candidates have the same score,
+ * they are ordered by an order number given when inserting them. This makes the
+ * selection of the beam deterministic, regardless of the order in which
+ * candidates are inserted.
+ */
+class Beam {
+public:
+	/*!
+	 * Creates a new, empty beam.
+	 * \param capacity The maximum number of candidates in the beam. Must be at
+	 * least 1.
+	 */
+	Beam(const size_t capacity);
+
+	/*!
+	 * Test whether the beam would accept a candidate with a certain score.
+	 * \param score The score of the candidate. Lower is better.
+	 * \param order The order number of the candidate, to break ties with
+	 * candidates that have the same score. Lower is better.
+	 * \return `true` if the candidate would be inserted in the beam, or
+	 * `false` if it would be rejected right away.
+	 */
+	bool accepts(const double score, const size_t order) const;
+
+	/*!
+	 * Offer a candidate to the beam.
+	 *
+	 * If the beam is full, either the new candidate or the worst candidate in
+	 * the beam is not kept. That candidate is returned, so that the caller can
+	 * dispose of it.
+	 * \param candidate The candidate to insert.
+	 * \param order The order number of the candidate, to break ties with
+	 * candidates that have the same score. Lower is better.
+	 * \return The candidate that didn't fit in the beam, or `nullptr` if all
+	 * candidates could be kept.
+	 */
+	PackingCandidate* insert(PackingCandidate* candidate, const size_t order);
+
+	/*!
+	 * Move all candidates of another beam into this beam.
+	 *
+	 * The other beam is empty afterwards. The candidates that don't fit in this
+	 * beam are added to a list, so that the caller can dispose of them.
+	 * \param other The beam to move the candidates out of.
+	 * \param rejected A list to add the candidates to that don't fit.
+	 */
+	void merge(Beam& other, std::vector<PackingCandidate*>& rejected);
+
+	/*!
+	 * Take all candidates out of the beam, sorted from best to worst.
+	 *
+	 * The beam is empty afterwards.
+	 * \return The candidates that were in the beam, best first.
+	 */
+	std::vector<PackingCandidate*> take();
+
+	/*!
+	 * Get the maximum number of candidates in the beam.
+	 * \return The capacity of the beam.
+	 */
+	size_t get_capacity() const;
+
+	/*!
+	 * Get the number of candidates currently in the beam.
+	 * \return The number of candidates in the beam.
+	 */
+	size_t size() const;
+
+	/*!
+	 * Test whether the beam is empty.
+	 * \return `true` if there are no candidates in the beam, or `false` if
+	 * there are.
+	 */
+	bool empty() const;
+
+private:
+	/*!
+	 * A candidate in the beam, along with what it is sorted by.
+	 */
+	struct Entry {
+		/*!
+		 * The candidate in the beam.
+		 */
+		PackingCandidate* candidate;
+
+		/*!
+		 * The score of the candidate. Lower is better.
+		 */
+		double score;
+
+		/*!
+		 * The order number of the candidate, to break ties. Lower is better.
+		 */
+		size_t order;
+
+		/*!
+		 * Test whether this entry is better than another entry.
+		 * \param other The entry to compare with.
+		 * \return `true` if this entry is better, or `false` if it's worse.
+		 */
+		bool operator <(const Entry& other) const;
+	};
+
+	/*!
+	 * The maximum number of candidates in the beam.
+	 */
+	size_t capacity;
+
+	/*!
+	 * The candidates in the beam.
+	 *
+	 * This is a heap with the worst candidate on top, so that it can be found
+	 * and replaced quickly.
+	 */
+	std::vector<Entry> entries;
+};
+
+}
+
+#endif
\ No newline at end of file
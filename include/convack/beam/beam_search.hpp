@@ -6,12 +6,30 @@
 #ifndef CONVACK_BEAM_SEARCH
 #define CONVACK_BEAM_SEARCH
 
+#include <chrono> //To measure the time spent at each depth.
+#include <cstddef> //For size_t.
+#include <limits> //To mark convex polygons that were not placed.
+#include <memory> //To share no-fit polygons with the cache.
 #include <vector> //To process a list of convex polygons.
 
+#include "area.hpp" //To store the areas of the rotated convex polygons.
+#include "cancellation.hpp" //To stop the search when it is cancelled.
+#include "convex_polygon.hpp" //To store the rotated convex polygons.
+#include "coordinate.hpp" //To compute placements of convex polygons.
+#include "pack_progress.hpp" //To report how far the search has come.
+#include "point2.hpp" //To store the translations of the no-fit polygons.
+#include "spatial_index.hpp" //To index the packing of the candidate being expanded.
+
 namespace convack {
 
-class ConvexPolygon;
+class Beam;
+class CandidateArena;
+class Layout;
+class NoFitPolygon;
+class NoFitPolygonCache;
+struct PackStatistics;
 class PackingCandidate;
+class SearchBudget;
 class Scene;
 
 /*!
@@ -22,6 +40,21 @@ class Scene;
  * tree structure of all possible orders in which to pack objects. At any point
  * it keeps track of a number of the most optimal candidates so far, and
  * explores those candidates further.
+ *
+ * Convex polygons with the same shape are interchangeable. Packing one copy or
+ * the other leads to the same packing, so the search only considers the first
+ * unpacked copy of each shape. Otherwise the beam would fill up with
+ * candidates that only differ in which copy went where.
+ *
+ * The search can be given a budget of time or evaluations. If that runs out,
+ * the search stops expanding its beam and completes the best candidate so far
+ * greedily, by adding the best child at a time. If the search is cancelled,
+ * it stops the same way but there is no need to complete anything.
+ *
+ * If the scene has a container, placements that stick out of it are dropped
+ * before they are scored. The obstacles of the scene are treated as if they
+ * were packed in every candidate, except that they don't count towards the
+ * area of the packing.
  */
 class BeamSearch {
 public:
@@ -31,26 +64,454 @@ public:
 	 * to use for the packing.
 	 * \param convex_polygons The convex polygons to pack. The convex polygons
 	 * are packed in-place by adjusting their transformations. The result will
-	 * be stored in this same list of convex polygons.
+	 * be stored in this same list of convex polygons. Convex polygons that
+	 * don't fit in the container of the scene are left as they were.
+	 * \param arena The memory to store the candidates of the search in. This
+	 * is reset at the start of the search, so it can be reused for multiple
+	 * searches.
+	 * \param cache The no-fit polygons computed in this and earlier searches,
+	 * to reuse them for copies of the same shapes.
+	 * \param statistics The measurements of this search will be added to
+	 * these statistics.
+	 * \param num_threads How many threads to expand the beam with. If 0, as
+	 * many threads as the computer has processor cores. This is normally the
+	 * setting of the scene, but a batch of packings runs each search on a
+	 * single thread instead.
+	 * \param progress A function to call after each depth of the search. May
+	 * be empty.
+	 * \param cancellation A signal to stop the search. If the search gets
+	 * cancelled, the convex polygons are left as they were.
 	 */
-	static void pack(const Scene& scene, std::vector<ConvexPolygon>& convex_polygons);
+	static void pack(const Scene& scene, std::vector<ConvexPolygon>& convex_polygons, CandidateArena& arena, NoFitPolygonCache& cache, PackStatistics& statistics, size_t num_threads, const ProgressCallback& progress = ProgressCallback(), const Cancellation& cancellation = Cancellation());
+
+	/*!
+	 * Packs a number of convex polygons against an earlier layout, and commits
+	 * them to that layout.
+	 *
+	 * The convex polygons of the layout stay where they are. The search only
+	 * decides where to put the new convex polygons, so its depth is the number
+	 * of new convex polygons, regardless of how big the layout is. The roots of
+	 * the search are placed against the layout, and the scores count the
+	 * layout as part of the packing.
+	 * \param scene The scene to pack them in, including obstacles and settings
+	 * to use for the packing.
+	 * \param convex_polygons The new convex polygons to pack. The result will
+	 * be stored in this same list. Convex polygons that don't fit in the
+	 * container of the scene are left as they were, and are not added to the
+	 * layout.
+	 * \param layout The convex polygons placed by earlier packings. The newly
+	 * placed convex polygons are added to it.
+	 * \param arena The memory to store the candidates of the search in.
+	 * \param cache The no-fit polygons computed in this and earlier searches.
+	 * \param statistics The measurements of this search will be added to
+	 * these statistics.
+	 * \param num_threads How many threads to expand the beam with. If 0, as
+	 * many threads as the computer has processor cores.
+	 */
+	static void pack_more(const Scene& scene, std::vector<ConvexPolygon>& convex_polygons, Layout& layout, CandidateArena& arena, NoFitPolygonCache& cache, PackStatistics& statistics, size_t num_threads);
 
 private:
 	/*!
-	 * Compares entries in the `best_orders` priority queue of the beam search.
+	 * The number of directions from which to try to place a new convex polygon
+	 * against the packing so far.
+	 *
+	 * The directions are evenly distributed around the circle.
+	 */
+	static constexpr size_t placement_directions = 8;
+
+	/*!
+	 * How far to move a convex polygon out when it still collides after placing
+	 * it against the packing, due to rounding errors.
+	 *
+	 * This is relative to the sizes of the packing and the convex polygon.
+	 * Every next attempt moves it out twice as far.
+	 */
+	static constexpr double placement_clearance = 0.000001;
+
+	/*!
+	 * How many times to try moving a convex polygon out further if it still
+	 * collides after placing it against the packing.
+	 */
+	static constexpr size_t placement_attempts = 20;
+
+	/*!
+	 * The most steps to sweep a convex polygon along the line through the
+	 * packing in, while looking for the convex polygons of an earlier layout
+	 * that it could touch.
+	 *
+	 * Very small convex polygons get swept in fewer, longer steps. That finds
+	 * more convex polygons than necessary, but doesn't need hundreds of
+	 * queries to get through the empty space around the layout.
+	 */
+	static constexpr size_t max_sweep_steps = 64;
+
+	/*!
+	 * The rotation index to look up the no-fit polygons of obstacles with in
+	 * the cache.
+	 *
+	 * Obstacles are never rotated, so they are always in the rotation they
+	 * were given in, like the first rotation of the convex polygons.
+	 */
+	static constexpr size_t obstacle_rotation = 0;
+
+	/*!
+	 * The rotation index that marks convex polygons that could not be placed.
+	 */
+	static constexpr size_t unplaced = std::numeric_limits<size_t>::max();
+
+	/*!
+	 * Packs a number of convex polygons, continuing from an earlier layout.
+	 *
+	 * This is the actual search behind \ref pack and \ref pack_more.
+	 * \param scene The scene to pack them in.
+	 * \param layout The convex polygons placed by earlier packings, which stay
+	 * where they are. May be empty to start from scratch.
+	 * \param convex_polygons The convex polygons to pack. The result will be
+	 * stored in this same list.
+	 * \param rotations For each convex polygon, the index of the rotation it
+	 * was placed in will be stored here, or \ref unplaced if it was not placed.
+	 * \param arena The memory to store the candidates of the search in.
+	 * \param cache The no-fit polygons computed in this and earlier searches.
+	 * \param statistics The measurements of this search will be added to
+	 * these statistics.
+	 * \param num_threads How many threads to expand the beam with.
+	 * \param progress A function to call after each depth of the search. May
+	 * be empty.
+	 * \param cancellation A signal to stop the search.
+	 */
+	static void search(const Scene& scene, const Layout& layout, std::vector<ConvexPolygon>& convex_polygons, std::vector<size_t>& rotations, CandidateArena& arena, NoFitPolygonCache& cache, PackStatistics& statistics, size_t num_threads, const ProgressCallback& progress, const Cancellation& cancellation);
+
+	/*!
+	 * A convex polygon in one of the rotations that it may be packed in.
 	 *
-	 * The entry with the lowest score is considered the best entry.
+	 * These are computed once at the start of the search, so that expanding
+	 * candidates doesn't need to rotate anything.
 	 */
-	struct LowestScore {
+	struct Variant {
 		/*!
-		 * Executes the comparison operator.
-		 * \param a The left-hand side candidate to compare.
-		 * \param b The right-hand side candidate to compare.
-		 * \return Whether the left-hand side is considered better than the
-		 * right-hand side.
+		 * The rotated convex polygon.
 		 */
-		bool operator ()(const PackingCandidate& a, const PackingCandidate& b);
+		ConvexPolygon convex_polygon;
+
+		/*!
+		 * The area of the rotated convex polygon.
+		 */
+		area_t area;
 	};
+
+	/*!
+	 * Memory that a thread reuses for every candidate that it expands.
+	 *
+	 * Expanding a candidate needs a number of lists and convex polygons that
+	 * are only used until the candidate is expanded. Allocating those again
+	 * for every candidate would make the allocator the bottleneck of the
+	 * search, like with the candidates themselves (see \ref CandidateArena).
+	 * Each thread has its own, so the threads don't need to wait for each
+	 * other.
+	 */
+	struct Scratch {
+		/*!
+		 * Creates empty memory to expand candidates with.
+		 * \param cell_size The size of the cells of the index of the packing.
+		 * This stays the same for the whole search, so that the cells can be
+		 * reused from one candidate to the next.
+		 */
+		Scratch(const coordinate_t cell_size);
+
+		/*!
+		 * For each convex polygon, whether it is packed in the candidate.
+		 */
+		std::vector<bool> packed;
+
+		/*!
+		 * For each shape, by the index of the first convex polygon of that
+		 * shape, whether a copy of it was already placed in the candidate.
+		 */
+		std::vector<bool> shape_placed;
+
+		/*!
+		 * The convex polygons packed in the candidate.
+		 */
+		std::vector<const ConvexPolygon*> packing;
+
+		/*!
+		 * The rotation index of each of the packed convex polygons.
+		 */
+		std::vector<size_t> packing_rotations;
+
+		/*!
+		 * The rotated convex polygons that each of the packed convex polygons
+		 * was translated from.
+		 */
+		std::vector<const ConvexPolygon*> packing_shapes;
+
+		/*!
+		 * An index of the packed convex polygons.
+		 */
+		SpatialIndex packing_index;
+
+		/*!
+		 * The no-fit polygons of the packed convex polygons and obstacles with
+		 * the convex polygon being placed.
+		 */
+		std::vector<std::shared_ptr<const NoFitPolygon>> no_fit_polygons;
+
+		/*!
+		 * For each of the no-fit polygons, the translation that moves it to the
+		 * actual positions of the convex polygons.
+		 */
+		std::vector<Point2> no_fit_translations;
+
+		/*!
+		 * The convex polygons of an earlier layout near one step of the line
+		 * along which a convex polygon is placed.
+		 */
+		std::vector<size_t> layout_found;
+
+		/*!
+		 * The convex polygons of an earlier layout near the previous step of
+		 * that line.
+		 */
+		std::vector<size_t> layout_previous_found;
+
+		/*!
+		 * The extreme vertices of the convex hull of the candidate, to compute
+		 * its core with.
+		 */
+		std::vector<Point2> core_extremes;
+
+		/*!
+		 * The core of the convex hull of the candidate.
+		 */
+		ConvexPolygon hull_core;
+
+		/*!
+		 * The convex polygon being placed, moved to where it is being tried.
+		 */
+		ConvexPolygon placed;
+
+		/*!
+		 * The convex hull around the core and the placed convex polygon, to
+		 * bound the score of the child with.
+		 */
+		ConvexPolygon core_hull;
+
+		/*!
+		 * The convex hull around the packing of the child.
+		 */
+		ConvexPolygon convex_hull;
+	};
+
+	/*!
+	 * Rotate each of the convex polygons in each of the allowed rotations.
+	 * \param convex_polygons The convex polygons to rotate.
+	 * \param rotations The angles to rotate them over, in radians. If there
+	 * are none, the convex polygons are only packed as they are.
+	 * \return For each convex polygon, its variant in each rotation, in the
+	 * order of the rotations.
+	 */
+	static std::vector<std::vector<Variant>> rotate_variants(const std::vector<ConvexPolygon>& convex_polygons, const std::vector<double>& rotations);
+
+	/*!
+	 * Add the time since the previous depth was done to the statistics.
+	 * \param depth_start The time when the previous depth was done. This is
+	 * updated to the current time.
+	 * \param statistics The statistics to add the time of this depth to.
+	 */
+	static void record_depth_time(std::chrono::steady_clock::time_point& depth_start, PackStatistics& statistics);
+
+	/*!
+	 * Tell the caller how far the search has come, if they want to know.
+	 * \param progress The function to report the progress to. May be empty.
+	 * \param best The best candidate at the current depth.
+	 * \param num_convex_polygons How many convex polygons there are to pack.
+	 */
+	static void report_progress(const ProgressCallback& progress, const PackingCandidate* best, const size_t num_convex_polygons);
+
+	/*!
+	 * Find which convex polygons have the same shape.
+	 *
+	 * The convex polygons are grouped by the hash of their shape first, so
+	 * that only convex polygons with the same hash need to be compared.
+	 * \param convex_polygons The convex polygons to group.
+	 * \return For each convex polygon, the index of the first convex polygon
+	 * with the same shape. For the first of each shape, that's its own index.
+	 */
+	static std::vector<size_t> group_shapes(const std::vector<ConvexPolygon>& convex_polygons);
+
+	/*!
+	 * Generate the child candidates of all candidates in the beam.
+	 *
+	 * The candidates in the beam are independent of each other, so they are
+	 * expanded in parallel. Each thread expands a contiguous part of the beam
+	 * and keeps the best children it found in its own beam. Every child gets an
+	 * order number that only depends on its position in the search tree, so
+	 * merging the beams of all threads gives the same result as expanding the
+	 * beam on a single thread.
+	 * \param scene The scene with the container and obstacles to pack in.
+	 * \param layout The convex polygons placed by earlier packings, which the
+	 * children are placed against as well.
+	 * \param beam The candidates to expand.
+	 * \param convex_polygons All of the convex polygons that need to get
+	 * packed.
+	 * \param arena The memory to create the children in.
+	 * \param shapes For each convex polygon, the index of the first convex
+	 * polygon with the same shape.
+	 * \param variants For each convex polygon, its variant in each rotation.
+	 * \param cache The no-fit polygons computed so far.
+	 * \param budget The limits on the search. Once they run out, the threads
+	 * stop expanding candidates, so only part of the beam may get expanded.
+	 * Deterministic packings expand the whole beam regardless.
+	 * \param thread_beams One beam for each thread to add the new child
+	 * candidates to. The number of beams determines how many threads are used.
+	 * \param thread_scratch The memory for each thread to expand its
+	 * candidates with. There must be at least as many as beams.
+	 * \param statistics The counters of each thread are collected into these
+	 * statistics.
+	 */
+	static void expand_beam(const Scene& scene, const Layout& layout, const std::vector<PackingCandidate*>& beam, const std::vector<ConvexPolygon>& convex_polygons, const std::vector<size_t>& shapes, const std::vector<std::vector<Variant>>& variants, CandidateArena& arena, NoFitPolygonCache& cache, SearchBudget& budget, std::vector<Beam>& thread_beams, std::vector<Scratch>& thread_scratch, PackStatistics& statistics);
+
+	/*!
+	 * Generate the child candidates of a candidate in the search tree.
+	 *
+	 * Each child packs one of the convex polygons that are not yet packed in
+	 * the candidate. The convex polygon is placed against the packing so far
+	 * in each of the allowed rotations, from a number of directions. Placements
+	 * that don't fit in the container are dropped right away. Children that
+	 * wouldn't make it into the beam are not constructed at all.
+	 *
+	 * Apart from the children that make it into the beam, this doesn't
+	 * allocate memory once the scratch memory of the thread is large enough.
+	 * \param scene The scene with the container and obstacles to pack in.
+	 * \param layout The convex polygons placed by earlier packings, which the
+	 * children are placed against as well.
+	 * \param candidate The candidate to expand.
+	 * \param candidate_index The position of the candidate in the beam, to
+	 * give its children their order numbers.
+	 * \param convex_polygons All of the convex polygons that need to get
+	 * packed.
+	 * \param arena The memory to create the children in.
+	 * \param shapes For each convex polygon, the index of the first convex
+	 * polygon with the same shape. Of the unpacked convex polygons with the
+	 * same shape, only the first is placed.
+	 * \param variants For each convex polygon, its variant in each rotation.
+	 * Each of them is placed.
+	 * \param cache The no-fit polygons computed so far.
+	 * \param scratch The memory of the current thread to expand with.
+	 * \param beam The beam to add the new child candidates to.
+	 * \return How many children were evaluated.
+	 */
+	static size_t expand(const Scene& scene, const Layout& layout, PackingCandidate* candidate, const size_t candidate_index, const std::vector<ConvexPolygon>& convex_polygons, const std::vector<size_t>& shapes, const std::vector<std::vector<Variant>>& variants, CandidateArena& arena, NoFitPolygonCache& cache, Scratch& scratch, Beam& beam);
+
+	/*!
+	 * Place the first convex polygon of a packing in the scene.
+	 *
+	 * If the scene has neither a container nor obstacles, the convex polygon
+	 * stays where it is. Otherwise it is placed against the obstacles like it
+	 * would be placed against a packing, centred on the container if there is
+	 * one, or else on where the convex polygon already is. Each direction is
+	 * tried in turn, until a placement fits in the container.
+	 * \param scene The scene with the container and obstacles to pack in.
+	 * \param cache The no-fit polygons computed so far.
+	 * \param convex_polygon The convex polygon to place.
+	 * \param rotation The rotation index of the convex polygon, to look up its
+	 * no-fit polygons with.
+	 * \param placed The convex polygon, moved to its place, will be stored
+	 * here.
+	 * \return `true` if the convex polygon could be placed, or `false` if it
+	 * doesn't fit in the container from any of the directions.
+	 */
+	static bool place_root(const Scene& scene, NoFitPolygonCache& cache, const ConvexPolygon& convex_polygon, const size_t rotation, ConvexPolygon& placed);
+
+	/*!
+	 * Compute the directions from which to place new convex polygons.
+	 * \param direction_x The X components of the unit vectors of the
+	 * \ref placement_directions directions will be stored here.
+	 * \param direction_y The Y components of the unit vectors of the
+	 * directions will be stored here.
+	 */
+	static void compute_directions(double* direction_x, double* direction_y);
+
+	/*!
+	 * Place a convex polygon against the packing of a candidate so that it
+	 * touches the packing, but doesn't collide with it.
+	 *
+	 * The convex polygon is moved from far away towards the centre of the
+	 * packing, along a given direction, until it would collide with one of the
+	 * packed convex polygons, obstacles or convex polygons of the layout. Where that happens follows directly
+	 * from the no-fit polygons, so no collision needs to be tested along the
+	 * way.
+	 * \param packing_centre The centre of the bounding box around the packing
+	 * to place the convex polygon against.
+	 * \param packing_radius The distance from that centre to the corners of
+	 * the bounding box.
+	 * \param obstacle_index An index of the obstacles in the scene, to verify
+	 * that the placement doesn't collide with them either.
+	 * \param layout The convex polygons placed by earlier packings. Only the
+	 * no-fit polygons of those near the line are looked up, and their index
+	 * verifies that the placement doesn't collide with them.
+	 * \param cache The cache to get the no-fit polygons of the layout from.
+	 * \param convex_polygon The convex polygon to place.
+	 * \param rotation The rotation index of the convex polygon, to look up its
+	 * no-fit polygons with.
+	 * \param direction_x The X component of the unit vector pointing from the
+	 * centre of the packing towards where the convex polygon must be placed.
+	 * \param direction_y The Y component of the unit vector pointing from the
+	 * centre of the packing towards where the convex polygon must be placed.
+	 * \param scratch The memory of the current thread. Its no-fit polygons
+	 * and their translations must be those of each of the packed convex
+	 * polygons and obstacles with the convex polygon to place, and its packing
+	 * index must contain the packed convex polygons, to verify that the
+	 * placement doesn't collide with them. The convex polygon, moved to its new
+	 * place, is stored in its placed convex polygon. If no place was found,
+	 * that is left somewhere along the line.
+	 * \return `true` if a place was found, or `false` if the convex polygon
+	 * still collided with something after moving it out a few times.
+	 */
+	static bool place(const Point2& packing_centre, const coordinate_t packing_radius, const SpatialIndex& obstacle_index, const Layout& layout, NoFitPolygonCache& cache, const ConvexPolygon& convex_polygon, const size_t rotation, const double direction_x, const double direction_y, Scratch& scratch);
+
+	/*!
+	 * Find how far a convex polygon must move out along a line through the
+	 * packing to get past the convex polygons of an earlier layout.
+	 *
+	 * The layout is inside the convex hull of every candidate, so the line
+	 * crosses it. Only the convex polygons close to the line can stop the
+	 * convex polygon, so only their no-fit polygons are looked up. The line is
+	 * searched from far away inwards, and the search stops as soon as the
+	 * rest of the layout would be left behind anyway. That way the placement
+	 * doesn't get slower as the layout grows.
+	 * \param layout The earlier layout to move past.
+	 * \param cache The cache to get the no-fit polygons from.
+	 * \param convex_polygon The convex polygon to place.
+	 * \param rotation The rotation index of the convex polygon, to look up its
+	 * no-fit polygons with.
+	 * \param origin The translation that puts the centre of the convex polygon
+	 * on the centre of the packing.
+	 * \param reach How far the convex polygon can move out along the line
+	 * while it can still touch the layout.
+	 * \param direction_x The X component of the unit vector pointing from the
+	 * centre of the packing towards where the convex polygon must be placed.
+	 * \param direction_y The Y component of the unit vector pointing from the
+	 * centre of the packing towards where the convex polygon must be placed.
+	 * \param distance How far the convex polygon must move out already, to get
+	 * past the packing and the obstacles.
+	 * \param found Memory to find the convex polygons near each step in.
+	 * \param previous_found Memory to remember the convex polygons near the
+	 * previous step in.
+	 * \return How far the convex polygon must move out to get past the layout
+	 * as well.
+	 */
+	static double layout_exit_distance(const Layout& layout, NoFitPolygonCache& cache, const ConvexPolygon& convex_polygon, const size_t rotation, const Point2& origin, const double reach, const double direction_x, const double direction_y, double distance, std::vector<size_t>& found, std::vector<size_t>& previous_found);
+
+	/*!
+	 * Compute the centre of the axis-aligned bounding box around a convex
+	 * polygon, as well as the distance from that centre to the corners.
+	 * \param convex_polygon The convex polygon to compute the bounding box of.
+	 * \param radius The distance from the centre to the corners of the
+	 * bounding box will be stored here.
+	 * \return The centre of the bounding box.
+	 */
+	static Point2 bounding_centre(const ConvexPolygon& convex_polygon, coordinate_t& radius);
 };
 
 }
@@ -0,0 +1,211 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_CANDIDATE_ARENA
+#define CONVACK_CANDIDATE_ARENA
+
+#include <memory> //For unique_ptr, to own the blocks of memory.
+#include <mutex> //To allow creating candidates from multiple threads.
+#include <new> //For placement new, to construct candidates in the blocks of memory.
+#include <type_traits> //For aligned_storage, to reserve memory for candidates.
+#include <utility> //To forward constructor arguments.
+#include <vector> //To store the blocks of memory and the free slots.
+
+#include "packing_candidate.hpp" //The candidates that are stored in this arena.
+
+namespace convack {
+
+/*!
+ * Storage for all of the packing candidates created during a beam search.
+ *
+ * The beam search creates and discards a great number of candidates while it
+ * expands the beam. Allocating each of them separately on the heap would make
+ * the allocator the bottleneck of the search. Instead, this arena allocates
+ * memory for candidates in big blocks and hands out slots in those blocks. When
+ * a candidate is no longer necessary, its slot gets reused for the next
+ * candidate. The blocks themselves are only freed when the arena is destroyed,
+ * so that resetting the arena between searches doesn't allocate any memory
+ * either.
+ *
+ * Candidates refer to their parent candidates. Therefore a candidate can only
+ * be destroyed once none of the candidates derived from it are necessary any
+ * more. The arena keeps track of how many live candidates are derived from
+ * each candidate, and only destroys a released candidate once that number
+ * drops to zero.
+ *
+ * Pointers to candidates in this arena stay valid until they are destroyed,
+ * since the blocks are never moved.
+ *
+ * Candidates may be created and released from multiple threads at the same
+ * time. Resetting the arena must only happen while no other thread is using
+ * it.
+ */
+class CandidateArena {
+public:
+	/*!
+	 * Creates a new, empty arena.
+	 * \param block_size How many candidates to allocate memory for at once.
+	 */
+	CandidateArena(const size_t block_size = 1024);
+
+	/*!
+	 * Destroys the arena and all candidates still stored in it.
+	 */
+	~CandidateArena();
+
+	/*!
+	 * Constructs a new candidate in this arena.
+	 *
+	 * The arguments are forwarded to the constructor of the candidate.
+	 * \param arguments The arguments of the packing candidate's constructor.
+	 * \return A pointer to the new candidate, which stays valid until the
+	 * candidate is released and destroyed.
+	 */
+	template<typename... Args>
+	PackingCandidate* create(Args&&... arguments) {
+		Slot* slot;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			slot = allocate_slot();
+		}
+		//Construct the candidate outside of the lock, since computing its score is the expensive part.
+		PackingCandidate* candidate = new(&slot->storage) PackingCandidate(std::forward<Args>(arguments)...);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		slot->alive = true;
+		slot->released = false;
+		slot->num_children = 0;
+		if(candidate->get_parent()) {
+			slot_of(candidate->get_parent())->num_children++;
+		}
+		++num_alive;
+		return candidate;
+	}
+
+	/*!
+	 * Indicate that the search doesn't need a candidate any more.
+	 *
+	 * The candidate is destroyed as soon as no other live candidates are
+	 * derived from it. If that causes its parent to become unnecessary as well,
+	 * the parent is destroyed too, and so on.
+	 * \param candidate The candidate that the search no longer needs.
+	 */
+	void release(PackingCandidate* candidate);
+
+	/*!
+	 * Destroy all candidates in this arena, without freeing its memory.
+	 *
+	 * All pointers to candidates in this arena become invalid. The memory will
+	 * be reused for new candidates.
+	 */
+	void reset();
+
+	/*!
+	 * Get the number of candidates that are currently stored in this arena.
+	 *
+	 * This includes candidates that were released, but are still necessary
+	 * because other candidates are derived from them.
+	 * \return The number of live candidates.
+	 */
+	size_t size() const;
+
+private:
+	/*!
+	 * A place in one of the memory blocks where a candidate can be stored.
+	 */
+	struct Slot {
+		/*!
+		 * Memory for the candidate itself.
+		 *
+		 * This must be the first member of the slot, so that a pointer to the
+		 * candidate is also a pointer to its slot.
+		 */
+		typename std::aligned_storage<sizeof(PackingCandidate), alignof(PackingCandidate)>::type storage;
+
+		/*!
+		 * How many live candidates have this candidate as their parent.
+		 */
+		size_t num_children;
+
+		/*!
+		 * Whether a candidate is currently constructed in this slot.
+		 */
+		bool alive;
+
+		/*!
+		 * Whether the search indicated that it doesn't need this candidate any
+		 * more.
+		 */
+		bool released;
+	};
+
+	/*!
+	 * How many slots are allocated at once in each block.
+	 */
+	size_t block_size;
+
+	/*!
+	 * The blocks of memory that candidates are stored in.
+	 */
+	std::vector<std::unique_ptr<Slot[]>> blocks;
+
+	/*!
+	 * How many slots of the last block in use have ever been handed out since
+	 * the last reset.
+	 *
+	 * Slots beyond this have never been used, so they don't need to be
+	 * destroyed when resetting.
+	 */
+	size_t used_in_block;
+
+	/*!
+	 * The index of the block that new slots are currently taken from.
+	 */
+	size_t current_block;
+
+	/*!
+	 * Slots that were used before, but whose candidates have been destroyed.
+	 *
+	 * These are reused first before taking new slots from the blocks.
+	 */
+	std::vector<Slot*> free_slots;
+
+	/*!
+	 * The number of candidates currently constructed in this arena.
+	 */
+	size_t num_alive;
+
+	/*!
+	 * Protects the bookkeeping of the arena when candidates are created or
+	 * released from multiple threads.
+	 */
+	std::mutex mutex;
+
+	/*!
+	 * Find a slot to construct a new candidate in.
+	 *
+	 * This reuses the slots of destroyed candidates if there are any, and
+	 * allocates a new block if all blocks are full.
+	 * \return A slot without a candidate in it.
+	 */
+	Slot* allocate_slot();
+
+	/*!
+	 * Destroy the candidate in a slot and mark the slot as free.
+	 * \param slot The slot to destroy the candidate of.
+	 */
+	void destroy(Slot* slot);
+
+	/*!
+	 * Find the slot that a candidate is stored in.
+	 * \param candidate A candidate that is stored in this arena.
+	 * \return The slot of that candidate.
+	 */
+	static Slot* slot_of(PackingCandidate* candidate);
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -24,6 +24,12 @@ namespace convack {
  * The candidate has a fixed set of convex polygons that are packed so far. It
  * also has a score, determined by some measure of what is considered to be a
  * good packing. The score is computed upon construction.
+ *
+ * To compute the score, each candidate keeps track of the convex hull around
+ * all of the convex polygons packed so far, as well as the total area covered
+ * by them. A child candidate only needs to merge its own new convex polygon into
+ * the convex hull of its parent, rather than computing the convex hull around
+ * its whole history of packed convex polygons.
  */
 class PackingCandidate {
 public:
@@ -36,14 +42,139 @@ public:
 	 * \param packed_objects All of the objects that need to get packed. This
 	 * includes objects that have already been packed before it reaches this
 	 * candidate.
+	 * \param pack_here_index The index of the convex polygon in the
+	 * \ref packed_objects vector that is packed in this candidate.
 	 * \param pack_here The polygon that is new in the packing for this
 	 * candidate. Should be one of the convex polygons from the
-	 * \ref packed_objects vector.
+	 * \ref packed_objects vector, possibly moved to the place where it is
+	 * packed.
 	 * \param parent The candidate that this candidate is derived from, if any.
 	 * You can see this as the parent node in the search tree. It contains a
 	 * packing that does not contain the pack_here polygon yet.
 	 */
-	PackingCandidate(const std::vector<ConvexPolygon>* packed_objects, const ConvexPolygon& pack_here, PackingCandidate* parent);
+	PackingCandidate(const std::vector<ConvexPolygon>* packed_objects, const size_t pack_here_index, const ConvexPolygon& pack_here, PackingCandidate* parent);
+
+	/*!
+	 * Construct a new candidate, where the convex hull around the packing has
+	 * already been computed.
+	 *
+	 * This allows the search to compute the score of a candidate before
+	 * constructing it, and only construct it if the score is good enough. The
+	 * candidate takes the areas and score that the search already computed,
+	 * rather than computing them again. The convex polygons are taken by
+	 * value, so that the search can move them in rather than copying them.
+	 * \param packed_objects All of the objects that need to get packed.
+	 * \param pack_here_index The index of the convex polygon in the
+	 * \ref packed_objects vector that is packed in this candidate.
+	 * \param pack_here The polygon that is new in the packing for this
+	 * candidate.
+	 * \param parent The candidate that this candidate is derived from, if any.
+	 * \param convex_hull The convex hull around the parent's packing and the
+	 * new polygon.
+	 * \param pack_here_rotation The index of the rotation that the new polygon
+	 * is packed in.
+	 * \param covered_area The total area of the convex polygons in the
+	 * packing, including the new polygon.
+	 * \param used_area The area of the convex hull.
+	 * \param score The score of the packing, as computed by
+	 * \ref compute_score from the covered and used area.
+	 */
+	PackingCandidate(const std::vector<ConvexPolygon>* packed_objects, const size_t pack_here_index, ConvexPolygon pack_here, PackingCandidate* parent, ConvexPolygon convex_hull, const size_t pack_here_rotation, const area_t covered_area, const area_t used_area, const double score);
+
+	/*!
+	 * Construct a candidate for the convex polygons that were packed before
+	 * the search started.
+	 *
+	 * When packing continues from an earlier layout, this candidate is the
+	 * parent of all roots of the search. It has no convex polygon of its own,
+	 * so its depth is 0, but it provides the convex hull and covered area of
+	 * the layout for its children to build on.
+	 * \param packed_objects All of the objects that need to get packed.
+	 * \param convex_hull The convex hull around the earlier layout.
+	 * \param covered_area The total area of the convex polygons in the earlier
+	 * layout.
+	 */
+	PackingCandidate(const std::vector<ConvexPolygon>* packed_objects, ConvexPolygon convex_hull, const area_t covered_area);
+
+	/*!
+	 * Compute the convex hull around the packing of a candidate, if a new
+	 * convex polygon were added to it.
+	 * \param parent The candidate to add a convex polygon to, or `nullptr` if
+	 * the new convex polygon is the first one.
+	 * \param pack_here The convex polygon to add.
+	 * \return The convex hull around the packing with the new polygon.
+	 */
+	static ConvexPolygon merge_hull(const PackingCandidate* parent, const ConvexPolygon& pack_here);
+
+	/*!
+	 * Compute the convex hull around the packing of a candidate, if a new
+	 * convex polygon were added to it, in an existing convex polygon.
+	 *
+	 * This reuses the memory of that convex polygon, so that scoring many
+	 * children doesn't need to allocate memory for each of them.
+	 * \param parent The candidate to add a convex polygon to, or `nullptr` if
+	 * the new convex polygon is the first one.
+	 * \param pack_here The convex polygon to add.
+	 * \param convex_hull The convex hull around the packing with the new
+	 * polygon will be stored here.
+	 */
+	static void merge_hull(const PackingCandidate* parent, const ConvexPolygon& pack_here, ConvexPolygon& convex_hull);
+
+	/*!
+	 * Compute the score of a packing.
+	 *
+	 * The score is the ratio of the area that is "lost" when packing objects
+	 * this way. The lost area is the part that is in the convex hull around
+	 * all objects, but not covered by an object itself.
+	 * \param covered_area The total area of the packed objects.
+	 * \param used_area The area of the convex hull around the packed objects.
+	 * \return The score of that packing. Lower is better.
+	 */
+	static double compute_score(const area_t covered_area, const area_t used_area);
+
+	/*!
+	 * Compute a score that a child candidate can't beat, without merging the
+	 * new convex polygon into the whole convex hull of the parent.
+	 *
+	 * The score is bounded with the core of the convex hull of the parent,
+	 * which has only a few vertices, so this is much cheaper than computing
+	 * the actual score. The core is inside the convex hull of the parent, so
+	 * the convex hull around the core and the new convex polygon is inside
+	 * the actual new convex hull. Its area is therefore a lower bound for the
+	 * used area, and so gives a lower bound for the score. A child of which
+	 * even this bound doesn't make it into the beam can be discarded right
+	 * away.
+	 *
+	 * The bound is made slightly lower to allow for rounding errors in the
+	 * exact score, so that it never discards a child that would have made it.
+	 * \param parent The candidate to add a convex polygon to, or `nullptr` if
+	 * the new convex polygon is the first one.
+	 * \param hull_core The core of the convex hull of the parent, as computed
+	 * by \ref hull_core.
+	 * \param pack_here The convex polygon to add.
+	 * \param pack_here_area The area of the convex polygon to add.
+	 * \return A score that is lower than or equal to the score of the child.
+	 */
+	static double score_lower_bound(const PackingCandidate* parent, const ConvexPolygon& hull_core, const ConvexPolygon& pack_here, const area_t pack_here_area);
+
+	/*!
+	 * Compute a score that a child candidate can't beat, constructing the
+	 * convex hull around the core and the new convex polygon in an existing
+	 * convex polygon.
+	 *
+	 * This gives the same bound as
+	 * \ref score_lower_bound(const PackingCandidate*, const ConvexPolygon&, const ConvexPolygon&, const area_t),
+	 * but reuses the memory of that convex polygon for every child.
+	 * \param parent The candidate to add a convex polygon to, or `nullptr` if
+	 * the new convex polygon is the first one.
+	 * \param hull_core The core of the convex hull of the parent.
+	 * \param pack_here The convex polygon to add.
+	 * \param pack_here_area The area of the convex polygon to add.
+	 * \param core_hull Memory to construct the convex hull around the core
+	 * and the new convex polygon in.
+	 * \return A score that is lower than or equal to the score of the child.
+	 */
+	static double score_lower_bound(const PackingCandidate* parent, const ConvexPolygon& hull_core, const ConvexPolygon& pack_here, const area_t pack_here_area, ConvexPolygon& core_hull);
 
 	/*!
 	 * Get the score of this candidate.
@@ -53,7 +184,114 @@ public:
 	 */
 	double get_score() const;
 
+	/*!
+	 * Get the convex hull around all convex polygons packed so far.
+	 *
+	 * This includes the convex polygon packed in this candidate as well as
+	 * those packed in all of its parent candidates.
+	 * \return The convex hull around the packing so far.
+	 */
+	const ConvexPolygon& get_convex_hull() const;
+
+	/*!
+	 * Get the total area covered by all convex polygons packed so far.
+	 *
+	 * This is the sum of the areas of the packed convex polygons, so it excludes
+	 * any gaps in between them.
+	 * \return The area covered by the packing so far.
+	 */
+	area_t get_covered_area() const;
+
+	/*!
+	 * Compute a convex polygon with few vertices inside the convex hull around
+	 * the packing so far.
+	 *
+	 * The core consists of the vertices of the convex hull that are furthest
+	 * out in each of \ref core_directions directions. This is cheap to merge
+	 * with, and still covers most of the convex hull, so it gives a tight
+	 * bound on the scores of the children of this candidate.
+	 * \return The core of the convex hull.
+	 */
+	ConvexPolygon hull_core() const;
+
+	/*!
+	 * Compute the core of the convex hull around the packing so far, in an
+	 * existing convex polygon.
+	 *
+	 * This gives the same core as \ref hull_core(), but reuses the memory of
+	 * the given convex polygon and list.
+	 * \param core The core of the convex hull will be stored here.
+	 * \param extremes Memory to collect the extreme vertices in.
+	 */
+	void hull_core(ConvexPolygon& core, std::vector<Point2>& extremes) const;
+
+	/*!
+	 * Get the area of the convex hull around all convex polygons packed so
+	 * far.
+	 *
+	 * This is cached, so that the children of this candidate can bound their
+	 * score without computing it again.
+	 * \return The area of the convex hull around the packing so far.
+	 */
+	area_t get_used_area() const;
+
+	/*!
+	 * Get the convex polygon that is packed in this candidate.
+	 *
+	 * This is the convex polygon as it is placed in the packing, so with the
+	 * transformation already applied that moves it to its packed position.
+	 * \return The convex polygon that is new in this candidate.
+	 */
+	const ConvexPolygon& get_pack_here() const;
+
+	/*!
+	 * Get the index of the convex polygon packed in this candidate, in the list
+	 * of all objects that need to get packed.
+	 * \return The index of the convex polygon that is new in this candidate.
+	 */
+	size_t get_pack_here_index() const;
+
+	/*!
+	 * Get the index of the rotation that the convex polygon packed in this
+	 * candidate is packed in, in the list of allowed rotations of the scene.
+	 * \return The rotation index of the convex polygon that is new in this
+	 * candidate.
+	 */
+	size_t get_pack_here_rotation() const;
+
+	/*!
+	 * Get the candidate that this candidate is derived from.
+	 * \return The parent candidate, or `nullptr` if this is a root of the
+	 * search tree.
+	 */
+	PackingCandidate* get_parent() const;
+
+	/*!
+	 * Get how many convex polygons are packed in this candidate, including
+	 * those packed in its parent candidates.
+	 * \return The number of packed convex polygons.
+	 */
+	size_t get_depth() const;
+
 private:
+	/*!
+	 * How much lower than the actual area of a convex hull its lower bound is
+	 * made, relative to that area.
+	 *
+	 * The exact area is computed in a different way, so it could otherwise
+	 * round to a slightly lower value than the bound.
+	 */
+	static constexpr double bound_tolerance = 0.000001;
+
+	/*!
+	 * In how many directions to find the extreme vertices of the convex hull
+	 * that form its core.
+	 *
+	 * More directions give a tighter bound on the score of the children, but
+	 * make the bound more expensive to compute.
+	 */
+	static constexpr size_t core_directions = 8;
+
 	/*!
 	 * A list of all convex polygons that need to be packed.
 	 *
@@ -70,6 +308,18 @@ private:
 	 */
 	ConvexPolygon pack_here;
 
+	/*!
+	 * The index of the \ref pack_here convex polygon in the
+	 * \ref packed_objects list.
+	 */
+	size_t pack_here_index;
+
+	/*!
+	 * The index of the rotation that the \ref pack_here convex polygon is
+	 * packed in.
+	 */
+	size_t pack_here_rotation;
+
 	/*!
 	 * A reference to the parent candidate upon which this candidate extends the
 	 * search.
@@ -78,6 +328,33 @@ private:
 	 */
 	PackingCandidate* parent;
 
+	/*!
+	 * How many convex polygons are packed so far, including the one packed in
+	 * this candidate.
+	 */
+	size_t depth;
+
+	/*!
+	 * The convex hull around all of the convex polygons packed so far,
+	 * including the one packed in this candidate.
+	 *
+	 * This is cached so that child candidates can compute their convex hull
+	 * by merging only their new convex polygon into this one.
+	 */
+	ConvexPolygon convex_hull;
+
+	/*!
+	 * The sum of the areas of all convex polygons packed so far, including the
+	 * one packed in this candidate.
+	 */
+	area_t covered_area;
+
+	/*!
+	 * The area of the \ref convex_hull around all convex polygons packed so
+	 * far.
+	 */
+	area_t used_area;
+
 	/*!
 	 * How well this candidate is rated. A lower score is considered a better
 	 * choice.
@@ -86,11 +363,6 @@ private:
 	 * packing.
 	 */
 	double score;
-
-	/*!
-	 * Compute the score for this candidate.
-	 */
-	double compute_score() const;
 };
 
 }
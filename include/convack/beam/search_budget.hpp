@@ -0,0 +1,101 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_SEARCH_BUDGET
+#define CONVACK_SEARCH_BUDGET
+
+#include <atomic> //To spend the budget from multiple threads.
+#include <chrono> //To track the deadline of the search.
+#include <cstddef> //For size_t.
+
+#include "cancellation.hpp" //To stop when the packing is cancelled.
+
+namespace convack {
+
+/*!
+ * Limits on how much work the beam search may do.
+ *
+ * The search can be limited by time, and by the number of candidates it
+ * evaluates. Once either limit is reached, the budget is exhausted and the
+ * search stops expanding its beam. The threads expanding the beam spend the
+ * budget together, so it may be spent from multiple threads at the same time.
+ *
+ * A cancelled search also exhausts its budget, so that the threads stop at the
+ * same points as when the budget runs out.
+ */
+class SearchBudget {
+public:
+	/*!
+	 * Creates a new budget, starting now.
+	 * \param time_budget How many seconds the search may take. If 0 or less,
+	 * there is no time limit.
+	 * \param evaluation_budget How many candidates the search may evaluate. If
+	 * 0, there is no limit on the number of evaluations.
+	 * \param cancellation A signal that the search must stop altogether.
+	 */
+	SearchBudget(const double time_budget, const size_t evaluation_budget, const Cancellation& cancellation = Cancellation());
+
+	/*!
+	 * Record that a number of candidates were evaluated.
+	 * \param evaluations How many candidates were evaluated.
+	 */
+	void spend(const size_t evaluations);
+
+	/*!
+	 * Test whether the search may not do any more work.
+	 *
+	 * Once the budget is exhausted, it stays exhausted.
+	 * \return `true` if the time or the evaluations ran out or the search was
+	 * cancelled, or `false` if the search may continue.
+	 */
+	bool exhausted();
+
+	/*!
+	 * Test whether the search was cancelled.
+	 *
+	 * Whereas a search that ran out of budget still completes its best
+	 * candidate, a cancelled search doesn't need a result any more.
+	 * \return `true` if the search was cancelled, or `false` if it wasn't.
+	 */
+	bool cancelled() const;
+
+private:
+	/*!
+	 * Whether there is a time limit.
+	 */
+	bool has_deadline;
+
+	/*!
+	 * When the time runs out, if there is a time limit.
+	 */
+	std::chrono::steady_clock::time_point deadline;
+
+	/*!
+	 * How many candidates may be evaluated, or 0 if there is no limit.
+	 */
+	size_t evaluation_budget;
+
+	/*!
+	 * The signal that the search must stop altogether.
+	 */
+	Cancellation cancellation;
+
+	/*!
+	 * How many candidates were evaluated so far.
+	 */
+	std::atomic<size_t> evaluations;
+
+	/*!
+	 * Whether the budget ran out.
+	 *
+	 * This is remembered so that all threads stop at the same point, and so
+	 * that the clock doesn't need to be read any more once it happened.
+	 */
+	std::atomic<bool> is_exhausted;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,240 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_BINARY_FORMAT
+#define CONVACK_BINARY_FORMAT
+
+#include <array> //To store the transformation matrices.
+#include <cstddef> //For size_t.
+#include <cstdint> //For fixed-size fields in the file.
+#include <vector> //To write to a buffer and to read all convex polygons.
+
+#include "convex_polygon.hpp" //To write and read convex polygons.
+#include "transformation.hpp" //To restore the transformations of the convex polygons.
+
+namespace convack {
+
+class Point2;
+
+/*!
+ * A convex polygon as it is stored in a buffer in the binary format.
+ *
+ * This doesn't own any memory. The vertices point directly into the buffer, so
+ * the view is only valid as long as the buffer is.
+ */
+struct ConvexPolygonView {
+	/*!
+	 * The current vertices of the convex polygon, with its transformation
+	 * already applied to them.
+	 */
+	const Point2* vertices;
+
+	/*!
+	 * How many vertices the convex polygon has.
+	 */
+	size_t num_vertices;
+
+	/*!
+	 * The identifier that the convex polygon had when it was written.
+	 */
+	uint64_t uid;
+
+	/*!
+	 * The transformation that was applied to the convex polygon when it was
+	 * written.
+	 */
+	Transformation transformation;
+
+	/*!
+	 * Create a convex polygon from this view.
+	 *
+	 * This copies the vertices out of the buffer. The convex polygon gets a new
+	 * identifier, since identifiers are only unique within the process that
+	 * created them, and the no-fit polygon cache relies on that.
+	 * \return A convex polygon with the vertices and transformation of this
+	 * view.
+	 */
+	ConvexPolygon to_convex_polygon() const;
+};
+
+/*!
+ * A versioned binary format to store sets of convex polygons, such as the parts
+ * to pack or the result of a packing.
+ *
+ * The format is laid out so that it can be used directly from memory, for
+ * instance from a memory-mapped file. Loading it only checks that the data is
+ * valid, without parsing or copying anything. The convex polygons can then be
+ * read as views that point into the data.
+ *
+ * The data starts with a header of 32 bytes:
+ * - 4 bytes with the characters `CVPK`.
+ * - The version of the format, as a 32-bit integer.
+ * - A byte order mark, as a 32-bit integer.
+ * - The type of the coordinates, as a 32-bit integer.
+ * - The number of convex polygons, as a 64-bit integer.
+ * - The total number of vertices, as a 64-bit integer.
+ *
+ * This is followed by a record for each convex polygon, with its identifier,
+ * the index of its first vertex and its number of vertices as 64-bit integers,
+ * and the 6 cells of its transformation matrix as doubles. After the records
+ * come the vertices of all convex polygons, as pairs of coordinates.
+ *
+ * Everything is stored in the byte order and with the coordinate type of the
+ * computer that wrote it. Data written with a different byte order or a
+ * different coordinate type is rejected, rather than converted.
+ *
+ * A packing result is stored the same way. The transformations of the convex
+ * polygons are where they were packed.
+ */
+class BinaryFormat {
+public:
+	/*!
+	 * The version of the format that is written, and the only version that can
+	 * be read.
+	 */
+	static constexpr uint32_t version = 1;
+
+	/*!
+	 * Write convex polygons to a buffer in the binary format.
+	 * \param convex_polygons The convex polygons to write.
+	 * \param buffer The buffer to write to. Anything that was in the buffer
+	 * before is replaced.
+	 */
+	static void write(const std::vector<ConvexPolygon>& convex_polygons, std::vector<char>& buffer);
+
+	/*!
+	 * Creates a view without any convex polygons.
+	 */
+	BinaryFormat();
+
+	/*!
+	 * Start viewing data in the binary format.
+	 *
+	 * The data is checked to be valid, but not copied. It must stay in memory
+	 * as long as this view is used. It must be aligned to 8 bytes, as memory
+	 * maps and allocations are.
+	 * \param data The start of the data.
+	 * \param size The size of the data, in bytes.
+	 * \return `true` if the data is valid, or `false` if it is not in the
+	 * binary format, has a different version, byte order or coordinate type,
+	 * is misaligned, or is truncated. If it's not valid, the view is left empty.
+	 */
+	bool load(const void* data, const size_t size);
+
+	/*!
+	 * Get the number of convex polygons in the data.
+	 * \return The number of convex polygons.
+	 */
+	size_t size() const;
+
+	/*!
+	 * Get a view of one of the convex polygons in the data.
+	 * \param index The index of the convex polygon to view.
+	 * \return A view on that convex polygon, pointing into the data.
+	 */
+	ConvexPolygonView operator [](const size_t index) const;
+
+	/*!
+	 * Create convex polygons from all of the data.
+	 *
+	 * This copies the vertices out of the data. See
+	 * \ref ConvexPolygonView::to_convex_polygon.
+	 * \return All convex polygons in the data.
+	 */
+	std::vector<ConvexPolygon> to_convex_polygons() const;
+
+private:
+	/*!
+	 * The start of the data, in front of everything else.
+	 */
+	struct Header {
+		/*!
+		 * The characters `CVPK`, to recognise the format.
+		 */
+		char magic[4];
+
+		/*!
+		 * The version of the format.
+		 */
+		uint32_t version;
+
+		/*!
+		 * The number \ref byte_order_mark, to recognise the byte order.
+		 */
+		uint32_t byte_order;
+
+		/*!
+		 * The type of the coordinates. See \ref coordinate_type.
+		 */
+		uint32_t coordinate_type;
+
+		/*!
+		 * The number of convex polygons.
+		 */
+		uint64_t num_convex_polygons;
+
+		/*!
+		 * The total number of vertices of all convex polygons together.
+		 */
+		uint64_t num_vertices;
+	};
+
+	/*!
+	 * The data stored for each convex polygon.
+	 */
+	struct Record {
+		/*!
+		 * The identifier of the convex polygon.
+		 */
+		uint64_t uid;
+
+		/*!
+		 * The index of the first vertex of this convex polygon among the
+		 * vertices of all convex polygons.
+		 */
+		uint64_t first_vertex;
+
+		/*!
+		 * The number of vertices of this convex polygon.
+		 */
+		uint64_t num_vertices;
+
+		/*!
+		 * The cells of the transformation matrix of this convex polygon.
+		 */
+		std::array<double, 6> transformation;
+	};
+
+	/*!
+	 * A number that reads differently in each byte order.
+	 */
+	static constexpr uint32_t byte_order_mark = 0x01020304;
+
+	/*!
+	 * Get the number that denotes the coordinate type of this build.
+	 * \return 0 for 32-bit floating point coordinates, or 1 for 32-bit integer
+	 * coordinates.
+	 */
+	static uint32_t coordinate_type();
+
+	/*!
+	 * The records of the convex polygons in the data.
+	 */
+	const Record* records;
+
+	/*!
+	 * The vertices of all convex polygons in the data.
+	 */
+	const Point2* vertices;
+
+	/*!
+	 * The number of convex polygons in the data.
+	 */
+	size_t num_convex_polygons;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_BOUNDING_BOX
+#define CONVACK_BOUNDING_BOX
+
+#include <ostream> //To be able to serialise a bounding box to a stream.
+#include <vector> //To construct a bounding box around a list of points.
+
+#include "point2.hpp" //To store the corners of the bounding box.
+
+namespace convack {
+
+/*!
+ * An axis-aligned rectangle enclosing some shape.
+ *
+ * Testing against a bounding box is much cheaper than testing against the shape
+ * itself. If a test fails for the bounding box, it also fails for the shape
+ * inside of it, so this can be used to skip the more expensive tests.
+ *
+ * A bounding box around nothing is empty. It doesn't overlap with anything and
+ * doesn't contain any point.
+ */
+struct BoundingBox {
+	/*!
+	 * The corner of the bounding box with the lowest X and Y coordinates.
+	 */
+	Point2 minimum;
+
+	/*!
+	 * The corner of the bounding box with the highest X and Y coordinates.
+	 */
+	Point2 maximum;
+
+	/*!
+	 * Constructs an empty bounding box.
+	 */
+	BoundingBox();
+
+	/*!
+	 * Constructs the smallest bounding box around a number of points.
+	 * \param points The points to construct a bounding box around.
+	 */
+	BoundingBox(const std::vector<Point2>& points);
+
+	/*!
+	 * Compares if two bounding boxes span the same area.
+	 * \param other The bounding box to compare to.
+	 * \return Whether the two bounding boxes are the same (`true`) or
+	 * different (`false`).
+	 */
+	bool operator ==(const BoundingBox& other) const;
+
+	/*!
+	 * Compares if two bounding boxes span different areas.
+	 * \param other The bounding box to compare to.
+	 * \return Whether the two bounding boxes are different (`true`) or the
+	 * same (`false`).
+	 */
+	bool operator !=(const BoundingBox& other) const;
+
+	/*!
+	 * Overloads streaming this bounding box.
+	 *
+	 * This is useful for debugging, since it allows printing the bounding box
+	 * to a stream directly, giving you a reasonably readable output.
+	 * \param output_stream The stream to add a representation of this bounding
+	 * box to.
+	 * \param bounding_box The bounding box to stream.
+	 * \return The given stream.
+	 */
+	friend std::ostream& operator <<(std::ostream& output_stream, const BoundingBox& bounding_box);
+
+	/*!
+	 * Test whether the bounding box encloses nothing.
+	 * \return `true` if the bounding box is empty, or `false` if it encloses at
+	 * least one point.
+	 */
+	bool empty() const;
+
+	/*!
+	 * Grow the bounding box such that it also encloses a point.
+	 * \param point The point to enclose.
+	 */
+	void include(const Point2& point);
+
+	/*!
+	 * Test whether a point is inside this bounding box.
+	 *
+	 * Like with convex polygons, points that are exactly on the edge are not
+	 * considered to be inside.
+	 * \param point The point to test.
+	 * \return `true` if the point is inside the bounding box, or `false` if it
+	 * is outside or on the boundary.
+	 */
+	bool contains(const Point2& point) const;
+
+	/*!
+	 * Test whether another bounding box lies completely inside this bounding
+	 * box.
+	 *
+	 * Unlike for points, the other bounding box may touch the edge of this one.
+	 * Nothing encloses an empty bounding box.
+	 * \param other The bounding box to test.
+	 * \return `true` if the other bounding box is inside this one, or `false`
+	 * if it sticks out of it.
+	 */
+	bool encloses(const BoundingBox& other) const;
+
+	/*!
+	 * Test whether this bounding box overlaps with another bounding box.
+	 *
+	 * Like with convex polygons, bounding boxes that only touch each other are
+	 * not considered to be overlapping. They must have an area of overlap
+	 * greater than zero.
+	 * \param other The bounding box to test against.
+	 * \return `true` if the bounding boxes overlap, or `false` if they don't.
+	 */
+	bool overlaps(const BoundingBox& other) const;
+
+	/*!
+	 * Get the centre of the bounding box.
+	 * \return The point halfway between the minimum and maximum corners.
+	 */
+	Point2 centre() const;
+};
+
+}
+
+#endif
\ No newline at end of file
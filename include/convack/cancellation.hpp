@@ -0,0 +1,62 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_CANCELLATION
+#define CONVACK_CANCELLATION
+
+#include <memory> //For shared_ptr.
+
+namespace convack {
+
+/*!
+ * A signal to stop a packing that is running asynchronously.
+ *
+ * Copies of a cancellation share their state. Give a copy to the packing, and
+ * keep a copy to cancel it with, possibly from a different thread. The packing
+ * checks regularly whether it is cancelled, and then stops as soon as it can.
+ */
+class Cancellation {
+public:
+	/*!
+	 * Creates a new cancellation that hasn't been cancelled yet.
+	 */
+	Cancellation();
+
+	/*!
+	 * Request the packing to stop.
+	 *
+	 * This returns right away. The packing stops at the next point where it
+	 * checks for cancellation.
+	 */
+	void cancel();
+
+	/*!
+	 * Test whether \ref cancel was called on this cancellation or any of its
+	 * copies.
+	 * \return `true` if the packing is to stop, or `false` if it may continue.
+	 */
+	bool is_cancelled() const;
+
+private:
+	/*!
+	 * The implementation of the cancellation is separated into this class.
+	 *
+	 * This implements the PIMPL idiom.
+	 */
+	class Impl;
+
+	/*!
+	 * A pointer to the implementation of this class.
+	 *
+	 * This implements the PIMPL idiom. Unlike other classes, the
+	 * implementation is shared between copies, since they need to see each
+	 * other's cancellation.
+	 */
+	std::shared_ptr<Impl> pimpl;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 namespace convack {
 
+struct BoundingBox;
 class Point2;
 class Transformation;
 
@@ -50,6 +51,49 @@ public:
 	 */
 	static ConvexPolygon convex_hull(const std::vector<ConvexPolygon>& convex_polygons);
 
+	/*!
+	 * Constructs a new convex hull around two convex polygons.
+	 *
+	 * This gives the same convex polygon as constructing the convex hull
+	 * around a list of both, but it takes linear time in the number of
+	 * vertices of both, and doesn't need to copy them into a list first.
+	 * Adding one convex polygon to the convex hull of a packing is a common
+	 * use for this.
+	 * \param a One of the convex polygons to construct a convex hull around.
+	 * \param b The other convex polygon to construct a convex hull around.
+	 * \return A new convex polygon around both of the given convex polygons.
+	 */
+	static ConvexPolygon convex_hull(const ConvexPolygon& a, const ConvexPolygon& b);
+
+	/*!
+	 * Constructs the convex hull around a set of points in an existing convex
+	 * polygon.
+	 *
+	 * This gives the same convex polygon as \ref convex_hull(const std::vector<Point2>&),
+	 * but it reuses the memory of the result. Constructing many convex hulls
+	 * this way doesn't allocate memory once the result is large enough.
+	 * \param points The points to construct a convex hull around.
+	 * \param result The convex polygon to store the convex hull in. It is
+	 * replaced as if it were newly constructed, with a new identifier.
+	 */
+	static void convex_hull(const std::vector<Point2>& points, ConvexPolygon& result);
+
+	/*!
+	 * Constructs the convex hull around two convex polygons in an existing
+	 * convex polygon.
+	 *
+	 * This gives the same convex polygon as
+	 * \ref convex_hull(const ConvexPolygon&, const ConvexPolygon&), but it
+	 * reuses the memory of the result, like
+	 * \ref convex_hull(const std::vector<Point2>&, ConvexPolygon&).
+	 * \param a One of the convex polygons to construct a convex hull around.
+	 * \param b The other convex polygon to construct a convex hull around.
+	 * \param result The convex polygon to store the convex hull in. It is
+	 * replaced as if it were newly constructed, with a new identifier. It may
+	 * be one of the two convex polygons.
+	 */
+	static void convex_hull(const ConvexPolygon& a, const ConvexPolygon& b, ConvexPolygon& result);
+
 	/*!
 	 * Constructs a new convex polygon using the provided vertices.
 	 *
@@ -60,12 +104,44 @@ public:
 	 */
 	ConvexPolygon(const std::vector<Point2>& vertices);
 
+	/*!
+	 * Constructs a new convex polygon, taking over the provided vertices.
+	 *
+	 * This is the same as constructing it from a copy of the vertices, but
+	 * without copying them.
+	 * \param vertices The vertices of a convex polygon. This list is left
+	 * empty.
+	 */
+	ConvexPolygon(std::vector<Point2>&& vertices);
+
+	/*!
+	 * Constructs a new convex polygon that has already been transformed.
+	 *
+	 * This restores a convex polygon that was transformed earlier, for
+	 * instance when reading back the result of a packing. The vertices are
+	 * where the polygon is now, and are not transformed any more. The
+	 * transformation is only taken as the \ref current_transformation.
+	 * \param vertices The current vertices of a convex polygon.
+	 * \param transformation The transformation that has been applied to the
+	 * vertices.
+	 */
+	ConvexPolygon(const std::vector<Point2>& vertices, const Transformation& transformation);
+
 	/*!
 	 * Copies a convex polygon.
 	 * \param original The original convex polygon to copy.
 	 */
 	ConvexPolygon(const ConvexPolygon& original);
 
+	/*!
+	 * Moves a convex polygon, without copying its data.
+	 *
+	 * The original convex polygon can only be destroyed or assigned to
+	 * afterwards.
+	 * \param original The original convex polygon to move.
+	 */
+	ConvexPolygon(ConvexPolygon&& original) noexcept;
+
 	/*!
 	 * Deletes the convex polygon.
 	 */
@@ -73,12 +149,27 @@ public:
 
 	/*!
 	 * Assigns a convex polygon into this one, copying its data.
+	 *
+	 * The memory of this convex polygon is reused for the copy, so assigning
+	 * to the same convex polygon over and over doesn't allocate memory once
+	 * it's large enough.
 	 * \param original The convex polygon to copy into this one.
 	 * \return A reference to this convex polygon. This way, the assignment can
 	 * be used in a more complex expression.
 	 */
 	ConvexPolygon& operator =(const ConvexPolygon& original);
 
+	/*!
+	 * Moves a convex polygon into this one, without copying its data.
+	 *
+	 * The original convex polygon can only be destroyed or assigned to
+	 * afterwards.
+	 * \param original The convex polygon to move into this one.
+	 * \return A reference to this convex polygon. This way, the assignment can
+	 * be used in a more complex expression.
+	 */
+	ConvexPolygon& operator =(ConvexPolygon&& original) noexcept;
+
 	/*!
 	 * Compares two convex polygons for whether they cover the same area.
 	 *
@@ -109,6 +200,32 @@ public:
 	 */
 	bool operator !=(const ConvexPolygon& other) const;
 
+	/*!
+	 * Compares two convex polygons for whether they have the same shape,
+	 * regardless of where they are.
+	 *
+	 * This is like the equality check, except that the convex polygons may be
+	 * translated with respect to each other. It takes linear time.
+	 *
+	 * The vertices are compared relative to the lowest vertex, exactly. Copies
+	 * that were translated separately may get different rounding errors in
+	 * their coordinates, and then they don't have the same shape any more.
+	 * \param other The convex polygon to compare to.
+	 * \return `true` if the two convex polygons have the same shape, or
+	 * `false` if they are different.
+	 */
+	bool same_shape(const ConvexPolygon& other) const;
+
+	/*!
+	 * Compute a hash of the shape of this convex polygon.
+	 *
+	 * Convex polygons that have the same shape according to \ref same_shape
+	 * have the same hash, so this can be used to group convex polygons by
+	 * their shape.
+	 * \return A hash of the shape.
+	 */
+	size_t shape_hash() const;
+
 	/*!
 	 * Overloads streaming this convex polygon.
 	 *
@@ -134,6 +251,22 @@ public:
 	 */
 	bool contains(const Point2& point) const;
 
+	/*!
+	 * Tests whether another convex polygon lies completely inside this convex
+	 * polygon.
+	 *
+	 * Unlike for a single point, the other convex polygon may touch the
+	 * boundary of this one. That way, convex polygons can be packed right up
+	 * against the edge of a container. Both convex polygons are convex, so it
+	 * suffices to test the vertices of the other one. If its bounding box
+	 * sticks out of the bounding box of this convex polygon, no vertex needs
+	 * to be tested at all.
+	 * \param other The convex polygon that may be inside of this one.
+	 * \return `true` if the other convex polygon is inside this one, or
+	 * `false` if any part of it is outside.
+	 */
+	bool contains(const ConvexPolygon& other) const;
+
 	/*!
 	 * Test whether this convex polygon collides with another convex polygon.
 	 *
@@ -160,11 +293,51 @@ public:
 	 */
 	const Transformation& current_transformation() const;
 
+	/*!
+	 * Get the axis-aligned bounding box around this convex polygon.
+	 *
+	 * The bounding box is kept up to date when the convex polygon is
+	 * transformed, so getting it is cheap.
+	 * \return The smallest axis-aligned rectangle enclosing all vertices.
+	 */
+	const BoundingBox& get_bounding_box() const;
+
 	/*!
 	 * Get the vertices of the convex hull.
 	 */
 	const std::vector<Point2>& get_vertices() const;
 
+	/*!
+	 * Test whether transformations of this convex polygon are applied lazily.
+	 * \return `true` if transformations are lazy, or `false` if they are
+	 * applied to the vertices right away.
+	 */
+	bool is_lazy() const;
+
+	/*!
+	 * Choose whether transformations of this convex polygon are applied
+	 * lazily.
+	 *
+	 * By default, rotating or translating a convex polygon applies the
+	 * transformation to all vertices right away. If transformations are lazy,
+	 * the convex polygon only keeps track of the transformation instead, and
+	 * applies it when the vertices are needed. This is faster if a convex
+	 * polygon is transformed many times and most of the results are only
+	 * tested against bounding boxes, or not used at all. Copying a lazy convex
+	 * polygon is also cheaper, since the copies share their original vertices.
+	 *
+	 * Lazily transformed vertices are transformed all at once, so they may be
+	 * different by rounding errors from vertices that are transformed one step
+	 * at a time.
+	 *
+	 * A lazy convex polygon fills in its vertices when they are first
+	 * requested, even through const methods. It must therefore not be used
+	 * from multiple threads at once, unless its vertices were requested first.
+	 * \param lazy Whether to apply transformations lazily.
+	 * \return A reference to this convex polygon, to allow chaining.
+	 */
+	ConvexPolygon& set_lazy(const bool lazy);
+
 	/*!
 	 * Rotate this convex polygon.
 	 *
@@ -193,6 +366,9 @@ public:
 	 * The identifier is generated when creating a convex polygon. It is not
 	 * modified when transforming the convex polygon and retained when the
 	 * convex polygon is copied.
+	 *
+	 * Convex polygons may be created on multiple threads at once. Their
+	 * identifiers are still unique.
 	 */
 	uint64_t uid() const;
 
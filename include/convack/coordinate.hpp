@@ -6,12 +6,46 @@
 #ifndef CONVACK_COORDINATE
 #define CONVACK_COORDINATE
 
+#ifdef CONVACK_FIXED_POINT
+#include <cmath> //To round to the nearest integer coordinate.
+#include <cstdint> //For int32_t.
+#endif
+
 namespace convack {
 
+#ifdef CONVACK_FIXED_POINT
+/*!
+ * Type to use to denote coordinates in space.
+ *
+ * With the `CONVACK_FIXED_POINT` option, coordinates are integers. The unit is
+ * up to the application, e.g. micrometres. All predicates on integer
+ * coordinates, such as whether a point is left of a line, are then exact. So
+ * convex polygons that touch each other are found to touch on any computer.
+ */
+typedef int32_t coordinate_t;
+#else
 /*!
  * Type to use to denote coordinates in space.
  */
 typedef float coordinate_t;
+#endif
+
+/*!
+ * Convert the result of a calculation to a coordinate.
+ *
+ * Calculations such as rotations and placements along a direction are done in
+ * floating point. With integer coordinates, their result is rounded to the
+ * nearest integer, rather than truncated towards 0.
+ * \param value The result of the calculation.
+ * \return The coordinate closest to that result.
+ */
+inline coordinate_t to_coordinate(const double value) {
+#ifdef CONVACK_FIXED_POINT
+	return static_cast<coordinate_t>(std::lround(value));
+#else
+	return static_cast<coordinate_t>(value);
+#endif
+}
 
 }
 
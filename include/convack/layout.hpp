@@ -0,0 +1,148 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_LAYOUT
+#define CONVACK_LAYOUT
+
+#include <cstddef> //For size_t.
+#include <deque> //To store the placed convex polygons without moving them when more get added.
+#include <vector> //To store the rotations of the placed convex polygons.
+
+#include "area.hpp" //To store the area covered by the layout.
+#include "convex_polygon.hpp" //To store the placed convex polygons and their convex hull.
+#include "spatial_index.hpp" //To quickly find collisions with the placed convex polygons.
+
+namespace convack {
+
+/*!
+ * The convex polygons that were placed by earlier packings, which later
+ * packings continue from.
+ *
+ * When convex polygons arrive a few at a time, packing all of them again for
+ * every new arrival would get slower and slower. Instead, the placements are
+ * committed to a layout. The next packing only searches for where to put the
+ * new convex polygons, against a layout that doesn't move any more.
+ *
+ * The layout keeps everything that the search needs about the placed convex
+ * polygons up to date as they are added: an index to test for collisions
+ * with, the convex hull around all of them and the area they cover. Adding a
+ * convex polygon only merges it into those, so it doesn't matter how big the
+ * layout has grown.
+ *
+ * The index refers to the convex polygons in this layout, so a layout can't be
+ * copied.
+ */
+class Layout {
+public:
+	/*!
+	 * Creates an empty layout.
+	 */
+	Layout();
+
+	/*!
+	 * Layouts can't be copied, because the index refers to the convex polygons
+	 * of this layout.
+	 */
+	Layout(const Layout&) = delete;
+
+	/*!
+	 * Layouts can't be copied, because the index refers to the convex polygons
+	 * of this layout.
+	 */
+	Layout& operator =(const Layout&) = delete;
+
+	/*!
+	 * Commit the placement of a convex polygon to the layout.
+	 * \param convex_polygon The convex polygon, as it was placed.
+	 * \param rotation The index of the rotation that the convex polygon was
+	 * placed in, in the rotations setting of the scene. This is used to find
+	 * its no-fit polygons in the cache.
+	 */
+	void add(const ConvexPolygon& convex_polygon, const size_t rotation);
+
+	/*!
+	 * Remove all convex polygons from the layout, so that the next packing
+	 * starts from scratch.
+	 */
+	void clear();
+
+	/*!
+	 * Test whether nothing was placed in the layout.
+	 * \return `true` if the layout is empty, or `false` if it has any convex
+	 * polygons.
+	 */
+	bool empty() const;
+
+	/*!
+	 * Get the convex polygons placed in the layout.
+	 * \return The placed convex polygons, in the order in which they were
+	 * added.
+	 */
+	const std::deque<ConvexPolygon>& get_convex_polygons() const;
+
+	/*!
+	 * Get the rotation index of each of the convex polygons in the layout.
+	 * \return For each of the placed convex polygons, the index of the rotation
+	 * it was placed in.
+	 */
+	const std::vector<size_t>& get_rotations() const;
+
+	/*!
+	 * Get an index of the convex polygons in the layout, to quickly test new
+	 * placements for collisions with them.
+	 * \return An index of the placed convex polygons.
+	 */
+	const SpatialIndex& get_index() const;
+
+	/*!
+	 * Get the convex hull around all of the convex polygons in the layout.
+	 * \return The convex hull around the layout, or an empty convex polygon if
+	 * the layout is empty.
+	 */
+	const ConvexPolygon& get_convex_hull() const;
+
+	/*!
+	 * Get the total area covered by the convex polygons in the layout.
+	 * \return The sum of the areas of the placed convex polygons.
+	 */
+	area_t get_covered_area() const;
+
+private:
+	/*!
+	 * The placed convex polygons.
+	 *
+	 * A deque doesn't move its elements when it grows, so the pointers to them
+	 * in the \ref index stay valid.
+	 */
+	std::deque<ConvexPolygon> convex_polygons;
+
+	/*!
+	 * For each of the placed convex polygons, the index of the rotation it was
+	 * placed in.
+	 */
+	std::vector<size_t> rotations;
+
+	/*!
+	 * An index of the placed convex polygons.
+	 *
+	 * Its cells are as large as the first convex polygon that was placed,
+	 * assuming that it's representative for the convex polygons that follow.
+	 */
+	SpatialIndex index;
+
+	/*!
+	 * The convex hull around all of the placed convex polygons.
+	 */
+	ConvexPolygon convex_hull;
+
+	/*!
+	 * The sum of the areas of the placed convex polygons.
+	 */
+	area_t covered_area;
+};
+
+}
+
+#endif
\ No newline at end of file
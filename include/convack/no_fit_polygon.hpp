@@ -0,0 +1,127 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_NO_FIT_POLYGON
+#define CONVACK_NO_FIT_POLYGON
+
+#include <cstddef> //For size_t.
+#include <vector> //To list the touching translations.
+
+#include "convex_polygon.hpp" //To store the shape of the no-fit polygon.
+
+namespace convack {
+
+class Point2;
+
+/*!
+ * The no-fit polygon of two convex polygons describes all of the translations
+ * of one convex polygon, the orbiting one, at which it overlaps with another,
+ * the stationary one.
+ *
+ * If the orbiting convex polygon is translated by a vector inside of the no-fit
+ * polygon, the two overlap. If it's translated by a vector on the boundary of
+ * the no-fit polygon, the two touch. And if it's translated by a vector outside
+ * of the no-fit polygon, they are apart. This turns questions about where to
+ * place a convex polygon against another into questions about a single point
+ * and a single convex polygon, which are much cheaper to answer than testing
+ * each translation for collision.
+ *
+ * For convex polygons, the no-fit polygon is the Minkowski sum of the
+ * stationary convex polygon and the mirrored orbiting convex polygon. That is
+ * convex as well, and can be computed in linear time.
+ */
+class NoFitPolygon {
+public:
+	/*!
+	 * Compute the Minkowski sum of two convex polygons.
+	 *
+	 * The Minkowski sum consists of all points that are the sum of a point in
+	 * one convex polygon and a point in the other. It's computed by merging the
+	 * edges of both convex polygons in the order of their angles, starting
+	 * from the lowest vertex of each. Because both are convex and wind
+	 * counter-clockwise, their edges are already sorted by angle, so this
+	 * takes O(n + m) time.
+	 * \param a One of the convex polygons to sum.
+	 * \param b The other convex polygon to sum.
+	 * \return The Minkowski sum of the two convex polygons.
+	 */
+	static ConvexPolygon minkowski_sum(const ConvexPolygon& a, const ConvexPolygon& b);
+
+	/*!
+	 * Compute the no-fit polygon of two convex polygons, at their current
+	 * positions.
+	 * \param stationary The convex polygon that stays in place.
+	 * \param orbiting The convex polygon that gets translated.
+	 */
+	NoFitPolygon(const ConvexPolygon& stationary, const ConvexPolygon& orbiting);
+
+	/*!
+	 * Get the shape of the no-fit polygon, in the space of translations of the
+	 * orbiting convex polygon.
+	 * \return The no-fit polygon.
+	 */
+	const ConvexPolygon& get_polygon() const;
+
+	/*!
+	 * Get the translations of the orbiting convex polygon at which a vertex or
+	 * an edge of it touches a vertex of the stationary convex polygon.
+	 *
+	 * These are the vertices of the no-fit polygon. They are good candidates
+	 * for placing the orbiting convex polygon snugly against the stationary
+	 * one.
+	 * \return The touching translations, in counter-clockwise order around the
+	 * stationary convex polygon.
+	 */
+	const std::vector<Point2>& get_touching_translations() const;
+
+	/*!
+	 * Test whether the orbiting convex polygon would overlap with the
+	 * stationary convex polygon after a translation.
+	 *
+	 * Like with collisions between convex polygons, touching is not considered
+	 * to be overlapping.
+	 * \param translation The translation of the orbiting convex polygon.
+	 * \return `true` if they would overlap, or `false` if they wouldn't.
+	 */
+	bool overlaps(const Point2& translation) const;
+
+	/*!
+	 * Find where a line of translations of the orbiting convex polygon leaves
+	 * the no-fit polygon.
+	 *
+	 * This is where the orbiting convex polygon, coming in along that line
+	 * from far away, first touches the stationary convex polygon. The line is
+	 * given by `origin + direction * distance`.
+	 * \param origin A translation on the line.
+	 * \param direction_x The X component of the direction of the line.
+	 * \param direction_y The Y component of the direction of the line.
+	 * \param distance If the line goes through the no-fit polygon, the greatest
+	 * distance along the line that is still in the no-fit polygon will be
+	 * stored here.
+	 * \return `true` if the line goes through the no-fit polygon, or `false`
+	 * if it misses or only touches it.
+	 */
+	bool exit_distance(const Point2& origin, const double direction_x, const double direction_y, double& distance) const;
+
+private:
+	/*!
+	 * The shape of the no-fit polygon.
+	 */
+	ConvexPolygon polygon;
+
+	/*!
+	 * Find the lowest vertex of a convex polygon, which is where the Minkowski
+	 * sum starts merging edges.
+	 *
+	 * If multiple vertices are equally low, the left-most of those is chosen.
+	 * \param vertices The vertices of the convex polygon.
+	 * \return The index of the lowest vertex.
+	 */
+	static size_t lowest_vertex(const std::vector<Point2>& vertices);
+};
+
+}
+
+#endif
\ No newline at end of file
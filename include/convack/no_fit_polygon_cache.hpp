@@ -0,0 +1,298 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_NO_FIT_POLYGON_CACHE
+#define CONVACK_NO_FIT_POLYGON_CACHE
+
+#include <cstddef> //For size_t.
+#include <cstdint> //To store the identifiers of convex polygons.
+#include <list> //To track which no-fit polygons were used least recently.
+#include <memory> //To share cached no-fit polygons with the threads using them.
+#include <mutex> //To allow using the cache from multiple threads.
+#include <unordered_map> //To find cached no-fit polygons by their key.
+
+#include "area.hpp" //To compare the rotations of convex polygons.
+#include "point2.hpp" //To recognise the shapes of convex polygons.
+
+namespace convack {
+
+class ConvexPolygon;
+class NoFitPolygon;
+
+/*!
+ * Memory of the no-fit polygons computed so far, so that they can be reused.
+ *
+ * Packings often contain many copies of the same few shapes. The beam search
+ * needs the no-fit polygon of every unpacked convex polygon with every packed
+ * convex polygon at every depth of the search, so the same pairs of shapes come
+ * up over and over. Translating two convex polygons only translates their
+ * no-fit polygon, so it only needs to be computed once for each pair of shapes.
+ *
+ * Shapes are identified by the unique identifier of the convex polygon, which
+ * is retained when copying and transforming it, along with the index of the
+ * rotation that the convex polygon was packed in. The no-fit polygons are
+ * stored in a frame where the first vertex of both convex polygons is on the
+ * coordinate origin, so that they don't depend on where the convex polygons
+ * are.
+ *
+ * The cache holds a limited number of no-fit polygons. When it is full, the
+ * one that was used least recently makes room for the new one.
+ *
+ * The cache may be used from multiple threads at the same time.
+ */
+class NoFitPolygonCache {
+public:
+	/*!
+	 * Creates an empty cache.
+	 * \param capacity The maximum number of no-fit polygons to remember. If 0,
+	 * nothing is cached.
+	 */
+	NoFitPolygonCache(const size_t capacity = 16384);
+
+	/*!
+	 * Get the no-fit polygon of two convex polygons, computing it only if it
+	 * isn't in the cache yet.
+	 *
+	 * The no-fit polygon is returned in the frame where the first vertex of
+	 * both convex polygons is on the coordinate origin. To get the no-fit
+	 * polygon of the convex polygons at their actual positions, translate it by
+	 * the first vertex of the stationary convex polygon minus the first vertex
+	 * of the orbiting one. That translation is stored in `translation`.
+	 * \param stationary The convex polygon that stays in place.
+	 * \param stationary_rotation The index of the rotation that the stationary
+	 * convex polygon was packed in.
+	 * \param orbiting The convex polygon that gets translated.
+	 * \param orbiting_rotation The index of the rotation that the orbiting
+	 * convex polygon was packed in.
+	 * \param translation The translation that moves the returned no-fit
+	 * polygon to the actual positions of the convex polygons will be stored
+	 * here.
+	 * \return The no-fit polygon of the two convex polygons.
+	 */
+	std::shared_ptr<const NoFitPolygon> get(const ConvexPolygon& stationary, const size_t stationary_rotation, const ConvexPolygon& orbiting, const size_t orbiting_rotation, Point2& translation);
+
+	/*!
+	 * Get the no-fit polygon of two convex polygons, computing it from the
+	 * shape that the stationary convex polygon was translated from.
+	 *
+	 * Translating a convex polygon rounds its coordinates, so every placed
+	 * copy of a shape has slightly different edges. If the cached no-fit
+	 * polygon were computed from whichever copy happened to be looked up
+	 * first, every later lookup would inherit the rounding of that copy, and
+	 * with multiple threads that would depend on their timing. Computing it
+	 * from the untranslated shape instead makes the cached no-fit polygon the
+	 * same no matter which copy asks for it. The translation is still computed
+	 * from the actual position of the stationary convex polygon.
+	 * \param stationary The convex polygon that stays in place.
+	 * \param stationary_shape The convex polygon that the stationary one is a
+	 * translated copy of, with its vertices in the same order.
+	 * \param stationary_rotation The index of the rotation that the stationary
+	 * convex polygon was packed in.
+	 * \param orbiting The convex polygon that gets translated.
+	 * \param orbiting_rotation The index of the rotation that the orbiting
+	 * convex polygon was packed in.
+	 * \param translation The translation that moves the returned no-fit
+	 * polygon to the actual positions of the convex polygons will be stored
+	 * here.
+	 * \return The no-fit polygon of the two convex polygons.
+	 */
+	std::shared_ptr<const NoFitPolygon> get(const ConvexPolygon& stationary, const ConvexPolygon& stationary_shape, const size_t stationary_rotation, const ConvexPolygon& orbiting, const size_t orbiting_rotation, Point2& translation);
+
+	/*!
+	 * Forget all cached no-fit polygons.
+	 *
+	 * The numbers of hits and misses are kept.
+	 */
+	void clear();
+
+	/*!
+	 * Get the maximum number of no-fit polygons that the cache remembers.
+	 * \return The capacity of the cache.
+	 */
+	size_t get_capacity() const;
+
+	/*!
+	 * Change the maximum number of no-fit polygons that the cache remembers.
+	 *
+	 * If the cache holds more than that, the ones used least recently are
+	 * forgotten.
+	 * \param new_capacity The new capacity of the cache. If 0, nothing is
+	 * cached.
+	 */
+	void set_capacity(const size_t new_capacity);
+
+	/*!
+	 * Get the number of no-fit polygons cached at the moment.
+	 * \return The number of cached no-fit polygons.
+	 */
+	size_t size() const;
+
+	/*!
+	 * Get how many times a no-fit polygon was found in the cache.
+	 * \return The number of cache hits.
+	 */
+	size_t get_hits() const;
+
+	/*!
+	 * Get how many times a no-fit polygon had to be computed because it wasn't
+	 * in the cache.
+	 * \return The number of cache misses.
+	 */
+	size_t get_misses() const;
+
+private:
+	/*!
+	 * What identifies the shapes of a pair of convex polygons.
+	 */
+	struct Key {
+		/*!
+		 * The identifier of the stationary convex polygon.
+		 */
+		uint64_t stationary_uid;
+
+		/*!
+		 * The rotation index of the stationary convex polygon.
+		 */
+		size_t stationary_rotation;
+
+		/*!
+		 * The identifier of the orbiting convex polygon.
+		 */
+		uint64_t orbiting_uid;
+
+		/*!
+		 * The rotation index of the orbiting convex polygon.
+		 */
+		size_t orbiting_rotation;
+
+		/*!
+		 * Test whether two keys identify the same pair of shapes.
+		 * \param other The key to compare with.
+		 * \return `true` if the keys are equal, or `false` if they are not.
+		 */
+		bool operator ==(const Key& other) const;
+	};
+
+	/*!
+	 * Computes a hash of a key, to store it in a hash map.
+	 */
+	struct KeyHash {
+		/*!
+		 * Compute the hash of a key.
+		 * \param key The key to compute the hash of.
+		 * \return A hash of the key.
+		 */
+		size_t operator ()(const Key& key) const;
+	};
+
+	/*!
+	 * A cached no-fit polygon.
+	 */
+	struct Entry {
+		/*!
+		 * The pair of shapes that this is the no-fit polygon of.
+		 */
+		Key key;
+
+		/*!
+		 * The first edge of the stationary convex polygon.
+		 *
+		 * Convex polygons can be rotated without changing their identifier. If
+		 * the first edge is not the same, the convex polygon was rotated
+		 * without the rotation index telling so, and the cached no-fit polygon
+		 * can't be used.
+		 */
+		Point2 stationary_edge;
+
+		/*!
+		 * The first edge of the orbiting convex polygon, to recognise whether
+		 * it was rotated.
+		 */
+		Point2 orbiting_edge;
+
+		/*!
+		 * The no-fit polygon, in the frame where the first vertex of both
+		 * convex polygons is on the coordinate origin.
+		 */
+		std::shared_ptr<const NoFitPolygon> no_fit_polygon;
+	};
+
+	/*!
+	 * How much the first edges of two convex polygons may differ, relative to
+	 * their length, for them to be considered to have the same rotation.
+	 *
+	 * This is roughly the angle in radians between them.
+	 */
+	static constexpr double rotation_tolerance = 0.0001;
+
+	/*!
+	 * The maximum number of no-fit polygons to remember.
+	 */
+	size_t capacity;
+
+	/*!
+	 * The cached no-fit polygons, from the most recently used to the least
+	 * recently used.
+	 */
+	std::list<Entry> entries;
+
+	/*!
+	 * Where to find the cached no-fit polygon of each pair of shapes in the
+	 * list of entries.
+	 */
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+
+	/*!
+	 * How many times a no-fit polygon was found in the cache.
+	 */
+	size_t hits;
+
+	/*!
+	 * How many times a no-fit polygon was not found in the cache.
+	 */
+	size_t misses;
+
+	/*!
+	 * Protects the cache from being modified by multiple threads at the same
+	 * time.
+	 */
+	mutable std::mutex mutex;
+
+	/*!
+	 * Get the first vertex of a convex polygon, which is where the frame of
+	 * the cached no-fit polygons is anchored.
+	 * \param convex_polygon The convex polygon to get the first vertex of.
+	 * \return The first vertex, or the coordinate origin if the convex
+	 * polygon has no vertices.
+	 */
+	static Point2 anchor(const ConvexPolygon& convex_polygon);
+
+	/*!
+	 * Get the first edge of a convex polygon, to recognise its rotation.
+	 * \param convex_polygon The convex polygon to get the first edge of.
+	 * \return The vector from the first vertex to the second, or a zero
+	 * vector if the convex polygon has fewer than two vertices.
+	 */
+	static Point2 first_edge(const ConvexPolygon& convex_polygon);
+
+	/*!
+	 * Test whether two first edges of a convex polygon have the same rotation.
+	 * \param edge The first edge of the convex polygon in the cache.
+	 * \param other_edge The first edge of the convex polygon being looked up.
+	 * \return `true` if they are the same, apart from rounding errors, or
+	 * `false` if the convex polygon was rotated.
+	 */
+	static bool same_rotation(const Point2& edge, const Point2& other_edge);
+
+	/*!
+	 * Forget the least recently used no-fit polygons until the cache holds no
+	 * more than its capacity.
+	 */
+	void evict();
+};
+
+}
+
+#endif
\ No newline at end of file
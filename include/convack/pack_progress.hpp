@@ -0,0 +1,49 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_PACK_PROGRESS
+#define CONVACK_PACK_PROGRESS
+
+#include <cstddef> //For size_t.
+#include <functional> //To report progress through a callback.
+
+namespace convack {
+
+/*!
+ * How far a packing has come.
+ *
+ * This is reported after each depth of the search, i.e. each time one more
+ * convex polygon got packed in all candidates of the search.
+ */
+struct PackProgress {
+	/*!
+	 * How many convex polygons are packed so far.
+	 */
+	size_t depth;
+
+	/*!
+	 * How many convex polygons there are to pack in total.
+	 */
+	size_t num_convex_polygons;
+
+	/*!
+	 * The score of the best candidate packing at this depth. Lower is better.
+	 *
+	 * Scores are only comparable between candidates with the same depth.
+	 */
+	double best_score;
+};
+
+/*!
+ * A function to call whenever the packing has made progress.
+ *
+ * It gets called from the thread that runs the packing, so it shouldn't take
+ * long and it must be safe to call from that thread.
+ */
+typedef std::function<void(const PackProgress&)> ProgressCallback;
+
+}
+
+#endif
\ No newline at end of file
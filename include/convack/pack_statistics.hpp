@@ -0,0 +1,132 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_PACK_STATISTICS
+#define CONVACK_PACK_STATISTICS
+
+#include <cstddef> //For size_t.
+#include <ostream> //To be able to serialise the statistics to a stream.
+#include <vector> //To store the time spent at each depth of the search.
+
+namespace convack {
+
+/*!
+ * Measurements of what the packing spent its time on.
+ *
+ * This tells why a packing is slow, and helps to tune settings such as the beam
+ * width for a certain kind of packing job.
+ *
+ * The counters of individual operations are only kept if the library was
+ * compiled with the `CONVACK_STATISTICS` option. Without it, counting would
+ * cost time in the innermost loops of the packing, so the counters compile to
+ * nothing and stay 0. The time spent at each depth and the cache statistics
+ * are always measured.
+ */
+struct PackStatistics {
+	/*!
+	 * How many child candidates were placed and scored.
+	 */
+	size_t candidates_generated;
+
+	/*!
+	 * How many of the generated candidates were not constructed, because their
+	 * score wasn't good enough to get into the beam.
+	 */
+	size_t candidates_pruned;
+
+	/*!
+	 * How many times the score of a packing was computed.
+	 */
+	size_t score_evaluations;
+
+	/*!
+	 * How many convex hulls were constructed.
+	 */
+	size_t hull_computations;
+
+	/*!
+	 * How many times two convex polygons were tested for collision.
+	 */
+	size_t collision_tests;
+
+	/*!
+	 * How many collision and containment tests could stop after only checking
+	 * the bounding boxes.
+	 */
+	size_t bounding_box_early_outs;
+
+	/*!
+	 * How many no-fit polygons could be reused from the cache of the scene.
+	 *
+	 * Only the lookups of this packing are counted, even if other packings in
+	 * the same scene use the cache at the same time.
+	 */
+	size_t cache_hits;
+
+	/*!
+	 * How many no-fit polygons had to be computed because they were not in the
+	 * cache of the scene.
+	 */
+	size_t cache_misses;
+
+	/*!
+	 * How many blocks of memory were allocated to store candidates in.
+	 *
+	 * The memory is reused between packings in the same scene, so this is
+	 * usually only more than 0 for the first packing.
+	 *
+	 * This only counts the blocks for the candidates themselves. Each thread
+	 * also keeps memory to expand candidates with, which it reuses for every
+	 * candidate and which is not counted. The convex polygons that candidates
+	 * keep are allocated separately for each candidate that makes it into a
+	 * beam, which isn't counted either.
+	 */
+	size_t allocations;
+
+	/*!
+	 * The wall time spent at each depth of the search, in seconds.
+	 *
+	 * The first entry is the time spent creating the roots of the search tree.
+	 * Every next entry is the time spent on placing one more convex polygon
+	 * into each of the candidates in the beam.
+	 */
+	std::vector<double> depth_times;
+
+	/*!
+	 * Whether the time or evaluation budget of the scene ran out.
+	 *
+	 * If so, the packing was completed greedily from the best candidate found
+	 * until then.
+	 */
+	bool budget_exhausted;
+
+	/*!
+	 * Constructs statistics where nothing has been measured yet.
+	 */
+	PackStatistics();
+
+	/*!
+	 * Add the measurements of other statistics to these.
+	 * \param other The statistics to add.
+	 * \return A reference to these statistics, to allow chaining.
+	 */
+	PackStatistics& operator +=(const PackStatistics& other);
+
+	/*!
+	 * Reset all measurements to 0.
+	 */
+	void clear();
+
+	/*!
+	 * Overloads streaming the statistics.
+	 *
+	 * This gives a readable summary, for instance to write to a log.
+	 */
+	friend std::ostream& operator <<(std::ostream& output_stream, const PackStatistics& statistics);
+};
+
+}
+
+#endif
\ No newline at end of file
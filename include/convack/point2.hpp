@@ -53,6 +53,13 @@ struct Point2 {
 	 */
 	bool operator !=(const Point2& other) const;
 
+	/*!
+	 * Adds the coordinates of two points element-wise.
+	 * \param other The point to add to this point.
+	 * \return A new point with the result of the addition.
+	 */
+	Point2 operator +(const Point2& other) const;
+
 	/*!
 	 * Subtracts the coordinates of one point from those of another
 	 * element-wise.
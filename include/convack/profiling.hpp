@@ -0,0 +1,175 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_PROFILING_ZONES
+#define CONVACK_PROFILING_ZONES
+
+#include <chrono> //To time the zones.
+#include <cstddef> //For size_t.
+#include <deque> //To keep the events of each thread at a fixed place in memory.
+#include <mutex> //To register the threads that record events.
+#include <ostream> //To write the trace to a stream.
+#include <vector> //To store the events of each thread.
+
+/*!
+ * Trace the time spent in the rest of the current scope as a zone in the
+ * profile of the current thread.
+ *
+ * If the library is compiled without the `CONVACK_PROFILING` option, this
+ * compiles to nothing. Only one zone can be traced per scope.
+ * \param name The name of the zone, as it should appear in the trace. This
+ * must be a string literal, without quotes or backslashes in it.
+ */
+#ifdef CONVACK_PROFILING
+	#define CONVACK_ZONE(name) const convack::ProfileZone convack_profile_zone(name)
+#else
+	#define CONVACK_ZONE(name)
+#endif
+
+namespace convack {
+
+/*!
+ * Records where the packing spends its time, to see it in a trace viewer.
+ *
+ * The library traces zones around the operations that the packing spends most
+ * of its time in, with \ref CONVACK_ZONE. Each thread records those in its own
+ * list of events, so that the threads don't wait for each other. The events of
+ * all threads can then be written as a Chrome trace, which can be opened in
+ * `chrome://tracing`, Perfetto or Speedscope to get a timeline or a flame
+ * graph.
+ *
+ * Tracing a zone costs about as much as reading the clock twice, which is much
+ * more than some of the operations that are traced. So the durations are only
+ * meaningful relative to each other, and only in a build with the
+ * `CONVACK_PROFILING` option.
+ */
+class Profiler {
+public:
+	/*!
+	 * Record that a zone was executed on the current thread.
+	 * \param name The name of the zone. This must stay valid, like a string
+	 * literal.
+	 * \param start When the zone started.
+	 * \param end When the zone ended.
+	 */
+	static void record(const char* name, const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end);
+
+	/*!
+	 * Write all events recorded so far as a trace in the Chrome trace event
+	 * format.
+	 *
+	 * No packing may be running while writing the trace.
+	 * \param output_stream The stream to write the JSON document to.
+	 */
+	static void write_trace(std::ostream& output_stream);
+
+	/*!
+	 * Forget all events recorded so far, to trace something else.
+	 *
+	 * No packing may be running while clearing the events.
+	 */
+	static void clear();
+
+	/*!
+	 * Count how many events were recorded so far, on all threads together.
+	 * \return The number of recorded events.
+	 */
+	static size_t size();
+
+private:
+	/*!
+	 * One execution of a zone.
+	 */
+	struct Event {
+		/*!
+		 * The name of the zone.
+		 */
+		const char* name;
+
+		/*!
+		 * When the zone started.
+		 */
+		std::chrono::steady_clock::time_point start;
+
+		/*!
+		 * When the zone ended.
+		 */
+		std::chrono::steady_clock::time_point end;
+	};
+
+	/*!
+	 * The events recorded by one thread.
+	 */
+	struct Thread {
+		/*!
+		 * A number for the thread, to tell the threads apart in the trace.
+		 */
+		size_t id;
+
+		/*!
+		 * The events recorded by the thread, in the order in which the zones
+		 * ended.
+		 */
+		std::vector<Event> events;
+	};
+
+	/*!
+	 * Get the events of the current thread, registering it if it hasn't
+	 * recorded anything before.
+	 * \return The events of the current thread.
+	 */
+	static Thread& local();
+
+	/*!
+	 * The events of all threads that recorded any.
+	 *
+	 * The threads keep recording into their own entry without locking, so the
+	 * entries must not move. A deque doesn't move its elements when it grows.
+	 * The events stay here when the thread ends, since the beam search starts
+	 * new threads for every depth.
+	 */
+	static std::deque<Thread> threads;
+
+	/*!
+	 * Protects \ref threads when a new thread registers itself.
+	 */
+	static std::mutex threads_mutex;
+};
+
+/*!
+ * Traces the time between its construction and destruction as a zone.
+ *
+ * Use \ref CONVACK_ZONE to create these, so that they compile to nothing
+ * unless the library is compiled with the `CONVACK_PROFILING` option.
+ */
+class ProfileZone {
+public:
+	/*!
+	 * Starts a zone.
+	 * \param name The name of the zone. This must stay valid, like a string
+	 * literal.
+	 */
+	ProfileZone(const char* name);
+
+	/*!
+	 * Ends the zone, recording it in the profile of the current thread.
+	 */
+	~ProfileZone();
+
+private:
+	/*!
+	 * The name of the zone.
+	 */
+	const char* name;
+
+	/*!
+	 * When the zone started.
+	 */
+	std::chrono::steady_clock::time_point start;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -6,12 +6,20 @@
 #ifndef CONVACK_SCENE
 #define CONVACK_SCENE
 
+#include <functional> //To run asynchronous packings on an executor of the caller.
+#include <future> //To return the result of asynchronous packings.
 #include <memory> //For unique_ptr.
 #include <vector> //As input for a set of convex polygons.
 
+#include "cancellation.hpp" //To stop asynchronous packings.
+#include "convex_polygon.hpp" //To return the result of asynchronous packings.
+#include "pack_progress.hpp" //To report the progress of asynchronous packings.
+
 namespace convack {
 
-class ConvexPolygon;
+class Layout;
+struct PackStatistics;
+class SpatialIndex;
 
 /*!
  * A space to pack convex polygons into.
@@ -52,6 +60,110 @@ public:
 	 */
 	size_t get_beam_width() const;
 
+	/*!
+	 * Gets the current value for the number of threads setting.
+	 *
+	 * See \ref set_num_threads for an explanation of what this setting
+	 * controls.
+	 * \return The current value for the number of threads setting.
+	 */
+	size_t get_num_threads() const;
+
+	/*!
+	 * Gets the current value for the rotations setting.
+	 *
+	 * See \ref set_rotations for an explanation of what this setting controls.
+	 * \return The current value for the rotations setting.
+	 */
+	const std::vector<double>& get_rotations() const;
+
+	/*!
+	 * Gets the current value for the time budget setting.
+	 *
+	 * See \ref set_time_budget for an explanation of what this setting
+	 * controls.
+	 * \return The current value for the time budget setting.
+	 */
+	double get_time_budget() const;
+
+	/*!
+	 * Gets the current value for the evaluation budget setting.
+	 *
+	 * See \ref set_evaluation_budget for an explanation of what this setting
+	 * controls.
+	 * \return The current value for the evaluation budget setting.
+	 */
+	size_t get_evaluation_budget() const;
+
+	/*!
+	 * Gets the current value for the deterministic setting.
+	 *
+	 * See \ref set_deterministic for an explanation of what this setting
+	 * controls.
+	 * \return The current value for the deterministic setting.
+	 */
+	bool is_deterministic() const;
+
+	/*!
+	 * Gets the container that the convex polygons are packed into.
+	 *
+	 * See \ref set_container for an explanation of the container.
+	 * \return The container, or an empty convex polygon if the scene has none.
+	 */
+	const ConvexPolygon& get_container() const;
+
+	/*!
+	 * Gets the obstacles that the convex polygons are packed around.
+	 *
+	 * See \ref set_obstacles for an explanation of the obstacles.
+	 * \return The obstacles in the scene.
+	 */
+	const std::vector<ConvexPolygon>& get_obstacles() const;
+
+	/*!
+	 * Gets an index of the obstacles in the scene, to quickly find which
+	 * obstacles are near a placement.
+	 *
+	 * The index is built once when the obstacles are set, so that packings
+	 * don't need to build it again.
+	 * \return An index of the obstacles.
+	 */
+	const SpatialIndex& get_obstacle_index() const;
+
+	/*!
+	 * Gets the convex polygons placed so far by \ref pack_more.
+	 * \return The layout of convex polygons that later calls to
+	 * \ref pack_more continue from.
+	 */
+	const Layout& get_layout() const;
+
+	/*!
+	 * Gets the current value for the cache size setting.
+	 *
+	 * See \ref set_cache_size for an explanation of what this setting
+	 * controls.
+	 * \return The current value for the cache size setting.
+	 */
+	size_t get_cache_size() const;
+
+	/*!
+	 * Gets how many times a no-fit polygon could be reused from the cache.
+	 *
+	 * This counts all packings done in this scene so far. Together with
+	 * \ref get_cache_misses, this tells whether the cache is big enough.
+	 * \return The number of cache hits.
+	 */
+	size_t get_cache_hits() const;
+
+	/*!
+	 * Gets how many times a no-fit polygon had to be computed because it was
+	 * not in the cache.
+	 *
+	 * This counts all packings done in this scene so far.
+	 * \return The number of cache misses.
+	 */
+	size_t get_cache_misses() const;
+
 	/*!
 	 * Create a packing of a given list of convex polygons.
 	 *
@@ -63,6 +175,14 @@ public:
 	 *
 	 * The order of these convex polygons will not be modified. You can use this
 	 * order to identify which convex polygon was which.
+	 *
+	 * Convex polygons with the same shape are recognised up front, and treated
+	 * as interchangeable. Which of the copies ends up where is arbitrary, but
+	 * repeated shapes make the packing a lot faster.
+	 *
+	 * Multiple packings may run at the same time in one scene, from different
+	 * threads. The first one reuses the memory for candidates kept in the
+	 * scene, and the others get memory of their own.
 	 * \param convex_polygons A list of convex polygons that need to be packed.
 	 * This list only needs to exist during the execution of the packing
 	 * algorithm. The packed convex polygons don't stay in the scene. The result
@@ -70,6 +190,136 @@ public:
 	 */
 	void pack(std::vector<ConvexPolygon>& convex_polygons) const;
 
+	/*!
+	 * Create a packing of a given list of convex polygons, and measure what
+	 * the packing spent its time on.
+	 *
+	 * This packs the convex polygons the same way as \ref pack without
+	 * statistics does.
+	 * \param convex_polygons A list of convex polygons that need to be packed.
+	 * The result will be stored in this same list.
+	 * \param statistics The measurements of this packing will be stored here.
+	 * Any earlier measurements in it are cleared.
+	 */
+	void pack(std::vector<ConvexPolygon>& convex_polygons, PackStatistics& statistics) const;
+
+	/*!
+	 * Create packings of many independent lists of convex polygons.
+	 *
+	 * Each list is packed the same way as \ref pack would, but this is made
+	 * for throughput rather than for the latency of each packing. Instead of
+	 * spreading each search over multiple threads, the lists are spread over
+	 * the threads. Each thread takes the next list that no thread has taken
+	 * yet, so a thread that got small lists takes more of them. The threads
+	 * share the cache of no-fit polygons, so a shape that was seen in one list
+	 * is fast to pack in the others. Each thread reuses its memory for the
+	 * candidates of its searches between its lists.
+	 *
+	 * The number of threads setting determines how many threads the lists are
+	 * spread over. The packing of each list is still the same as if it had
+	 * been packed on its own.
+	 * \param batch The lists of convex polygons that need to be packed. The
+	 * result will be stored in these same lists.
+	 */
+	void pack_batch(std::vector<std::vector<ConvexPolygon>>& batch) const;
+
+	/*!
+	 * Create packings of many independent lists of convex polygons, and
+	 * measure what the packings spent their time on.
+	 *
+	 * This packs the lists the same way as \ref pack_batch without statistics
+	 * does.
+	 * \param batch The lists of convex polygons that need to be packed. The
+	 * result will be stored in these same lists.
+	 * \param statistics The measurements of all packings together will be
+	 * stored here. Any earlier measurements in it are cleared.
+	 */
+	void pack_batch(std::vector<std::vector<ConvexPolygon>>& batch, PackStatistics& statistics) const;
+
+	/*!
+	 * Pack a few more convex polygons next to the ones packed before, and keep
+	 * them there.
+	 *
+	 * This is for convex polygons that arrive a few at a time. Unlike
+	 * \ref pack, which starts from scratch, this continues from the layout of
+	 * the earlier calls. The convex polygons placed earlier stay where they
+	 * are. The new convex polygons are packed against them, and then
+	 * committed to the layout as well, so that the next call packs against
+	 * them too.
+	 *
+	 * The layout keeps its index for collision tests, its convex hull and its
+	 * covered area up to date as it grows. The search only decides where to put
+	 * the new convex polygons, so adding a few to a big layout is about as
+	 * much search work as packing those few on their own.
+	 *
+	 * Convex polygons that don't fit in the container are left where they were
+	 * and are not added to the layout. The scene must not be used for any
+	 * other packing while this is running.
+	 * \param convex_polygons The new convex polygons that need to be packed.
+	 * The result will be stored in this same list.
+	 */
+	void pack_more(std::vector<ConvexPolygon>& convex_polygons);
+
+	/*!
+	 * Pack a few more convex polygons next to the ones packed before, keep
+	 * them there, and measure what the packing spent its time on.
+	 *
+	 * This packs the convex polygons the same way as \ref pack_more without
+	 * statistics does.
+	 * \param convex_polygons The new convex polygons that need to be packed.
+	 * The result will be stored in this same list.
+	 * \param statistics The measurements of this packing will be stored here.
+	 * Any earlier measurements in it are cleared.
+	 */
+	void pack_more(std::vector<ConvexPolygon>& convex_polygons, PackStatistics& statistics);
+
+	/*!
+	 * Forget the convex polygons placed by \ref pack_more, so that the next
+	 * call starts from scratch.
+	 */
+	void clear_layout();
+
+	/*!
+	 * A function that runs tasks, for instance on a thread pool.
+	 *
+	 * It gets a task to run, and should call it exactly once, on whichever
+	 * thread it chooses. It should return without waiting for the task.
+	 */
+	typedef std::function<void(std::function<void()>)> Executor;
+
+	/*!
+	 * Create a packing of a given list of convex polygons, without waiting for
+	 * the result.
+	 *
+	 * This packs the convex polygons the same way as \ref pack does, but on a
+	 * different thread. The calling thread can do other work in the meanwhile,
+	 * and obtain the result from the returned future once it needs it.
+	 *
+	 * While the packing runs, it reports its progress after each depth of the
+	 * search: how many convex polygons it has packed so far, and the score of
+	 * the best candidate packing. The packing can be stopped by cancelling the
+	 * given cancellation. It then stops as soon as it can, and the future gets
+	 * the convex polygons as they were given, unpacked.
+	 *
+	 * The scene must stay alive until the packing is done, and its settings
+	 * must not be changed in the meanwhile. Multiple packings may run at the
+	 * same time in one scene. They share its cache of no-fit polygons, but
+	 * each gets its own memory for the candidates of its search.
+	 * \param convex_polygons The convex polygons that need to be packed. They
+	 * are copied, so the list doesn't need to stay alive during the packing.
+	 * \param progress A function to call whenever the packing has made
+	 * progress. It is called from the thread that runs the packing. May be
+	 * empty.
+	 * \param cancellation A signal to stop the packing. Keep a copy of it to be
+	 * able to cancel the packing.
+	 * \param executor A function to run the packing with. If empty, the
+	 * packing runs on a new thread. In that case, destroying the future waits
+	 * until the packing is done, so cancel it first if the result is not
+	 * needed any more.
+	 * \return The packed convex polygons, once the packing is done.
+	 */
+	std::future<std::vector<ConvexPolygon>> pack_async(std::vector<ConvexPolygon> convex_polygons, const ProgressCallback& progress = ProgressCallback(), const Cancellation& cancellation = Cancellation(), const Executor& executor = Executor()) const;
+
 	/*!
 	 * Change the beam width of the beam search.
 	 *
@@ -90,6 +340,137 @@ public:
 	 */
 	void set_beam_width(const size_t new_beam_width);
 
+	/*!
+	 * Change the number of threads that the packing may use.
+	 *
+	 * The beam search expands all of the candidates in its beam at each stage
+	 * of the search. Those candidates are independent of each other, so they
+	 * can be expanded in parallel. With more threads, the packing will finish
+	 * sooner on a computer with multiple processor cores. The result of the
+	 * packing is the same regardless of the number of threads.
+	 *
+	 * No more threads will be used than the beam width, since there would be
+	 * nothing to do for the additional threads.
+	 *
+	 * If the number of threads is 0, the packing uses as many threads as the
+	 * computer has processor cores. The default is 1, which performs the whole
+	 * packing on the thread that calls \ref pack.
+	 * \param new_num_threads The new number of threads setting.
+	 */
+	void set_num_threads(const size_t new_num_threads);
+
+	/*!
+	 * Change the rotations that the convex polygons may be packed in.
+	 *
+	 * Each convex polygon is tried in each of these rotations. The rotated
+	 * convex polygons are computed once when packing starts, so the number of
+	 * rotations doesn't affect how expensive it is to place a convex polygon.
+	 * It does multiply the number of placements to try though, so more
+	 * rotations make the packing slower.
+	 *
+	 * The rotations are angles in radians, counter-clockwise around the
+	 * coordinate origin. The default is only 0, which doesn't rotate the
+	 * convex polygons at all. If the list is empty, that is the same as 0.
+	 * \param new_rotations The new rotations setting.
+	 */
+	void set_rotations(const std::vector<double>& new_rotations);
+
+	/*!
+	 * Change how long the packing may take.
+	 *
+	 * Once the time runs out, the packing stops exploring alternatives. It
+	 * takes the best candidate found so far and completes it greedily, adding
+	 * the convex polygon that fits best one at a time. That takes about as
+	 * long as one step of a search with a beam width of 1 for each remaining
+	 * convex polygon, so the packing may take a bit longer than the budget.
+	 *
+	 * This allows a fixed latency, trading the quality of the packing for it,
+	 * rather than guessing a beam width that would be fast enough.
+	 *
+	 * If the time budget is 0, the packing may take as long as it needs. This
+	 * is the default.
+	 * \param new_time_budget The new time budget setting, in seconds.
+	 */
+	void set_time_budget(const double new_time_budget);
+
+	/*!
+	 * Change how many candidate placements the packing may evaluate.
+	 *
+	 * This is like the time budget, but the point where the search stops
+	 * doesn't depend on how fast the computer is. Like with the time budget,
+	 * the best candidate so far is completed greedily, which may evaluate a
+	 * few more placements.
+	 *
+	 * If the evaluation budget is 0, the packing may evaluate as many
+	 * placements as it needs. This is the default.
+	 * \param new_evaluation_budget The new evaluation budget setting.
+	 */
+	void set_evaluation_budget(const size_t new_evaluation_budget);
+
+	/*!
+	 * Change whether packings must give exactly the same result every time.
+	 *
+	 * Without a budget, a packing always gives the same result, regardless of
+	 * the number of threads. With a budget, the threads stop wherever they are
+	 * when the budget runs out, so the packing depends on how fast the
+	 * computer is and how the threads were scheduled.
+	 *
+	 * In deterministic mode, the time budget is ignored. The evaluation budget
+	 * is only checked after all candidates in the beam are expanded, so the
+	 * search stops at the same point regardless of the number of threads. It
+	 * may evaluate up to one step of the search more than the budget allows.
+	 * This gives reproducible packings for audits and regression tests.
+	 *
+	 * Deterministic mode is off by default.
+	 * \param new_deterministic Whether packings must be deterministic.
+	 */
+	void set_deterministic(const bool new_deterministic);
+
+	/*!
+	 * Change the container that the convex polygons must be packed into.
+	 *
+	 * Placements of convex polygons that stick out of the container are
+	 * dropped before they are scored. The packing grows from the centre of the
+	 * container. Placements are only tried against the convex polygons and
+	 * obstacles placed so far, not against the edge of the container, so a
+	 * container that fits the convex polygons very tightly may not get filled
+	 * completely.
+	 *
+	 * An empty convex polygon means that there is no container, so that the
+	 * packing may grow in any direction. That is the default.
+	 * \param new_container The new container.
+	 */
+	void set_container(const ConvexPolygon& new_container);
+
+	/*!
+	 * Change the obstacles that the convex polygons must be packed around.
+	 *
+	 * Obstacles are convex polygons that stay where they are. The packed
+	 * convex polygons are placed against them as if they were packed already,
+	 * but they don't count towards the area of the packing. They are copied
+	 * into the scene, and indexed right away for use by all later packings.
+	 *
+	 * By default there are no obstacles.
+	 * \param new_obstacles The new obstacles.
+	 */
+	void set_obstacles(const std::vector<ConvexPolygon>& new_obstacles);
+
+	/*!
+	 * Change how many no-fit polygons the scene remembers between packings.
+	 *
+	 * To place a convex polygon, the packing needs to know where it would
+	 * touch each convex polygon packed so far. That is described by their
+	 * no-fit polygon. Copies of a convex polygon retain its identifier, so if
+	 * there are many copies of the same shapes, the same no-fit polygons are
+	 * needed over and over again. The scene caches them, also for later
+	 * packings. When the cache is full, the no-fit polygons that were used
+	 * least recently are forgotten.
+	 *
+	 * If the cache size is 0, nothing is cached. The default is 16384.
+	 * \param new_cache_size The maximum number of no-fit polygons to remember.
+	 */
+	void set_cache_size(const size_t new_cache_size);
+
 private:
 	/*!
 	 * The implementation of the scene is separated into this class.
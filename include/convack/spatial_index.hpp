@@ -0,0 +1,184 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_SPATIAL_INDEX
+#define CONVACK_SPATIAL_INDEX
+
+#include <cstddef> //For size_t.
+#include <cstdint> //To combine cell coordinates into one key.
+#include <unordered_map> //To store only the cells of the grid that are in use.
+#include <vector> //To store the convex polygons in each cell.
+
+#include "coordinate.hpp" //To store the cell size.
+
+namespace convack {
+
+struct BoundingBox;
+class ConvexPolygon;
+
+/*!
+ * A broad-phase index to quickly find which convex polygons are near some area.
+ *
+ * Testing a convex polygon for collision against all convex polygons placed so
+ * far takes linear time in the number of placed convex polygons. Most of those
+ * are far away though. This index divides the plane into a uniform grid of
+ * square cells, and remembers which convex polygons have their bounding box in
+ * each cell. To find the convex polygons near an area, only the cells covering
+ * that area need to be looked at. If the cells are about as large as the
+ * convex polygons, that takes constant time.
+ *
+ * Only the cells that contain something are stored, so the grid is unbounded.
+ * Clearing the index keeps its cells, so that an index that gets filled over
+ * and over again in the same area reuses their memory.
+ * Convex polygons that would cover very many cells are kept in a separate list
+ * that is always checked, so that a single huge convex polygon can't fill the
+ * whole grid.
+ *
+ * The index stores pointers to the convex polygons. They must stay alive and
+ * must not be moved while they are in the index.
+ */
+class SpatialIndex {
+public:
+	/*!
+	 * Creates an empty spatial index.
+	 * \param cell_size The width and height of the cells of the grid. For best
+	 * performance, this should be about the size of the convex polygons being
+	 * inserted.
+	 */
+	SpatialIndex(const coordinate_t cell_size);
+
+	/*!
+	 * Add a convex polygon to the index.
+	 * \param convex_polygon The convex polygon to add.
+	 */
+	void insert(const ConvexPolygon* convex_polygon);
+
+	/*!
+	 * Find the convex polygons whose bounding box overlaps with a given
+	 * bounding box.
+	 *
+	 * Like with convex polygons, bounding boxes that only touch each other are
+	 * not considered to be overlapping.
+	 * \param bounding_box The area to search in.
+	 * \param result A list to add the overlapping convex polygons to. Each of
+	 * them is added only once, in the order in which they were inserted.
+	 */
+	void query(const BoundingBox& bounding_box, std::vector<const ConvexPolygon*>& result) const;
+
+	/*!
+	 * Find the convex polygons whose bounding box overlaps with a given
+	 * bounding box, by the order in which they were inserted.
+	 *
+	 * This allows looking up other data stored alongside the convex polygons
+	 * in the same order.
+	 * \param bounding_box The area to search in.
+	 * \param result A list to add the indices of the overlapping convex
+	 * polygons to. Each of them is added only once, in ascending order. Once
+	 * this list is large enough, querying into it doesn't allocate memory.
+	 */
+	void query(const BoundingBox& bounding_box, std::vector<size_t>& result) const;
+
+	/*!
+	 * Test whether a convex polygon collides with any convex polygon in the
+	 * index.
+	 *
+	 * This doesn't allocate memory, so that it can be used in the innermost
+	 * loops of the packing.
+	 * \param convex_polygon The convex polygon to test.
+	 * \return `true` if it collides with any of the convex polygons in the
+	 * index, or `false` if it doesn't.
+	 */
+	bool collides(const ConvexPolygon& convex_polygon) const;
+
+	/*!
+	 * Remove all convex polygons from the index.
+	 *
+	 * The memory of the index is kept. Filling the index again around the same
+	 * place doesn't need to allocate memory then.
+	 */
+	void clear();
+
+	/*!
+	 * Get the number of convex polygons in the index.
+	 * \return The number of convex polygons in the index.
+	 */
+	size_t size() const;
+
+private:
+	/*!
+	 * The maximum number of cells that a convex polygon may cover. Any convex
+	 * polygon that covers more cells is stored in \ref oversized instead.
+	 */
+	static constexpr int64_t max_cells_per_polygon = 64;
+
+	/*!
+	 * The width and height of the cells of the grid.
+	 */
+	coordinate_t cell_size;
+
+	/*!
+	 * All convex polygons in the index, in the order in which they were
+	 * inserted.
+	 *
+	 * The cells refer to the convex polygons by their position in this list.
+	 */
+	std::vector<const ConvexPolygon*> convex_polygons;
+
+	/*!
+	 * For each cell that is in use, which convex polygons have their bounding
+	 * box in that cell.
+	 */
+	std::unordered_map<uint64_t, std::vector<size_t>> cells;
+
+	/*!
+	 * The convex polygons that cover too many cells to store in the grid.
+	 */
+	std::vector<size_t> oversized;
+
+	/*!
+	 * Find the range of cells covered by a bounding box.
+	 * \param bounding_box The bounding box to find the cells for.
+	 * \param min_x The lowest X coordinate of the cells will be stored here.
+	 * \param min_y The lowest Y coordinate of the cells will be stored here.
+	 * \param max_x The highest X coordinate of the cells will be stored here.
+	 * \param max_y The highest Y coordinate of the cells will be stored here.
+	 */
+	void cell_range(const BoundingBox& bounding_box, int64_t& min_x, int64_t& min_y, int64_t& max_x, int64_t& max_y) const;
+
+	/*!
+	 * Test whether a convex polygon collides with any of the convex polygons
+	 * in one cell.
+	 *
+	 * Of the convex polygons that are in multiple cells that the convex
+	 * polygon covers, only the ones whose bounding box overlap starts in this
+	 * cell are tested. That way, going through all covered cells tests each of
+	 * them only once.
+	 * \param convex_polygon The convex polygon to test.
+	 * \param key The key of the cell.
+	 * \param cell The indices of the convex polygons in the cell.
+	 * \return `true` if it collides with any of those convex polygons, or
+	 * `false` if it doesn't.
+	 */
+	bool collides_in_cell(const ConvexPolygon& convex_polygon, const uint64_t key, const std::vector<size_t>& cell) const;
+
+	/*!
+	 * Find the cell coordinate of a coordinate in space, along one axis.
+	 * \param coordinate The coordinate in space.
+	 * \return The coordinate of the cell that it falls in.
+	 */
+	int64_t cell_of(const coordinate_t coordinate) const;
+
+	/*!
+	 * Combine the two coordinates of a cell into one key to store it with.
+	 * \param x The X coordinate of the cell.
+	 * \param y The Y coordinate of the cell.
+	 * \return A key that is unique for each cell.
+	 */
+	static uint64_t key_of(const int64_t x, const int64_t y);
+};
+
+}
+
+#endif
\ No newline at end of file
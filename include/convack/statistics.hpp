@@ -0,0 +1,54 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#ifndef CONVACK_STATISTICS_COUNTERS
+#define CONVACK_STATISTICS_COUNTERS
+
+#include "pack_statistics.hpp" //The counters to increment.
+
+/*!
+ * Count one occurrence of an operation in the statistics of the current thread.
+ *
+ * If the library is compiled without the `CONVACK_STATISTICS` option, this
+ * compiles to nothing.
+ * \param counter The name of the counter in \ref convack::PackStatistics to
+ * increment.
+ */
+#ifdef CONVACK_STATISTICS
+	#define CONVACK_COUNT(counter) (++convack::Statistics::local().counter)
+#else
+	#define CONVACK_COUNT(counter)
+#endif
+
+namespace convack {
+
+/*!
+ * Keeps the statistics counters of each thread.
+ *
+ * Incrementing a shared counter from many threads would make them wait for
+ * each other. Instead, each thread counts in its own statistics, which are
+ * collected into the total when the thread is done.
+ */
+class Statistics {
+public:
+	/*!
+	 * Get the statistics of the current thread.
+	 * \return The statistics that the current thread counts in.
+	 */
+	static PackStatistics& local();
+
+	/*!
+	 * Add the statistics of the current thread to a total, and reset them.
+	 *
+	 * This may be called from multiple threads at the same time.
+	 * \param total The statistics to add the counters of the current thread
+	 * to.
+	 */
+	static void collect(PackStatistics& total);
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 #define CONVACK_TRANSFORMATION
 
 #include <array> //To store the transformation matrix data.
+#include <vector> //To transform many points at once.
 
 #include "coordinate.hpp" //For the translate function.
 
@@ -27,11 +28,30 @@ public:
 	 */
 	Transformation();
 
+	/*!
+	 * Creates a transformation matrix from the cells of a matrix.
+	 *
+	 * This can restore a transformation that was stored earlier, with
+	 * \ref get_data.
+	 * \param data The cells of the matrix, in the same order as returned by
+	 * \ref get_data.
+	 */
+	Transformation(const std::array<double, 6>& data);
+
 	/*!
 	 * Test if two transformations yield the same result.
 	 */
 	bool operator ==(const Transformation& other) const;
 
+	/*!
+	 * Gets the cells of the transformation matrix, for instance to store them.
+	 *
+	 * The matrix is written column-major, and the bottom row, which is always
+	 * `[0, 0, 1]`, is left out.
+	 * \return The cells of the transformation matrix.
+	 */
+	const std::array<double, 6>& get_data() const;
+
 	/*!
 	 * Apply this transformation to a point.
 	 * \param point The point to apply the transformation to.
@@ -39,6 +59,16 @@ public:
 	 */
 	Point2 apply(const Point2& point) const;
 
+	/*!
+	 * Apply this transformation to a list of points in-place.
+	 *
+	 * This gives the same result as applying the transformation to each point
+	 * separately, but it is faster. The matrix is loaded only once, and the
+	 * loop over the points can be vectorised by the compiler.
+	 * \param points The points to transform.
+	 */
+	void apply(std::vector<Point2>& points) const;
+
 	/*!
 	 * Adds a rotation to this transformation matrix.
 	 *
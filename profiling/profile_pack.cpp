@@ -0,0 +1,165 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+/* Packs a synthetic workload and writes a trace of where the packing spent its
+time, in the Chrome trace event format. Open the trace in chrome://tracing,
+Perfetto or Speedscope to get a timeline or a flame graph. This only records
+anything if the library was compiled with the CONVACK_PROFILING option.
+
+Usage: profile_pack [trace file] [convex polygons] [minimum vertices]
+    [maximum vertices] [beam width] [threads] [rotations] [seed]
+
+The workload consists of random convex polygons: regular polygons with a random
+number of vertices in the given range, a random size and a random aspect ratio.
+The same seed always gives the same workload. */
+
+#include <algorithm> //For std::max.
+#include <chrono> //To time the packing.
+#include <cmath> //To generate the vertices of the convex polygons.
+#include <convack/convex_polygon.hpp> //The convex polygons to pack.
+#include <convack/pack_statistics.hpp> //To report what the packing spent its time on.
+#include <convack/point2.hpp> //To generate convex polygons.
+#include <convack/profiling.hpp> //To write the trace.
+#include <convack/scene.hpp> //To pack the convex polygons.
+#include <cstdlib> //To parse the command line arguments.
+#include <fstream> //To write the trace to a file.
+#include <iostream> //To report the results.
+#include <random> //To generate the workload.
+#include <string> //To parse the command line arguments.
+#include <vector> //To store the workload.
+
+/*!
+ * The settings of the workload to profile.
+ */
+struct Workload {
+	/*!
+	 * The file to write the trace to.
+	 */
+	std::string trace_file = "convack_trace.json";
+
+	/*!
+	 * How many convex polygons to pack.
+	 */
+	size_t num_convex_polygons = 30;
+
+	/*!
+	 * The least number of vertices of each convex polygon.
+	 */
+	size_t min_vertices = 3;
+
+	/*!
+	 * The greatest number of vertices of each convex polygon.
+	 */
+	size_t max_vertices = 10;
+
+	/*!
+	 * The beam width of the packing.
+	 */
+	size_t beam_width = 10;
+
+	/*!
+	 * How many threads to pack with. 0 uses all processor cores.
+	 */
+	size_t num_threads = 1;
+
+	/*!
+	 * How many evenly spread rotations the convex polygons may be packed in.
+	 */
+	size_t num_rotations = 1;
+
+	/*!
+	 * The seed for the random generator of the convex polygons.
+	 */
+	unsigned int seed = 42;
+};
+
+/*!
+ * Read a number from a command line argument.
+ * \param argument The command line argument.
+ * \return The number in the argument, or 0 if it's not a number.
+ */
+size_t parse_number(const char* argument) {
+	return static_cast<size_t>(std::strtoul(argument, nullptr, 10));
+}
+
+/*!
+ * Read the settings of the workload from the command line.
+ *
+ * The arguments are all optional, but each one needs the ones before it.
+ * \param argc The number of command line arguments.
+ * \param argv The command line arguments.
+ * \return The settings of the workload.
+ */
+Workload parse_arguments(const int argc, char** argv) {
+	Workload workload;
+	if(argc > 1) workload.trace_file = argv[1];
+	if(argc > 2) workload.num_convex_polygons = parse_number(argv[2]);
+	if(argc > 3) workload.min_vertices = std::max(parse_number(argv[3]), size_t(3)); //Fewer vertices have no area.
+	if(argc > 4) workload.max_vertices = std::max(parse_number(argv[4]), workload.min_vertices);
+	if(argc > 5) workload.beam_width = parse_number(argv[5]);
+	if(argc > 6) workload.num_threads = parse_number(argv[6]);
+	if(argc > 7) workload.num_rotations = std::max(parse_number(argv[7]), size_t(1));
+	if(argc > 8) workload.seed = static_cast<unsigned int>(parse_number(argv[8]));
+	return workload;
+}
+
+/*!
+ * Generate the convex polygons to pack.
+ * \param workload The settings of the workload.
+ * \return Random convex polygons, all around the coordinate origin.
+ */
+std::vector<convack::ConvexPolygon> generate(const Workload& workload) {
+	constexpr double pi = std::acos(-1);
+	std::mt19937 generator(workload.seed);
+	std::uniform_int_distribution<size_t> num_vertices_distribution(workload.min_vertices, workload.max_vertices);
+	std::uniform_real_distribution<double> radius_distribution(5, 20);
+	std::uniform_real_distribution<double> aspect_distribution(0.5, 1);
+
+	std::vector<convack::ConvexPolygon> result;
+	for(size_t i = 0; i < workload.num_convex_polygons; ++i) {
+		const size_t num_vertices = num_vertices_distribution(generator);
+		const double radius = radius_distribution(generator);
+		const double aspect = aspect_distribution(generator); //Squashing a regular polygon keeps it convex.
+		std::vector<convack::Point2> vertices;
+		for(size_t vertex = 0; vertex < num_vertices; ++vertex) {
+			const double angle = 2.0 * pi / num_vertices * vertex;
+			vertices.emplace_back(std::cos(angle) * radius, std::sin(angle) * radius * aspect);
+		}
+		result.emplace_back(vertices);
+	}
+	return result;
+}
+
+int main(int argc, char** argv) {
+	const Workload workload = parse_arguments(argc, argv);
+	std::vector<convack::ConvexPolygon> convex_polygons = generate(workload);
+
+	convack::Scene scene;
+	scene.set_beam_width(workload.beam_width);
+	scene.set_num_threads(workload.num_threads);
+	std::vector<double> rotations;
+	for(size_t rotation = 0; rotation < workload.num_rotations; ++rotation) {
+		rotations.push_back(2.0 * std::acos(-1) / workload.num_rotations * rotation);
+	}
+	scene.set_rotations(rotations);
+
+	std::cout << "Packing " << workload.num_convex_polygons << " convex polygons with " << workload.min_vertices << " to " << workload.max_vertices << " vertices..." << std::endl;
+	convack::Profiler::clear();
+	convack::PackStatistics statistics;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	scene.pack(convex_polygons, statistics);
+	const double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "Packed in " << duration << " seconds." << std::endl;
+	std::cout << statistics << std::endl;
+
+	std::ofstream trace(workload.trace_file);
+	if(!trace.is_open()) {
+		std::cout << "Failed to write to file: " << workload.trace_file << std::endl;
+		return 1;
+	}
+	convack::Profiler::write_trace(trace);
+	std::cout << "Wrote " << convack::Profiler::size() << " events to " << workload.trace_file << "." << std::endl;
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <algorithm> //For the heap operations.
+
+#include "beam/beam.hpp" //The definitions we're implementing here.
+#include "beam/packing_candidate.hpp" //To get the scores of the candidates.
+
+namespace convack {
+
+Beam::Beam(const size_t capacity) : capacity(capacity > 0 ? capacity : 1) {
+	entries.reserve(this->capacity);
+}
+
+bool Beam::accepts(const double score, const size_t order) const {
+	if(entries.size() < capacity) {
+		return true; //Still room.
+	}
+	const Entry& worst = entries.front();
+	return score < worst.score || (score == worst.score && order < worst.order);
+}
+
+PackingCandidate* Beam::insert(PackingCandidate* candidate, const size_t order) {
+	const double score = candidate->get_score();
+	if(!accepts(score, order)) {
+		return candidate; //Rejected.
+	}
+
+	PackingCandidate* pushed_out = nullptr;
+	if(entries.size() == capacity) { //Make room by removing the worst candidate.
+		std::pop_heap(entries.begin(), entries.end());
+		pushed_out = entries.back().candidate;
+		entries.pop_back();
+	}
+	entries.push_back({candidate, score, order});
+	std::push_heap(entries.begin(), entries.end());
+	return pushed_out;
+}
+
+void Beam::merge(Beam& other, std::vector<PackingCandidate*>& rejected) {
+	for(const Entry& entry : other.entries) {
+		PackingCandidate* pushed_out = insert(entry.candidate, entry.order);
+		if(pushed_out) {
+			rejected.push_back(pushed_out);
+		}
+	}
+	other.entries.clear();
+}
+
+std::vector<PackingCandidate*> Beam::take() {
+	std::sort_heap(entries.begin(), entries.end()); //Sorts from best to worst.
+	std::vector<PackingCandidate*> result;
+	result.reserve(entries.size());
+	for(const Entry& entry : entries) {
+		result.push_back(entry.candidate);
+	}
+	entries.clear();
+	return result;
+}
+
+size_t Beam::get_capacity() const {
+	return capacity;
+}
+
+size_t Beam::size() const {
+	return entries.size();
+}
+
+bool Beam::empty() const {
+	return entries.empty();
+}
+
+bool Beam::Entry::operator <(const Entry& other) const {
+	return score < other.score || (score == other.score && order < other.order);
+}
+
+}
\ No newline at end of file
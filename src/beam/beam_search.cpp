@@ -3,29 +3,473 @@
  * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
  */
 
-#include <queue> //A priority queue to track the most optimal solutions in the beam search.
+#include <algorithm> //For std::max.
+#include <chrono> //To measure the time spent at each depth.
+#include <deque> //To go through the convex polygons of an earlier layout.
+#include <cmath> //To compute the directions to place convex polygons from.
+#include <limits> //To check whether coordinates are integers.
+#include <thread> //To expand the beam in parallel.
+#include <unordered_map> //To group convex polygons by their shape.
+#include <utility> //To move the placed convex polygons into the candidates.
 
+#include "beam/beam.hpp" //To track the most optimal solutions in the beam search.
 #include "beam/beam_search.hpp" //The definitions we're implementing here.
+#include "beam/candidate_arena.hpp" //To store the candidates of the search.
 #include "beam/packing_candidate.hpp" //To create and track candidates of solutions that we'd like to explore.
+#include "beam/search_budget.hpp" //To stop searching when the time or evaluations run out.
+#include "bounding_box.hpp" //To find the centre and size of convex polygons.
+#include "layout.hpp" //To continue packing from an earlier layout.
+#include "no_fit_polygon.hpp" //To find where convex polygons touch the packing.
+#include "no_fit_polygon_cache.hpp" //To reuse no-fit polygons of the same shapes.
+#include "pack_statistics.hpp" //To report what the search spent its time on.
+#include "point2.hpp" //To compute placements of convex polygons.
+#include "profiling.hpp" //To trace the time spent at each depth.
+#include "scene.hpp" //To get the settings for the search.
+#include "spatial_index.hpp" //To quickly find collisions with the packed convex polygons.
+#include "statistics.hpp" //To count the candidates.
 
 namespace convack {
 
-void BeamSearch::pack(const Scene& scene, std::vector<ConvexPolygon>& convex_polygons) {
+constexpr size_t BeamSearch::unplaced;
+
+void BeamSearch::pack(const Scene& scene, std::vector<ConvexPolygon>& convex_polygons, CandidateArena& arena, NoFitPolygonCache& cache, PackStatistics& statistics, size_t num_threads, const ProgressCallback& progress, const Cancellation& cancellation) {
+	const Layout nothing_packed; //Start from scratch.
+	std::vector<size_t> rotations; //Not needed if the placements don't get committed.
+	search(scene, nothing_packed, convex_polygons, rotations, arena, cache, statistics, num_threads, progress, cancellation);
+}
+
+void BeamSearch::pack_more(const Scene& scene, std::vector<ConvexPolygon>& convex_polygons, Layout& layout, CandidateArena& arena, NoFitPolygonCache& cache, PackStatistics& statistics, size_t num_threads) {
+	std::vector<size_t> rotations;
+	search(scene, layout, convex_polygons, rotations, arena, cache, statistics, num_threads, ProgressCallback(), Cancellation());
+	for(size_t i = 0; i < convex_polygons.size(); ++i) {
+		if(rotations[i] != unplaced) {
+			layout.add(convex_polygons[i], rotations[i]);
+		}
+	}
+}
+
+void BeamSearch::search(const Scene& scene, const Layout& layout, std::vector<ConvexPolygon>& convex_polygons, std::vector<size_t>& rotations, CandidateArena& arena, NoFitPolygonCache& cache, PackStatistics& statistics, size_t num_threads, const ProgressCallback& progress, const Cancellation& cancellation) {
+	CONVACK_ZONE("BeamSearch::search");
+	rotations.assign(convex_polygons.size(), unplaced);
 	if(convex_polygons.empty()) {
 		return; //Nothing to pack.
 	}
-	//Priority queue with the N best options to consider so far.
-	std::priority_queue<PackingCandidate, std::vector<PackingCandidate>, LowestScore> best_orders;
+	std::chrono::steady_clock::time_point depth_start = std::chrono::steady_clock::now();
+	Statistics::local().clear(); //Only count what happens in this search.
+	arena.reset(); //Clear out the candidates of any previous search, but keep the memory.
+	const size_t beam_width = std::max(scene.get_beam_width(), size_t(1));
+	SearchBudget budget(scene.is_deterministic() ? 0 : scene.get_time_budget(), scene.get_evaluation_budget(), cancellation); //The time depends on the computer, so deterministic packings can't use it.
+
+	//The N best options to consider so far.
+	Beam best_orders(beam_width);
 
-	//Generate the roots of the beam search tree. We'll start by placing all objects initially in the priority queue.
+	const std::vector<size_t> shapes = group_shapes(convex_polygons);
+	const std::vector<std::vector<Variant>> variants = rotate_variants(convex_polygons, scene.get_rotations());
+	const size_t num_rotations = variants[0].size();
+
+	if(num_threads == 0) { //Use all processor cores.
+		num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	num_threads = std::min(num_threads, beam_width); //More threads than candidates in the beam would have nothing to do.
+	//The cells of the index of each packing are as large as the convex polygons on average.
+	coordinate_t total_size = 0;
+	for(const std::vector<Variant>& rotated : variants) {
+		const BoundingBox& bounding_box = rotated[0].convex_polygon.get_bounding_box();
+		if(!bounding_box.empty()) {
+			total_size += std::max(bounding_box.maximum.x - bounding_box.minimum.x, bounding_box.maximum.y - bounding_box.minimum.y);
+		}
+	}
+	std::vector<Scratch> thread_scratch(num_threads, Scratch(total_size / static_cast<coordinate_t>(convex_polygons.size())));
+
+	//Generate the roots of the beam search tree. We'll start by placing all objects initially in the beam.
 	//This is a starting point for what we want to search from.
-	for(ConvexPolygon& convex_polygon : convex_polygons) {
-		best_orders.emplace(&convex_polygons, convex_polygon, nullptr);
+	if(!layout.empty()) {
+		//Continuing from an earlier layout, the roots are placed against that layout, like the children of a candidate that packed it.
+		PackingCandidate* base = arena.create(&convex_polygons, layout.get_convex_hull(), layout.get_covered_area());
+		expand(scene, layout, base, 0, convex_polygons, shapes, variants, arena, cache, thread_scratch[0], best_orders);
+		arena.release(base); //Stays alive as the parent of the roots.
+	}
+	for(size_t i = 0; i < convex_polygons.size() && layout.empty(); ++i) {
+		if(shapes[i] != i) {
+			continue; //Starting with a copy gives the same packing as starting with the first of that shape.
+		}
+		for(size_t rotation = 0; rotation < num_rotations; ++rotation) {
+			ConvexPolygon placed(std::vector<Point2>{});
+			if(!place_root(scene, cache, variants[i][rotation].convex_polygon, rotation, placed)) {
+				continue; //Doesn't fit in the container at all in this rotation.
+			}
+			const area_t area = variants[i][rotation].area;
+			PackingCandidate* rejected = best_orders.insert(arena.create(&convex_polygons, i, placed, nullptr, placed, rotation, area, area, 0.0), i * num_rotations + rotation); //A single convex polygon is its own convex hull, so it scores perfectly.
+			if(rejected) {
+				arena.release(rejected);
+			}
+		}
+	}
+
+	std::vector<PackingCandidate*> beam = best_orders.take(); //The candidates that survived the last depth of the search, best first.
+	if(beam.empty()) { //Not a single convex polygon fits in the container.
+		Statistics::collect(statistics);
+		return;
+	}
+	std::vector<Beam> thread_beams(num_threads, Beam(beam_width)); //The best children found by each thread.
+	std::vector<PackingCandidate*> rejected; //Children that didn't make it into the beam while merging.
+	record_depth_time(depth_start, statistics);
+	report_progress(progress, beam[0], convex_polygons.size());
+	while(beam[0]->get_depth() < convex_polygons.size()) {
+		CONVACK_ZONE("BeamSearch depth");
+		if(budget.exhausted()) {
+			break;
+		}
+
+		expand_beam(scene, layout, beam, convex_polygons, shapes, variants, arena, cache, budget, thread_beams, thread_scratch, statistics);
+		for(Beam& thread_beam : thread_beams) {
+			best_orders.merge(thread_beam, rejected);
+		}
+		for(PackingCandidate* candidate : rejected) {
+			arena.release(candidate);
+		}
+		rejected.clear();
+		if(best_orders.empty()) { //The budget ran out before any candidate was expanded, or nothing fits in the container any more. Continue from the previous depth.
+			break;
+		}
+		//The candidates of the previous depth are only necessary if they are the parent of a survivor. The arena keeps track of that.
+		for(PackingCandidate* candidate : beam) {
+			arena.release(candidate);
+		}
+		beam = best_orders.take();
+		record_depth_time(depth_start, statistics);
+		report_progress(progress, beam[0], convex_polygons.size());
+	}
+	if(budget.cancelled()) {
+		Statistics::collect(statistics);
+		return; //Nobody is waiting for the result any more.
+	}
+
+	//If the budget ran out, complete the best candidate so far by adding the best convex polygon at a time.
+	PackingCandidate* best = beam[0];
+	statistics.budget_exhausted = best->get_depth() < convex_polygons.size() && budget.exhausted();
+	while(best->get_depth() < convex_polygons.size()) {
+		CONVACK_ZONE("BeamSearch greedy depth");
+		if(budget.cancelled()) { //Completing a big packing greedily may take a while too.
+			Statistics::collect(statistics);
+			return;
+		}
+		Beam greedy(1);
+		expand(scene, layout, best, 0, convex_polygons, shapes, variants, arena, cache, thread_scratch[0], greedy);
+		if(greedy.empty()) {
+			break; //None of the remaining convex polygons fit in the container.
+		}
+		arena.release(best); //Stays alive as the parent of the child.
+		best = greedy.take()[0];
+		record_depth_time(depth_start, statistics);
+		report_progress(progress, best, convex_polygons.size());
+	}
+	Statistics::collect(statistics); //Whatever the current thread counted outside of expanding the beam.
+
+	//The best candidate is at the front of the beam. Store its packing in the output.
+	for(const PackingCandidate* candidate = best; candidate && candidate->get_depth() > 0; candidate = candidate->get_parent()) { //The candidate at depth 0 is the earlier layout, which doesn't move.
+		convex_polygons[candidate->get_pack_here_index()] = candidate->get_pack_here();
+		rotations[candidate->get_pack_here_index()] = candidate->get_pack_here_rotation();
+	}
+}
+
+void BeamSearch::record_depth_time(std::chrono::steady_clock::time_point& depth_start, PackStatistics& statistics) {
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	statistics.depth_times.push_back(std::chrono::duration<double>(now - depth_start).count());
+	depth_start = now;
+}
+
+void BeamSearch::report_progress(const ProgressCallback& progress, const PackingCandidate* best, const size_t num_convex_polygons) {
+	if(progress) {
+		progress({best->get_depth(), num_convex_polygons, best->get_score()});
 	}
 }
 
-bool BeamSearch::LowestScore::operator ()(const PackingCandidate& a, const PackingCandidate& b) {
-	return a.get_score() > b.get_score();
+std::vector<size_t> BeamSearch::group_shapes(const std::vector<ConvexPolygon>& convex_polygons) {
+	std::vector<size_t> shapes(convex_polygons.size());
+	std::unordered_map<size_t, std::vector<size_t>> by_hash; //For each hash, the first convex polygon of each shape with that hash.
+	for(size_t i = 0; i < convex_polygons.size(); ++i) {
+		std::vector<size_t>& candidates = by_hash[convex_polygons[i].shape_hash()];
+		shapes[i] = i;
+		for(const size_t candidate : candidates) {
+			if(convex_polygons[candidate].same_shape(convex_polygons[i])) {
+				shapes[i] = candidate;
+				break;
+			}
+		}
+		if(shapes[i] == i) { //A new shape.
+			candidates.push_back(i);
+		}
+	}
+	return shapes;
+}
+
+std::vector<std::vector<BeamSearch::Variant>> BeamSearch::rotate_variants(const std::vector<ConvexPolygon>& convex_polygons, const std::vector<double>& rotations) {
+	const std::vector<double> angles = rotations.empty() ? std::vector<double>({0}) : rotations;
+	std::vector<std::vector<Variant>> variants(convex_polygons.size());
+	for(size_t i = 0; i < convex_polygons.size(); ++i) {
+		variants[i].reserve(angles.size());
+		for(const double angle : angles) {
+			ConvexPolygon rotated(convex_polygons[i]);
+			if(angle != 0) { //Rotating over 0 would only add rounding errors.
+				rotated.rotate(angle);
+			}
+			rotated.set_lazy(false); //The threads read the variants and the children placed from them at the same time. Lazy vertices would get filled in concurrently.
+			const area_t area = rotated.area();
+			variants[i].push_back({rotated, area});
+		}
+	}
+	return variants;
+}
+
+BeamSearch::Scratch::Scratch(const coordinate_t cell_size) :
+		packing_index(cell_size),
+		hull_core(std::vector<Point2>{}),
+		placed(std::vector<Point2>{}),
+		core_hull(std::vector<Point2>{}),
+		convex_hull(std::vector<Point2>{}) {}
+
+void BeamSearch::expand_beam(const Scene& scene, const Layout& layout, const std::vector<PackingCandidate*>& beam, const std::vector<ConvexPolygon>& convex_polygons, const std::vector<size_t>& shapes, const std::vector<std::vector<Variant>>& variants, CandidateArena& arena, NoFitPolygonCache& cache, SearchBudget& budget, std::vector<Beam>& thread_beams, std::vector<Scratch>& thread_scratch, PackStatistics& statistics) {
+	const size_t num_threads = std::min(thread_beams.size(), beam.size());
+	const bool deterministic = scene.is_deterministic();
+	//Each thread expands a contiguous part of the beam.
+	const auto expand_range = [&](const size_t thread) {
+		const size_t begin = beam.size() * thread / num_threads;
+		const size_t end = beam.size() * (thread + 1) / num_threads;
+		for(size_t i = begin; i < end && (deterministic ? !budget.cancelled() : !budget.exhausted()); ++i) { //Which candidates were expanded when the budget runs out depends on the threads, so deterministic packings expand all of them.
+			budget.spend(expand(scene, layout, beam[i], i, convex_polygons, shapes, variants, arena, cache, thread_scratch[thread], thread_beams[thread]));
+		}
+		Statistics::collect(statistics);
+	};
+
+	std::vector<std::thread> workers;
+	workers.reserve(num_threads - 1);
+	for(size_t thread = 1; thread < num_threads; ++thread) {
+		workers.emplace_back(expand_range, thread);
+	}
+	expand_range(0); //The current thread takes the first part of the beam.
+	for(std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+size_t BeamSearch::expand(const Scene& scene, const Layout& layout, PackingCandidate* candidate, const size_t candidate_index, const std::vector<ConvexPolygon>& convex_polygons, const std::vector<size_t>& shapes, const std::vector<std::vector<Variant>>& variants, CandidateArena& arena, NoFitPolygonCache& cache, Scratch& scratch, Beam& beam) {
+	CONVACK_ZONE("BeamSearch::expand");
+	//Find which convex polygons are already packed in this candidate.
+	scratch.packed.assign(convex_polygons.size(), false);
+	scratch.packing.clear();
+	scratch.packing_rotations.clear();
+	scratch.packing_shapes.clear();
+	scratch.packing_index.clear();
+	for(const PackingCandidate* ancestor = candidate; ancestor && ancestor->get_depth() > 0; ancestor = ancestor->get_parent()) { //The earlier layout is indexed already.
+		scratch.packed[ancestor->get_pack_here_index()] = true;
+		scratch.packing.push_back(&ancestor->get_pack_here());
+		scratch.packing_rotations.push_back(ancestor->get_pack_here_rotation());
+		scratch.packing_shapes.push_back(&variants[ancestor->get_pack_here_index()][ancestor->get_pack_here_rotation()].convex_polygon);
+		//Index the packing so that checking the placement of new convex polygons only needs to test for collisions with the convex polygons nearby.
+		scratch.packing_index.insert(scratch.packing.back());
+	}
+
+	const ConvexPolygon& container = scene.get_container();
+	const bool has_container = !container.get_vertices().empty();
+	const std::vector<ConvexPolygon>& obstacles = scene.get_obstacles();
+	coordinate_t packing_radius;
+	const Point2 packing_centre = bounding_centre(candidate->get_convex_hull(), packing_radius);
+	candidate->hull_core(scratch.hull_core, scratch.core_extremes); //To bound the scores of the children cheaply.
+	double direction_x[placement_directions];
+	double direction_y[placement_directions];
+	compute_directions(direction_x, direction_y);
+
+	const size_t num_rotations = variants[0].size();
+	size_t evaluations = 0;
+	scratch.shape_placed.assign(convex_polygons.size(), false); //Whether a copy of each shape was already placed, by the index of the first of that shape.
+	for(size_t i = 0; i < convex_polygons.size(); ++i) {
+		if(scratch.packed[i] || scratch.shape_placed[shapes[i]]) {
+			continue; //Another copy of the same shape would give the same children.
+		}
+		scratch.shape_placed[shapes[i]] = true;
+		for(size_t rotation = 0; rotation < num_rotations; ++rotation) {
+			const Variant& variant = variants[i][rotation];
+			//Where the new convex polygon can go with respect to each packed convex polygon and each obstacle.
+			scratch.no_fit_polygons.clear();
+			scratch.no_fit_translations.clear();
+			for(size_t j = 0; j < scratch.packing.size(); ++j) {
+				Point2 translation(0, 0);
+				scratch.no_fit_polygons.push_back(cache.get(*scratch.packing[j], *scratch.packing_shapes[j], scratch.packing_rotations[j], variant.convex_polygon, rotation, translation));
+				scratch.no_fit_translations.push_back(translation);
+			}
+			for(const ConvexPolygon& obstacle : obstacles) {
+				Point2 translation(0, 0);
+				scratch.no_fit_polygons.push_back(cache.get(obstacle, obstacle_rotation, variant.convex_polygon, rotation, translation));
+				scratch.no_fit_translations.push_back(translation);
+			}
+			for(size_t direction = 0; direction < placement_directions; ++direction) {
+				if(!place(packing_centre, packing_radius, scene.get_obstacle_index(), layout, cache, variant.convex_polygon, rotation, direction_x[direction], direction_y[direction], scratch)) {
+					continue; //Couldn't be moved out of the way of everything else in this direction.
+				}
+				CONVACK_COUNT(candidates_generated);
+				++evaluations;
+				if(has_container && !container.contains(scratch.placed)) {
+					continue; //Infeasible, so don't even score it.
+				}
+				const size_t order = ((candidate_index * convex_polygons.size() + i) * num_rotations + rotation) * placement_directions + direction; //Only depends on the position in the search tree, not on which thread found it.
+				//Most children don't make it into a wide beam. Bound their score first, so that those don't need their convex hull merged.
+				if(!beam.accepts(PackingCandidate::score_lower_bound(candidate, scratch.hull_core, scratch.placed, variant.area, scratch.core_hull), order)) {
+					CONVACK_COUNT(candidates_pruned);
+					continue;
+				}
+				//Score the child before constructing it, so that children that wouldn't make it into the beam don't need to be stored.
+				PackingCandidate::merge_hull(candidate, scratch.placed, scratch.convex_hull);
+				const area_t covered_area = variant.area + candidate->get_covered_area();
+				const area_t used_area = scratch.convex_hull.area();
+				const double score = PackingCandidate::compute_score(covered_area, used_area);
+				if(!beam.accepts(score, order)) {
+					CONVACK_COUNT(candidates_pruned);
+					continue;
+				}
+				//The child keeps these, so the next placement allocates new ones.
+				PackingCandidate* rejected = beam.insert(arena.create(&convex_polygons, i, std::move(scratch.placed), candidate, std::move(scratch.convex_hull), rotation, covered_area, used_area, score), order);
+				if(rejected) {
+					arena.release(rejected);
+				}
+			}
+		}
+	}
+	return evaluations;
+}
+
+bool BeamSearch::place_root(const Scene& scene, NoFitPolygonCache& cache, const ConvexPolygon& convex_polygon, const size_t rotation, ConvexPolygon& placed) {
+	const ConvexPolygon& container = scene.get_container();
+	const bool has_container = !container.get_vertices().empty();
+	const std::vector<ConvexPolygon>& obstacles = scene.get_obstacles();
+	if(!has_container && obstacles.empty()) {
+		placed = convex_polygon; //Nothing to fit in or to avoid, so it can stay where it is.
+		return true;
+	}
+
+	Scratch scratch(1); //Nothing is packed yet, so its packing index stays empty.
+	for(const ConvexPolygon& obstacle : obstacles) {
+		Point2 translation(0, 0);
+		scratch.no_fit_polygons.push_back(cache.get(obstacle, obstacle_rotation, convex_polygon, rotation, translation));
+		scratch.no_fit_translations.push_back(translation);
+	}
+	//Start the packing in the centre of the container. Without a container, only move the convex polygon out of the way of the obstacles.
+	coordinate_t target_radius;
+	const Point2 target_centre = bounding_centre(has_container ? container : convex_polygon, target_radius);
+	double direction_x[placement_directions];
+	double direction_y[placement_directions];
+	compute_directions(direction_x, direction_y);
+	const Layout no_layout; //Roots are only placed when there is no earlier layout.
+	for(size_t direction = 0; direction < placement_directions; ++direction) {
+		if(!place(target_centre, target_radius, scene.get_obstacle_index(), no_layout, cache, convex_polygon, rotation, direction_x[direction], direction_y[direction], scratch)) {
+			continue; //Still collides with an obstacle in this direction.
+		}
+		if(!has_container || container.contains(scratch.placed)) {
+			placed = std::move(scratch.placed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void BeamSearch::compute_directions(double* direction_x, double* direction_y) {
+	const double pi = std::acos(-1);
+	for(size_t direction = 0; direction < placement_directions; ++direction) {
+		const double angle = pi * 2 / placement_directions * direction;
+		direction_x[direction] = std::cos(angle);
+		direction_y[direction] = std::sin(angle);
+	}
+}
+
+bool BeamSearch::place(const Point2& packing_centre, const coordinate_t packing_radius, const SpatialIndex& obstacle_index, const Layout& layout, NoFitPolygonCache& cache, const ConvexPolygon& convex_polygon, const size_t rotation, const double direction_x, const double direction_y, Scratch& scratch) {
+	coordinate_t polygon_radius;
+	const Point2 polygon_centre = bounding_centre(convex_polygon, polygon_radius);
+
+	//Coming in from far away along the line through the centre of the packing, the convex polygon first touches a packed convex polygon or obstacle where the line leaves its no-fit polygon.
+	//Each no-fit polygon is convex, so beyond the furthest of those exits, the convex polygon can't overlap with any of them.
+	const Point2 origin = packing_centre - polygon_centre; //The translation that puts the centre of the convex polygon on the centre of the packing.
+	double distance = 0; //If the line doesn't go through any no-fit polygon, the convex polygon fits right in the centre.
+	for(size_t i = 0; i < scratch.no_fit_polygons.size(); ++i) {
+		double exit;
+		if(scratch.no_fit_polygons[i]->exit_distance(origin - scratch.no_fit_translations[i], direction_x, direction_y, exit)) { //Translating the line the other way is the same as translating the no-fit polygon.
+			distance = std::max(distance, exit);
+		}
+	}
+	if(!layout.empty()) {
+		//The layout is within the bounding circle of the packing. Once the bounding circle of the convex polygon is moved out of that, it can't touch the layout any more.
+		distance = layout_exit_distance(layout, cache, convex_polygon, rotation, origin, static_cast<double>(packing_radius) + polygon_radius, direction_x, direction_y, distance, scratch.layout_found, scratch.layout_previous_found);
+	}
+
+	//Due to rounding errors, the convex polygon may still overlap very slightly with the one it touches. Then move it out a bit further.
+	ConvexPolygon& placed = scratch.placed;
+	double clearance = (static_cast<double>(packing_radius) + polygon_radius) * placement_clearance;
+	if(std::numeric_limits<coordinate_t>::is_integer) {
+		clearance = std::max(clearance, 1.0); //Smaller steps would round away.
+	}
+	for(size_t attempt = 0; attempt < placement_attempts; ++attempt) {
+		placed = convex_polygon; //Reuses the memory of the previous attempt.
+		placed.translate(to_coordinate(origin.x + direction_x * distance), to_coordinate(origin.y + direction_y * distance));
+		if(!scratch.packing_index.collides(placed) && !obstacle_index.collides(placed) && !layout.get_index().collides(placed)) {
+			return true;
+		}
+		distance += clearance;
+		clearance *= 2;
+	}
+	return false; //Something is wrong with the no-fit polygons. Don't risk an overlapping packing.
+}
+
+double BeamSearch::layout_exit_distance(const Layout& layout, NoFitPolygonCache& cache, const ConvexPolygon& convex_polygon, const size_t rotation, const Point2& origin, const double reach, const double direction_x, const double direction_y, double distance, std::vector<size_t>& found, std::vector<size_t>& previous_found) {
+	const BoundingBox& bounding_box = convex_polygon.get_bounding_box();
+	if(bounding_box.empty() || reach <= 0) {
+		return distance; //Can't touch anything.
+	}
+	const std::deque<ConvexPolygon>& layout_polygons = layout.get_convex_polygons();
+	const std::vector<size_t>& layout_rotations = layout.get_rotations();
+
+	//Sweep the bounding box of the convex polygon along the line in steps about as long as the convex polygon, so that the swept boxes stay close to the line.
+	const double size = static_cast<double>(std::max(bounding_box.maximum.x - bounding_box.minimum.x, bounding_box.maximum.y - bounding_box.minimum.y));
+	const double step = std::max(size, reach / max_sweep_steps);
+	const size_t num_steps = static_cast<size_t>(std::ceil(reach / step));
+	previous_found.clear(); //Convex polygons of the layout that the previous step already went through.
+	for(size_t i = num_steps; i-- > 0;) { //From far away inwards, since the furthest convex polygons decide where it ends up.
+		const double start = step * i;
+		const double end = std::min(step * (i + 1), reach);
+		if(distance >= end) {
+			break; //Everything further in can only be touched closer to the centre, and would be left behind at this distance.
+		}
+		BoundingBox swept;
+		for(const double along : {start, end}) {
+			const Point2 offset = origin + Point2(to_coordinate(direction_x * along), to_coordinate(direction_y * along));
+			swept.include(bounding_box.minimum + offset);
+			swept.include(bounding_box.maximum + offset);
+		}
+		found.clear();
+		layout.get_index().query(swept, found);
+		for(const size_t j : found) {
+			if(std::binary_search(previous_found.begin(), previous_found.end(), j)) {
+				continue; //Consecutive steps overlap, so this one is already taken into account.
+			}
+			Point2 translation(0, 0);
+			const std::shared_ptr<const NoFitPolygon> no_fit_polygon = cache.get(layout_polygons[j], layout_rotations[j], convex_polygon, rotation, translation);
+			double exit;
+			if(no_fit_polygon->exit_distance(origin - translation, direction_x, direction_y, exit)) {
+				distance = std::max(distance, exit);
+			}
+		}
+		std::swap(found, previous_found);
+	}
+	return distance;
+}
+
+Point2 BeamSearch::bounding_centre(const ConvexPolygon& convex_polygon, coordinate_t& radius) {
+	const BoundingBox& bounding_box = convex_polygon.get_bounding_box();
+	if(bounding_box.empty()) {
+		radius = 0;
+		return Point2(0, 0);
+	}
+	const Point2 centre = bounding_box.centre();
+	radius = to_coordinate(std::sqrt(static_cast<double>((bounding_box.maximum - centre).magnitude2())));
+	return centre;
 }
 
 }
\ No newline at end of file
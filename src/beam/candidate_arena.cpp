@@ -0,0 +1,89 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include "beam/candidate_arena.hpp" //The definitions we're implementing here.
+#include "statistics.hpp" //To count how many blocks are allocated.
+
+namespace convack {
+
+CandidateArena::CandidateArena(const size_t block_size) :
+		block_size(block_size > 0 ? block_size : 1),
+		used_in_block(0),
+		current_block(0),
+		num_alive(0) {
+}
+
+CandidateArena::~CandidateArena() {
+	reset(); //Destroy all remaining candidates. The blocks are freed by their unique_ptrs.
+}
+
+void CandidateArena::release(PackingCandidate* candidate) {
+	std::lock_guard<std::mutex> lock(mutex);
+	Slot* slot = slot_of(candidate);
+	slot->released = true;
+	//Destroy this candidate and any parents that become unnecessary because of it.
+	while(slot && slot->released && slot->num_children == 0) {
+		PackingCandidate* parent = reinterpret_cast<PackingCandidate*>(&slot->storage)->get_parent();
+		destroy(slot);
+		if(!parent) {
+			break;
+		}
+		slot = slot_of(parent);
+		slot->num_children--;
+	}
+}
+
+void CandidateArena::reset() {
+	for(size_t block = 0; block < blocks.size() && block <= current_block; ++block) {
+		const size_t used = (block == current_block) ? used_in_block : block_size;
+		for(size_t i = 0; i < used; ++i) {
+			if(blocks[block][i].alive) {
+				reinterpret_cast<PackingCandidate*>(&blocks[block][i].storage)->~PackingCandidate();
+				blocks[block][i].alive = false;
+			}
+		}
+	}
+	free_slots.clear();
+	current_block = 0;
+	used_in_block = 0;
+	num_alive = 0;
+}
+
+size_t CandidateArena::size() const {
+	return num_alive;
+}
+
+CandidateArena::Slot* CandidateArena::allocate_slot() {
+	if(!free_slots.empty()) {
+		Slot* slot = free_slots.back();
+		free_slots.pop_back();
+		return slot;
+	}
+	if(used_in_block == block_size) { //Current block is full. Go to the next one.
+		++current_block;
+		used_in_block = 0;
+	}
+	if(current_block >= blocks.size()) { //We've never needed this many blocks before.
+		CONVACK_COUNT(allocations);
+		blocks.emplace_back(new Slot[block_size]);
+		for(size_t i = 0; i < block_size; ++i) {
+			blocks.back()[i].alive = false;
+		}
+	}
+	return &blocks[current_block][used_in_block++];
+}
+
+void CandidateArena::destroy(Slot* slot) {
+	reinterpret_cast<PackingCandidate*>(&slot->storage)->~PackingCandidate();
+	slot->alive = false;
+	free_slots.push_back(slot);
+	--num_alive;
+}
+
+CandidateArena::Slot* CandidateArena::slot_of(PackingCandidate* candidate) {
+	return reinterpret_cast<Slot*>(candidate); //The storage is the first member of the slot, so their addresses coincide.
+}
+
+}
\ No newline at end of file
@@ -2,46 +2,174 @@
  * Library to pack convex polygons into arbitrary shapes.
  * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
  */
-#include <iostream> //DEBUG!
+
+#include <algorithm> //For std::max.
+#include <cmath> //To compute the directions of the core of a convex hull.
+#include <limits> //To start searching for the extreme vertex in a direction.
+#include <utility> //To move the convex polygons into the candidate.
+
 #include "beam/packing_candidate.hpp" //The definitions we're implementing here.
+#include "point2.hpp" //To find the extreme vertices of the convex hull.
 #include "convex_polygon.hpp" //To store some convex polygons and perform operations on them.
+#include "profiling.hpp" //To trace the time spent computing scores.
+#include "statistics.hpp" //To count how many scores are computed.
 
 namespace convack {
 
-PackingCandidate::PackingCandidate(const std::vector<ConvexPolygon>* packed_objects, const ConvexPolygon& pack_here, PackingCandidate* parent) :
+PackingCandidate::PackingCandidate(const std::vector<ConvexPolygon>* packed_objects, const size_t pack_here_index, const ConvexPolygon& pack_here, PackingCandidate* parent) :
 		packed_objects(packed_objects),
 		pack_here(pack_here),
-		parent(parent) {
-	score = compute_score();
+		pack_here_index(pack_here_index),
+		pack_here_rotation(0),
+		parent(parent),
+		depth(parent ? parent->depth + 1 : 1),
+		convex_hull(merge_hull(parent, pack_here)),
+		covered_area(pack_here.area() + (parent ? parent->covered_area : 0)),
+		used_area(convex_hull.area()) {
+	score = compute_score(covered_area, used_area);
+}
+
+PackingCandidate::PackingCandidate(const std::vector<ConvexPolygon>* packed_objects, const size_t pack_here_index, ConvexPolygon pack_here, PackingCandidate* parent, ConvexPolygon convex_hull, const size_t pack_here_rotation, const area_t covered_area, const area_t used_area, const double score) :
+		packed_objects(packed_objects),
+		pack_here(std::move(pack_here)),
+		pack_here_index(pack_here_index),
+		pack_here_rotation(pack_here_rotation),
+		parent(parent),
+		depth(parent ? parent->depth + 1 : 1),
+		convex_hull(std::move(convex_hull)),
+		covered_area(covered_area),
+		used_area(used_area),
+		score(score) {}
+
+PackingCandidate::PackingCandidate(const std::vector<ConvexPolygon>* packed_objects, ConvexPolygon convex_hull, const area_t covered_area) :
+		packed_objects(packed_objects),
+		pack_here(std::vector<Point2>()),
+		pack_here_index(0),
+		pack_here_rotation(0),
+		parent(nullptr),
+		depth(0),
+		convex_hull(std::move(convex_hull)),
+		covered_area(covered_area),
+		used_area(this->convex_hull.area()) {
+	score = compute_score(covered_area, used_area);
+}
+
+ConvexPolygon PackingCandidate::merge_hull(const PackingCandidate* parent, const ConvexPolygon& pack_here) {
+	if(!parent) {
+		return pack_here;
+	}
+	return ConvexPolygon::convex_hull(parent->convex_hull, pack_here); //Only merge the new polygon into the hull of the parent.
+}
+
+void PackingCandidate::merge_hull(const PackingCandidate* parent, const ConvexPolygon& pack_here, ConvexPolygon& convex_hull) {
+	if(!parent) {
+		convex_hull = pack_here;
+		return;
+	}
+	ConvexPolygon::convex_hull(parent->convex_hull, pack_here, convex_hull);
 }
 
 double PackingCandidate::get_score() const {
 	return score;
 }
 
-double PackingCandidate::compute_score() const {
-	//Score is the ratio of area that is "lost" when packing objects this way.
-	//The "lost" area is the part that is in the convex hull around all objects, but not covered by an object itself.
+const ConvexPolygon& PackingCandidate::get_convex_hull() const {
+	return convex_hull;
+}
+
+area_t PackingCandidate::get_covered_area() const {
+	return covered_area;
+}
+
+area_t PackingCandidate::get_used_area() const {
+	return used_area;
+}
+
+const ConvexPolygon& PackingCandidate::get_pack_here() const {
+	return pack_here;
+}
+
+size_t PackingCandidate::get_pack_here_index() const {
+	return pack_here_index;
+}
+
+size_t PackingCandidate::get_pack_here_rotation() const {
+	return pack_here_rotation;
+}
+
+PackingCandidate* PackingCandidate::get_parent() const {
+	return parent;
+}
+
+size_t PackingCandidate::get_depth() const {
+	return depth;
+}
+
+double PackingCandidate::score_lower_bound(const PackingCandidate* parent, const ConvexPolygon& hull_core, const ConvexPolygon& pack_here, const area_t pack_here_area) {
+	ConvexPolygon core_hull(std::vector<Point2>{});
+	return score_lower_bound(parent, hull_core, pack_here, pack_here_area, core_hull);
+}
 
-	//Serialise to a vector, because we need to provide a vector for the ConvexPolygon::convex_hull() call below.
-	std::vector<ConvexPolygon> packed_so_far;
-	const PackingCandidate* candidate = this;
-	while(candidate) {
-		packed_so_far.push_back(candidate->pack_here); //TODO: Makes an unnecessary copy!
-		candidate = candidate->parent;
+double PackingCandidate::score_lower_bound(const PackingCandidate* parent, const ConvexPolygon& hull_core, const ConvexPolygon& pack_here, const area_t pack_here_area, ConvexPolygon& core_hull) {
+	if(!parent) {
+		return 0; //A single convex polygon is its own convex hull, so it can score perfectly.
 	}
+	//The core is inside the convex hull of the parent, so the convex hull around the core and the new convex polygon is inside the new convex hull.
+	ConvexPolygon::convex_hull(hull_core, pack_here, core_hull);
+	const area_t core_area = core_hull.area();
+	const double used_area = static_cast<double>(std::max(core_area, parent->used_area)) * (1.0 - bound_tolerance);
+	if(used_area <= 0) {
+		return 0; //Prevent division by 0.
+	}
+	return 1.0 - static_cast<double>(parent->covered_area + pack_here_area) / used_area;
+}
+
+ConvexPolygon PackingCandidate::hull_core() const {
+	ConvexPolygon core(std::vector<Point2>{});
+	std::vector<Point2> extremes;
+	hull_core(core, extremes);
+	return core;
+}
 
-	area_t covered_area = 0; //Original area.
-	for(const ConvexPolygon& convex_polygon : packed_so_far) {
-		covered_area += convex_polygon.area();
+void PackingCandidate::hull_core(ConvexPolygon& core, std::vector<Point2>& extremes) const {
+	const std::vector<Point2>& vertices = convex_hull.get_vertices();
+	if(vertices.size() <= core_directions) {
+		core = convex_hull; //Already small enough.
+		return;
+	}
+	const double pi = std::acos(-1);
+	extremes.clear();
+	for(size_t direction = 0; direction < core_directions; ++direction) {
+		const double angle = pi * 2 / core_directions * direction;
+		const double direction_x = std::cos(angle);
+		const double direction_y = std::sin(angle);
+		size_t extreme = 0;
+		double extreme_distance = -std::numeric_limits<double>::infinity();
+		for(size_t i = 0; i < vertices.size(); ++i) {
+			const double distance = vertices[i].x * direction_x + vertices[i].y * direction_y;
+			if(distance > extreme_distance) {
+				extreme_distance = distance;
+				extreme = i;
+			}
+		}
+		if(extremes.empty() || (extremes.back() != vertices[extreme] && extremes.front() != vertices[extreme])) { //Sharp corners are the extreme in multiple directions.
+			extremes.push_back(vertices[extreme]);
+		}
 	}
+	ConvexPolygon::convex_hull(extremes, core); //The extremes are vertices of a convex polygon in counter-clockwise order, so this only copies them into the core.
+}
 
-	area_t used_area = ConvexPolygon::convex_hull(packed_so_far).area(); //Will ALWAYS be bigger or equally big as the covered area.
+double PackingCandidate::compute_score(const area_t covered_area, const area_t used_area) {
+	CONVACK_ZONE("PackingCandidate::compute_score");
+	CONVACK_COUNT(score_evaluations);
+	//Score is the ratio of area that is "lost" when packing objects this way.
+	//The "lost" area is the part that is in the convex hull around all objects, but not covered by an object itself.
+	//The used area will ALWAYS be bigger or equally big as the covered area.
 	if(used_area <= 0) {
 		return 0; //Prevent division by 0.
 	}
 
-	return 1.0 - (covered_area / used_area);
+	return 1.0 - (static_cast<double>(covered_area) / used_area); //Also with integer areas, this is a fraction.
 }
 
 }
\ No newline at end of file
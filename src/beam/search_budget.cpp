@@ -0,0 +1,45 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include "beam/search_budget.hpp" //The definitions we're implementing here.
+
+namespace convack {
+
+SearchBudget::SearchBudget(const double time_budget, const size_t evaluation_budget, const Cancellation& cancellation) :
+		has_deadline(time_budget > 0),
+		deadline(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(time_budget > 0 ? time_budget : 0))),
+		evaluation_budget(evaluation_budget),
+		cancellation(cancellation),
+		evaluations(0),
+		is_exhausted(false) {
+}
+
+void SearchBudget::spend(const size_t evaluations) {
+	const size_t total = this->evaluations.fetch_add(evaluations) + evaluations;
+	if(evaluation_budget > 0 && total >= evaluation_budget) {
+		is_exhausted = true;
+	}
+}
+
+bool SearchBudget::exhausted() {
+	if(is_exhausted) {
+		return true;
+	}
+	if(cancellation.is_cancelled()) {
+		is_exhausted = true;
+		return true;
+	}
+	if(has_deadline && std::chrono::steady_clock::now() >= deadline) {
+		is_exhausted = true;
+		return true;
+	}
+	return false;
+}
+
+bool SearchBudget::cancelled() const {
+	return cancellation.is_cancelled();
+}
+
+}
\ No newline at end of file
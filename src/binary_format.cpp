@@ -0,0 +1,111 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <cstring> //To copy the data into the buffer and compare the magic characters.
+#include <type_traits> //To check that points can be stored as they are in memory.
+
+#include "binary_format.hpp" //The definitions we're implementing here.
+#include "point2.hpp" //To store the vertices.
+
+namespace convack {
+
+//The vertices are stored exactly as they are in memory, so they can be viewed without converting them.
+static_assert(std::is_standard_layout<Point2>::value && std::is_trivially_copyable<Point2>::value, "Points must be stored as plain data.");
+static_assert(sizeof(Point2) == 2 * sizeof(coordinate_t), "Points must not have padding.");
+
+constexpr uint32_t BinaryFormat::version;
+constexpr uint32_t BinaryFormat::byte_order_mark;
+
+ConvexPolygon ConvexPolygonView::to_convex_polygon() const {
+	return ConvexPolygon(std::vector<Point2>(vertices, vertices + num_vertices), transformation);
+}
+
+void BinaryFormat::write(const std::vector<ConvexPolygon>& convex_polygons, std::vector<char>& buffer) {
+	Header header;
+	std::memcpy(header.magic, "CVPK", sizeof(header.magic));
+	header.version = version;
+	header.byte_order = byte_order_mark;
+	header.coordinate_type = coordinate_type();
+	header.num_convex_polygons = convex_polygons.size();
+	header.num_vertices = 0;
+	for(const ConvexPolygon& convex_polygon : convex_polygons) {
+		header.num_vertices += convex_polygon.get_vertices().size();
+	}
+
+	buffer.resize(sizeof(Header) + sizeof(Record) * header.num_convex_polygons + sizeof(Point2) * header.num_vertices);
+	std::memcpy(buffer.data(), &header, sizeof(Header));
+	char* record_position = buffer.data() + sizeof(Header);
+	char* vertex_position = record_position + sizeof(Record) * header.num_convex_polygons;
+	uint64_t first_vertex = 0;
+	for(const ConvexPolygon& convex_polygon : convex_polygons) {
+		const std::vector<Point2>& convex_polygon_vertices = convex_polygon.get_vertices();
+		const Record record = {convex_polygon.uid(), first_vertex, convex_polygon_vertices.size(), convex_polygon.current_transformation().get_data()};
+		std::memcpy(record_position, &record, sizeof(Record));
+		record_position += sizeof(Record);
+		std::memcpy(vertex_position, convex_polygon_vertices.data(), sizeof(Point2) * convex_polygon_vertices.size());
+		vertex_position += sizeof(Point2) * convex_polygon_vertices.size();
+		first_vertex += convex_polygon_vertices.size();
+	}
+}
+
+BinaryFormat::BinaryFormat() : records(nullptr), vertices(nullptr), num_convex_polygons(0) {}
+
+bool BinaryFormat::load(const void* data, const size_t size) {
+	records = nullptr;
+	vertices = nullptr;
+	num_convex_polygons = 0;
+
+	if(reinterpret_cast<uintptr_t>(data) % alignof(Record) != 0 || size < sizeof(Header)) {
+		return false;
+	}
+	const Header& header = *static_cast<const Header*>(data);
+	if(std::memcmp(header.magic, "CVPK", sizeof(header.magic)) != 0 || header.version != version || header.byte_order != byte_order_mark || header.coordinate_type != coordinate_type()) {
+		return false;
+	}
+	//Check the size before multiplying, so that huge counts can't overflow.
+	const size_t body_size = size - sizeof(Header);
+	if(header.num_convex_polygons > body_size / sizeof(Record) || header.num_vertices > (body_size - sizeof(Record) * header.num_convex_polygons) / sizeof(Point2)) {
+		return false;
+	}
+	if(body_size != sizeof(Record) * header.num_convex_polygons + sizeof(Point2) * header.num_vertices) {
+		return false;
+	}
+	const Record* header_records = reinterpret_cast<const Record*>(static_cast<const char*>(data) + sizeof(Header));
+	for(size_t i = 0; i < header.num_convex_polygons; ++i) {
+		const Record& record = header_records[i];
+		if(record.num_vertices > header.num_vertices || record.first_vertex > header.num_vertices - record.num_vertices) {
+			return false; //Vertices out of range.
+		}
+	}
+
+	records = header_records;
+	vertices = reinterpret_cast<const Point2*>(header_records + header.num_convex_polygons);
+	num_convex_polygons = header.num_convex_polygons;
+	return true;
+}
+
+size_t BinaryFormat::size() const {
+	return num_convex_polygons;
+}
+
+ConvexPolygonView BinaryFormat::operator [](const size_t index) const {
+	const Record& record = records[index];
+	return {vertices + record.first_vertex, static_cast<size_t>(record.num_vertices), record.uid, Transformation(record.transformation)};
+}
+
+std::vector<ConvexPolygon> BinaryFormat::to_convex_polygons() const {
+	std::vector<ConvexPolygon> result;
+	result.reserve(num_convex_polygons);
+	for(size_t i = 0; i < num_convex_polygons; ++i) {
+		result.push_back((*this)[i].to_convex_polygon());
+	}
+	return result;
+}
+
+uint32_t BinaryFormat::coordinate_type() {
+	return std::is_integral<coordinate_t>::value ? 1 : 0;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <algorithm> //For std::min and std::max.
+#include <limits> //To construct empty bounding boxes.
+
+#include "bounding_box.hpp" //The definitions we're implementing here.
+
+namespace convack {
+
+/* An empty bounding box has its minimum beyond its maximum. That way, including
+the first point sets both corners to that point, and any overlap or containment
+test fails without needing to check for emptiness separately. */
+BoundingBox::BoundingBox() :
+		minimum(std::numeric_limits<coordinate_t>::max(), std::numeric_limits<coordinate_t>::max()),
+		maximum(std::numeric_limits<coordinate_t>::lowest(), std::numeric_limits<coordinate_t>::lowest()) {
+}
+
+BoundingBox::BoundingBox(const std::vector<Point2>& points) : BoundingBox() {
+	for(const Point2& point : points) {
+		include(point);
+	}
+}
+
+bool BoundingBox::operator ==(const BoundingBox& other) const {
+	if(empty()) {
+		return other.empty(); //All empty bounding boxes are equal.
+	}
+	return minimum == other.minimum && maximum == other.maximum;
+}
+
+bool BoundingBox::operator !=(const BoundingBox& other) const {
+	return !(*this == other);
+}
+
+std::ostream& operator <<(std::ostream& output_stream, const BoundingBox& bounding_box) {
+	if(bounding_box.empty()) {
+		return output_stream << "[empty]";
+	}
+	return output_stream << "[" << bounding_box.minimum << " - " << bounding_box.maximum << "]";
+}
+
+bool BoundingBox::empty() const {
+	return minimum.x > maximum.x;
+}
+
+void BoundingBox::include(const Point2& point) {
+	minimum.x = std::min(minimum.x, point.x);
+	minimum.y = std::min(minimum.y, point.y);
+	maximum.x = std::max(maximum.x, point.x);
+	maximum.y = std::max(maximum.y, point.y);
+}
+
+bool BoundingBox::contains(const Point2& point) const {
+	return point.x > minimum.x && point.x < maximum.x && point.y > minimum.y && point.y < maximum.y;
+}
+
+bool BoundingBox::encloses(const BoundingBox& other) const {
+	if(other.empty()) {
+		return false; //Its inverted corners would pass the comparisons below.
+	}
+	return minimum.x <= other.minimum.x && other.maximum.x <= maximum.x && minimum.y <= other.minimum.y && other.maximum.y <= maximum.y;
+}
+
+bool BoundingBox::overlaps(const BoundingBox& other) const {
+	return minimum.x < other.maximum.x && other.minimum.x < maximum.x && minimum.y < other.maximum.y && other.minimum.y < maximum.y;
+}
+
+Point2 BoundingBox::centre() const {
+	return Point2((minimum.x + maximum.x) / 2, (minimum.y + maximum.y) / 2);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <atomic> //To cancel from a different thread than the one packing.
+
+#include "cancellation.hpp" //The definitions we're implementing here.
+
+namespace convack {
+
+class Cancellation::Impl {
+public:
+	/*!
+	 * Construct the implementation, not cancelled yet.
+	 */
+	Impl() : cancelled(false) {}
+
+	/*!
+	 * Whether the packing is to stop.
+	 */
+	std::atomic<bool> cancelled;
+};
+
+Cancellation::Cancellation() : pimpl(std::make_shared<Impl>()) {}
+
+void Cancellation::cancel() {
+	pimpl->cancelled = true;
+}
+
+bool Cancellation::is_cancelled() const {
+	return pimpl->cancelled;
+}
+
+}
\ No newline at end of file
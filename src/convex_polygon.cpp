@@ -3,10 +3,18 @@
  * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
  */
 
-#include <algorithm> //For min_element.
-
+#include <algorithm> //For min_element and sorting points.
+#include <atomic> //To generate unique identifiers from multiple threads.
+#include <functional> //To hash the shapes of convex polygons.
+#include <limits> //To start searching from the maximum coordinate.
+#include <type_traits> //To fix the number of vertices at compile time for the kernels of small convex polygons.
+#include <utility> //To move vertex lists into convex polygons.
+
+#include "bounding_box.hpp" //To quickly reject collisions between convex polygons that are far apart.
 #include "convex_polygon.hpp" //The definitions of the implementation defined here.
 #include "point2.hpp" //To store the vertices of the convex polygon.
+#include "profiling.hpp" //To trace the time spent in convex hulls and collision checks.
+#include "statistics.hpp" //To count the operations on convex polygons.
 #include "transformation.hpp" //To translate and rotate the convex hull.
 
 namespace convack {
@@ -17,10 +25,11 @@ public:
 	 * The transformation applied so far since the construction of the convex
 	 * polygon.
 	 *
-	 * This transformation is already applied to the vertices. Don't apply it
-	 * again. This field is only for bookkeeping. It's necessary to report a
-	 * usable result to the user of the library if he wants to know how the
-	 * convex polygons have been transformed to pack them.
+	 * This transformation is already applied to the vertices (or will be, if
+	 * transformations are lazy). Don't apply it again. This field is only for
+	 * bookkeeping. It's necessary to report a usable result to the user of the
+	 * library if he wants to know how the convex polygons have been
+	 * transformed to pack them.
 	 */
 	Transformation transformation;
 
@@ -34,30 +43,152 @@ public:
 
 	/*!
 	 * The coordinates of the convex polygon.
+	 *
+	 * If transformations are lazy, this is only a cache. It is filled in from
+	 * \ref lazy_vertices when the vertices are needed.
 	 */
-	std::vector<Point2> vertices;
+	mutable std::vector<Point2> vertices;
+
+	/*!
+	 * The axis-aligned bounding box around the vertices.
+	 *
+	 * This is kept up to date whenever the vertices are transformed, so that
+	 * collision and containment tests can first check against the bounding
+	 * box. Most convex polygons in a packing are far away from each other, so
+	 * most of those tests end there.
+	 *
+	 * If transformations are lazy, this is only a cache, like the vertices.
+	 */
+	mutable BoundingBox bounding_box;
+
+	/*!
+	 * Whether transformations are applied lazily.
+	 */
+	bool lazy;
+
+	/*!
+	 * If transformations are lazy, the vertices as they were when lazy
+	 * transformations were enabled.
+	 *
+	 * These never change, so copies of a lazy convex polygon share them rather
+	 * than copying them.
+	 */
+	std::shared_ptr<const std::vector<Point2>> lazy_vertices;
+
+	/*!
+	 * If transformations are lazy, the bounding box around the
+	 * \ref lazy_vertices.
+	 */
+	BoundingBox lazy_bounding_box;
+
+	/*!
+	 * If transformations are lazy, the transformation to apply to the
+	 * \ref lazy_vertices to get the current vertices.
+	 */
+	Transformation pending;
+
+	/*!
+	 * Whether the \ref pending transformation includes a rotation.
+	 *
+	 * If it doesn't, the bounding box can be computed by translating the
+	 * bounding box of the \ref lazy_vertices, without computing the vertices.
+	 */
+	bool pending_rotation;
+
+	/*!
+	 * Whether the cached \ref vertices are outdated, because there was a lazy
+	 * transformation since they were computed.
+	 */
+	mutable bool vertices_outdated;
+
+	/*!
+	 * Whether the cached \ref bounding_box is outdated, because there was a
+	 * lazy transformation since it was computed.
+	 */
+	mutable bool bounding_box_outdated;
 
 	/*! @copydoc ConvexPolygon::convex_hull(const std::vector<Point2>&)
 	 */
 	static ConvexPolygon convex_hull(const std::vector<Point2>& points) {
-		return gift_wrapping(points); //TODO: Use Chan's algorithm to construct convex hulls more efficiently.
+		std::vector<Point2> result;
+		hull_of_points(points, result);
+		return ConvexPolygon(std::move(result));
+	}
+
+	/*! @copydoc ConvexPolygon::convex_hull(const std::vector<Point2>&, ConvexPolygon&)
+	 */
+	static void convex_hull(const std::vector<Point2>& points, Impl& result) {
+		std::vector<Point2>& hull = hull_memory(); //Not the vertices of the result right away, since those may be the points.
+		hull_of_points(points, hull);
+		result.replace_vertices(hull);
 	}
 
 	/*! @copydoc ConvexPolygon::convex_hull(const std::vector<ConvexPolygon>&)
 	 */
 	static ConvexPolygon convex_hull(const std::vector<ConvexPolygon>& convex_polygons) {
+		CONVACK_COUNT(hull_computations);
 		return chans_algorithm(convex_polygons);
 	}
 
+	/*! @copydoc ConvexPolygon::convex_hull(const ConvexPolygon&, const ConvexPolygon&)
+	 */
+	static ConvexPolygon convex_hull(const ConvexPolygon& a, const ConvexPolygon& b) {
+		CONVACK_COUNT(hull_computations);
+		std::vector<Point2> result;
+		merge_hulls(a, b, result);
+		return ConvexPolygon(std::move(result));
+	}
+
+	/*! @copydoc ConvexPolygon::convex_hull(const ConvexPolygon&, const ConvexPolygon&, ConvexPolygon&)
+	 */
+	static void convex_hull(const ConvexPolygon& a, const ConvexPolygon& b, Impl& result) {
+		CONVACK_COUNT(hull_computations);
+		std::vector<Point2>& hull = hull_memory(); //Not the vertices of the result right away, since the result may be one of the inputs.
+		merge_hulls(a, b, hull);
+		result.replace_vertices(hull);
+	}
+
 	/*! @copydoc ConvexPolygon::ConvexPolygon(const std::vector<Point2>&)
 	 */
-	Impl(const std::vector<Point2>& vertices) : vertices(vertices) {
-		uuid = next_uid++;
+	Impl(const std::vector<Point2>& vertices) :
+			vertices(vertices),
+			bounding_box(vertices),
+			lazy(false),
+			pending_rotation(false),
+			vertices_outdated(false),
+			bounding_box_outdated(false) {
+		uuid = generate_uid();
+	}
+
+	/*! @copydoc ConvexPolygon::ConvexPolygon(std::vector<Point2>&&)
+	 */
+	Impl(std::vector<Point2>&& vertices) :
+			vertices(std::move(vertices)),
+			bounding_box(this->vertices),
+			lazy(false),
+			pending_rotation(false),
+			vertices_outdated(false),
+			bounding_box_outdated(false) {
+		uuid = generate_uid();
+	}
+
+	/*! @copydoc ConvexPolygon::ConvexPolygon(const std::vector<Point2>&, const Transformation&)
+	 */
+	Impl(const std::vector<Point2>& vertices, const Transformation& transformation) :
+			transformation(transformation),
+			vertices(vertices),
+			bounding_box(vertices),
+			lazy(false),
+			pending_rotation(false),
+			vertices_outdated(false),
+			bounding_box_outdated(false) {
+		uuid = generate_uid();
 	}
 
 	/*! @copydoc ConvexPolygon::operator ==(const ConvexPolygon&) const
 	 */
 	bool operator ==(const ConvexPolygon& other) const {
+		const std::vector<Point2>& vertices = get_vertices();
 		const std::vector<Point2>& other_vertices = other.get_vertices();
 		if(vertices.size() != other_vertices.size()) {
 			return false; //Early out for performance. This is easy to check.
@@ -66,19 +197,66 @@ public:
 			return true;
 		}
 
-		for(size_t offset = 0; offset < vertices.size(); ++offset) { //Try with any rotation of the vertices.
-			bool match = true;
-			for(size_t i = 0; i < vertices.size(); ++i) {
-				if(vertices[i] != other_vertices[(i + offset) % vertices.size()]) {
-					match = false;
-					break;
+		const size_t start = canonical_start();
+		const size_t other_start = other.pimpl->canonical_start();
+		if(!is_unique_vertex(start) || !other.pimpl->is_unique_vertex(other_start)) { //The lowest vertex is repeated, so it doesn't tell where the loops line up.
+			for(size_t offset = 0; offset < vertices.size(); ++offset) { //Try with any rotation of the vertices.
+				if(matches_rotation(other_vertices, 0, offset, false)) {
+					return true;
 				}
 			}
-			if(match) {
-				return true;
+			return false; //No match with any rotation.
+		}
+		//Both loops must start at their unique lowest vertex to line up. Only that rotation needs to be compared.
+		return matches_rotation(other_vertices, start, other_start, false);
+	}
+
+	/*! @copydoc ConvexPolygon::same_shape(const ConvexPolygon&) const
+	 */
+	bool same_shape(const ConvexPolygon& other) const {
+		const std::vector<Point2>& vertices = get_vertices();
+		const std::vector<Point2>& other_vertices = other.get_vertices();
+		if(vertices.size() != other_vertices.size()) {
+			return false;
+		}
+		if(vertices.empty()) {
+			return true;
+		}
+
+		//Like the equality check, but relative to the start vertex of each loop so that the position doesn't matter.
+		const size_t start = canonical_start();
+		const size_t other_start = other.pimpl->canonical_start();
+		if(!is_unique_vertex(start) || !other.pimpl->is_unique_vertex(other_start)) {
+			for(size_t offset = 0; offset < vertices.size(); ++offset) {
+				if(matches_rotation(other_vertices, 0, offset, true)) {
+					return true;
+				}
 			}
+			return false;
 		}
-		return false; //No match with any rotation.
+		return matches_rotation(other_vertices, start, other_start, true);
+	}
+
+	/*! @copydoc ConvexPolygon::shape_hash() const
+	 */
+	size_t shape_hash() const {
+		const std::vector<Point2>& vertices = get_vertices();
+		size_t result = std::hash<size_t>()(vertices.size());
+		if(vertices.empty()) {
+			return result;
+		}
+		const size_t start = canonical_start();
+		if(!is_unique_vertex(start)) {
+			return result; //Without a unique start vertex, the hash may only depend on what is the same for every rotation of the loop.
+		}
+		const Point2& start_vertex = vertices[start];
+		for(size_t i = 1; i < vertices.size(); ++i) { //The start vertex itself is always at 0, 0 relative to itself.
+			const Point2 relative = vertices[(start + i) % vertices.size()] - start_vertex;
+			//Combine the hashes the same way as boost::hash_combine does. Adding 0 turns -0 into 0, since those are equal but may hash differently.
+			result ^= std::hash<coordinate_t>()(relative.x + 0) + 0x9e3779b9 + (result << 6) + (result >> 2);
+			result ^= std::hash<coordinate_t>()(relative.y + 0) + 0x9e3779b9 + (result << 6) + (result >> 2);
+		}
+		return result;
 	}
 
 	/*! @copydoc ConvexPolygon::operator !=(const ConvexPolygon&) const
@@ -90,15 +268,16 @@ public:
 	/*! @copydoc ConvexPolygon::operator <<(std::ostream&, const ConvexPolygon&)
 	 */
 	friend std::ostream& operator <<(std::ostream& output_stream, const Impl& convex_polygon_impl) {
+		const std::vector<Point2>& vertices = convex_polygon_impl.get_vertices();
 		output_stream << "[";
-		for(size_t i = 0; i < convex_polygon_impl.vertices.size(); ++i) {
+		for(size_t i = 0; i < vertices.size(); ++i) {
 			if(i != 0) {
 				output_stream << ", ";
 			}
 			if(i >= 32) { //Output at most 32 vertices, to prevent spamming the output stream for debugging purposes.
 				return output_stream << "...]";
 			}
-			output_stream << convex_polygon_impl.vertices[i];
+			output_stream << vertices[i];
 		}
 		return output_stream << "]";
 	}
@@ -117,71 +296,105 @@ public:
 		the area of the triangle. Summing up all of those triangles (which may
 		be negative if the edge is clockwise w.r.t. the coordinate origin)
 		results in the total area of the convex polygon. This is the shoelace
-		formula.*/
-		area_t area = 0;
-		for(size_t vertex = 0, previous = vertices.size() - 1; vertex < vertices.size(); ++vertex) {
-			area += static_cast<area_t>(vertices[previous].x) * vertices[vertex].y - static_cast<area_t>(vertices[previous].y) * vertices[vertex].x;
-			previous = vertex;
+		formula.
+		The area doesn't change when rotating or translating the convex
+		polygon, so if transformations are lazy, we don't need to apply them
+		first.*/
+		const std::vector<Point2>& vertices = lazy ? *lazy_vertices : this->vertices;
+		if(vertices.size() < 3) {
+			return 0;
+		}
+		const Point2* vertex = vertices.data();
+		switch(vertices.size()) { //Most parts have few vertices, so those get a kernel for their number of vertices.
+			case 3: return shoelace(vertex, FixedSize<3>());
+			case 4: return shoelace(vertex, FixedSize<4>());
+			case 5: return shoelace(vertex, FixedSize<5>());
+			case 6: return shoelace(vertex, FixedSize<6>());
+			case 7: return shoelace(vertex, FixedSize<7>());
+			case 8: return shoelace(vertex, FixedSize<8>());
+			default: return shoelace(vertex, vertices.size());
 		}
-		return area / 2; //Instead of dividing each parallelogram's area by 2, simply divide the total by 2 afterwards.
 	}
 
 	/*! @copydoc ConvexPolygon::contains(const Point2&) const
 	 */
 	bool contains(const Point2& point) const {
-		if(vertices.size() < 3) {
+		if(num_vertices() < 3) {
 			return false; //Even if it's on the one vertex or one edge, it's still not considered inside.
 		}
 
-		//TODO: Speed up by checking with a bounding box or reduced resolution first.
+		if(!get_bounding_box().contains(point)) {
+			CONVACK_COUNT(bounding_box_early_outs);
+			return false; //Not even in the bounding box, so it can't be inside the convex polygon.
+		}
+		const std::vector<Point2>& vertices = get_vertices();
+		constexpr bool on_edge = false; //Being exactly on an edge is not inside.
+		return encloses_dispatch<on_edge>(vertices.data(), vertices.size(), &point, 1);
+	}
 
-		//For each edge, check if the point is left of that edge. If it's not left for any of them, the point is outside.
-		for(size_t i = 0; i < vertices.size(); ++i) {
-			if(is_left(vertices[i], vertices[(i + 1) % vertices.size()], point) <= 0) {
-				return false;
-			}
+	/*! @copydoc ConvexPolygon::contains(const ConvexPolygon&) const
+	 */
+	bool contains(const Impl& other) const {
+		if(num_vertices() < 3) {
+			return false; //Without area, nothing fits inside.
 		}
-		return true;
+		if(!get_bounding_box().encloses(other.get_bounding_box())) {
+			CONVACK_COUNT(bounding_box_early_outs);
+			return false; //Sticks out of the bounding box, so it must stick out of the convex polygon too.
+		}
+		const std::vector<Point2>& vertices = get_vertices();
+		const std::vector<Point2>& other_vertices = other.get_vertices();
+		constexpr bool on_edge = true; //Touching the boundary from the inside is allowed.
+		return encloses_dispatch<on_edge>(vertices.data(), vertices.size(), other_vertices.data(), other_vertices.size());
 	}
 
 	/*! @copydoc ConvexPolygon::collides(const ConvexPolygon&) const
+	 *
+	 * For small convex polygons, this uses a quadratic algorithm that is fast
+	 * in practice because it usually finds a separating axis early. For large
+	 * convex polygons, a linear algorithm is used instead. Both give the same
+	 * result.
 	 * \param check_other Whether to check collision from the other side. For a
 	 * correct result, the collision check needs to happen from both sides. This
 	 * parameter determines if we've already checked from the other side or not,
 	 * to prevent going into an infinite loop of checking back and forth.
 	 */
 	bool collides(const Impl& other, const bool check_other = true) const {
-		if(vertices.size() < 3 || other.vertices.size() < 3) { //Either of the convex polygons has no area, so there can be no area of overlap.
+		if(num_vertices() < 3 || other.num_vertices() < 3) { //Either of the convex polygons has no area, so there can be no area of overlap.
 			return false;
 		}
-		//TODO: Speed up by checking with a bounding box or reduced resolution first.
-
-		//This uses the separating axes theorem (SAT) to find collisions between convex polygons in quadratic time.
-		//Loop over all edges to see if the two convex polygons are completely separated by that axis.
-		for(size_t this_edge = 0; this_edge < vertices.size(); ++this_edge) {
-			const Point2 edge_vector = vertices[(this_edge + 1) % vertices.size()] - vertices[this_edge];
-			const Point2 axis_vector(edge_vector.y, -edge_vector.x); //Rotate 90 degrees to get an axis perpendicular to this edge to project the other polygon on.
-
-			/* Because the convex hull is winding counterclockwise, this convex
-			hull will always be completely to the left of the edge (negative on
-			the projection axis). Therefore we only need to check the other
-			convex polygon to see if it's completely to the right of the
-			projection axis (weakly positive on the projection axis). If it's
-			completely right, we've found the separating axis and the two are
-			not colliding. */
-
-			bool axis_overlap = false;
-			for(const Point2& other_vertex : other.vertices) {
-				const area_t projection = axis_vector.dot(other_vertex - vertices[this_edge]);
-				if(projection < 0) {
-					axis_overlap = true;
-					break;
-				}
-			}
-			if(!axis_overlap) { //No overlap on this axis, so the two polygons don't collide.
+		//If the bounding boxes don't overlap, the convex polygons can't overlap either. Only needs to be checked once, not again from the other side.
+		if(check_other) {
+			CONVACK_COUNT(collision_tests);
+			if(!get_bounding_box().overlaps(other.get_bounding_box())) {
+				CONVACK_COUNT(bounding_box_early_outs);
 				return false;
 			}
 		}
+		//From here on, we need the actual vertices.
+		const std::vector<Point2>& vertices = get_vertices();
+		other.get_vertices();
+		if(vertices.size() + other.vertices.size() >= linear_collision_threshold) {
+			return !has_separating_edge(other) && !other.has_separating_edge(*this);
+		}
+
+		//This uses the separating axes theorem (SAT) to find collisions between convex polygons in quadratic time.
+		const Point2* vertex = vertices.data();
+		const Point2* other_vertex = other.vertices.data();
+		const size_t other_size = other.vertices.size();
+		bool separated;
+		switch(vertices.size()) {
+			case 3: separated = separates(vertex, FixedSize<3>(), other_vertex, other_size); break;
+			case 4: separated = separates(vertex, FixedSize<4>(), other_vertex, other_size); break;
+			case 5: separated = separates(vertex, FixedSize<5>(), other_vertex, other_size); break;
+			case 6: separated = separates(vertex, FixedSize<6>(), other_vertex, other_size); break;
+			case 7: separated = separates(vertex, FixedSize<7>(), other_vertex, other_size); break;
+			case 8: separated = separates(vertex, FixedSize<8>(), other_vertex, other_size); break;
+			default: separated = separates(vertex, vertices.size(), other_vertex, other_size);
+		}
+		if(separated) { //No overlap on one of the axes, so the two polygons don't collide.
+			return false;
+		}
 
 		//Also check from the other side.
 		if(check_other) {
@@ -197,36 +410,106 @@ public:
 		return transformation;
 	}
 
+	/*! @copydoc ConvexPolygon::get_bounding_box() const
+	 */
+	const BoundingBox& get_bounding_box() const {
+		if(bounding_box_outdated) {
+			if(pending_rotation) {
+				bounding_box = BoundingBox(get_vertices());
+			} else if(lazy_bounding_box.empty()) {
+				bounding_box = lazy_bounding_box;
+			} else { //Only translated, so the corners of the bounding box move along with the vertices.
+				bounding_box.minimum = pending.apply(lazy_bounding_box.minimum);
+				bounding_box.maximum = pending.apply(lazy_bounding_box.maximum);
+			}
+			bounding_box_outdated = false;
+		}
+		return bounding_box;
+	}
+
 	/*! @copydoc ConvexPolygon::get_vertices() const
 	 */
 	const std::vector<Point2>& get_vertices() const {
+		if(vertices_outdated) {
+			vertices = *lazy_vertices;
+			pending.apply(vertices);
+			vertices_outdated = false;
+		}
 		return vertices;
 	}
 
+	/*! @copydoc ConvexPolygon::is_lazy() const
+	 */
+	bool is_lazy() const {
+		return lazy;
+	}
+
+	/*! @copydoc ConvexPolygon::set_lazy(const bool)
+	 */
+	void set_lazy(const bool lazy) {
+		if(lazy == this->lazy) {
+			return;
+		}
+		if(lazy) {
+			lazy_vertices = std::make_shared<const std::vector<Point2>>(std::move(vertices));
+			vertices.clear(); //Don't keep a second copy, so that copying this convex polygon is cheap.
+			vertices_outdated = true;
+			lazy_bounding_box = bounding_box;
+			pending = Transformation();
+			pending_rotation = false;
+		} else {
+			get_vertices(); //Apply everything that is still pending.
+			get_bounding_box();
+			lazy_vertices.reset();
+		}
+		this->lazy = lazy;
+	}
+
 	/*! @copydoc ConvexPolygon::rotate(const double)
 	 */
 	void rotate(const double angle_radians) {
+		transformation.rotate(angle_radians); //Also track the transformation so far.
+		if(lazy) {
+			pending.rotate(angle_radians);
+			pending_rotation = true;
+			vertices_outdated = true;
+			bounding_box_outdated = true;
+			return;
+		}
 		/* This actually applies the transformation to the vertices. We assume
 		here that the vertices are requested more often than the transformation
 		changed. Applying the transformation once is then more efficient. */
-		const Transformation rotation = Transformation().rotate(angle_radians);
-		for(Point2& vertex : vertices) {
-			vertex = rotation.apply(vertex);
-		}
-		transformation.rotate(angle_radians); //Also track the transformation so far.
+		Transformation().rotate(angle_radians).apply(vertices);
+		bounding_box = BoundingBox(vertices);
 	}
 
 	/*! @copydoc ConvexPolygon::translate(const coordinate_t, const coordinate_t)
 	 */
 	void translate(const coordinate_t x, const coordinate_t y) {
+		transformation.translate(x, y); //Also track the transformation so far.
+		if(lazy) {
+			pending.translate(x, y);
+			vertices_outdated = true;
+			bounding_box_outdated = true;
+			return;
+		}
 		/* This actually applies the transformation to the vertices. We assume
 		here that the vertices are requested more often than the transformation
 		changed. Applying the transformation once is then more efficient. */
-		const Transformation translation = Transformation().translate(x, y);
-		for(Point2& vertex : vertices) {
-			vertex = translation.apply(vertex);
+		//Adding directly to the coordinates gives the same result as applying a translation matrix, but is much cheaper and easy to vectorise.
+		Point2* vertex = vertices.data();
+		const size_t size = vertices.size();
+		for(size_t i = 0; i < size; ++i) {
+			vertex[i].x += x;
+			vertex[i].y += y;
+		}
+		//Rounding is monotonic, so the translated minimum and maximum are still the minimum and maximum.
+		if(!bounding_box.empty()) {
+			bounding_box.minimum.x += x;
+			bounding_box.minimum.y += y;
+			bounding_box.maximum.x += x;
+			bounding_box.maximum.y += y;
 		}
-		transformation.translate(x, y); //Also track the transformation so far.
 	}
 
 	uint64_t uid() const {
@@ -235,22 +518,348 @@ public:
 
 private:
 	/*!
-	 * Incrementing counter that increments every time we create a new convex
-	 * polygon. This way, at least within the lifetime of one thread, each
-	 * convex polygon gets a unique identifier assigned.
+	 * Find the vertex where the canonical ordering of the vertex loop starts.
+	 *
+	 * That is the lowest vertex, or the left-most of the lowest vertices. It
+	 * doesn't depend on where the vertex list happens to start, so comparing
+	 * two loops from there only needs to compare one rotation of them.
+	 * \return The index of the first vertex in the canonical ordering.
 	 */
-	static uint64_t next_uid;
+	size_t canonical_start() const {
+		const std::vector<Point2>& vertices = get_vertices();
+		size_t start = 0;
+		for(size_t i = 1; i < vertices.size(); ++i) {
+			if(vertices[i].y < vertices[start].y || (vertices[i].y == vertices[start].y && vertices[i].x < vertices[start].x)) {
+				start = i;
+			}
+		}
+		return start;
+	}
+
+	/*!
+	 * Check whether no other vertex of this convex polygon is at the same
+	 * position as the vertex with the given index.
+	 *
+	 * The canonical start is only a reliable place to line up two loops if it
+	 * is unique. Degenerate input may repeat its lowest vertex.
+	 * \param index The index of the vertex to check.
+	 * \return ``true`` if the vertex occurs only once, or ``false`` if it is
+	 * repeated.
+	 */
+	bool is_unique_vertex(const size_t index) const {
+		const std::vector<Point2>& vertices = get_vertices();
+		for(size_t i = 0; i < vertices.size(); ++i) {
+			if(i != index && vertices[i] == vertices[index]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/*!
+	 * Compare the vertex loop of this convex polygon to another loop of the
+	 * same size, lining up the given start vertices of both.
+	 * \param other_vertices The vertices of the other loop.
+	 * \param start The index in this loop to start comparing from.
+	 * \param other_start The index in the other loop to line up with
+	 * ``start``.
+	 * \param relative Whether to compare the vertices relative to the start
+	 * vertices, ignoring the position of the loops.
+	 * \return ``true`` if all vertices match in this rotation, or ``false``
+	 * if any of them differ.
+	 */
+	bool matches_rotation(const std::vector<Point2>& other_vertices, const size_t start, const size_t other_start, const bool relative) const {
+		const std::vector<Point2>& vertices = get_vertices();
+		const Point2 start_vertex = relative ? vertices[start] : Point2(0, 0);
+		const Point2 other_start_vertex = relative ? other_vertices[other_start] : Point2(0, 0);
+		for(size_t i = 0; i < vertices.size(); ++i) {
+			if(vertices[(start + i) % vertices.size()] - start_vertex != other_vertices[(other_start + i) % vertices.size()] - other_start_vertex) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/*!
+	 * Get the number of vertices of this convex polygon, without applying any
+	 * lazy transformations.
+	 * \return The number of vertices.
+	 */
+	size_t num_vertices() const {
+		return lazy ? lazy_vertices->size() : vertices.size();
+	}
+
+	/*!
+	 * The total number of vertices of two convex polygons above which the
+	 * collision check uses the linear algorithm rather than the quadratic one.
+	 *
+	 * The linear algorithm always needs to go around both convex polygons
+	 * completely, whereas the quadratic one can stop at the first separating
+	 * axis. So for small convex polygons the quadratic one is faster.
+	 */
+	static constexpr size_t linear_collision_threshold = 32;
+
+	/*!
+	 * The number of points above which convex hulls are constructed with the
+	 * monotone chain algorithm rather than with gift wrapping.
+	 *
+	 * Gift wrapping takes O(n*h) time, where h is the number of vertices in the
+	 * result. The monotone chain algorithm takes O(n log n) time, but needs to
+	 * copy and sort the points first. Measured on random points, the monotone
+	 * chain algorithm is already faster from about 8 points onwards, and on
+	 * points on a circle (where every point is in the result) it is more than
+	 * 300 times faster at 10000 points.
+	 */
+	static constexpr size_t monotone_chain_threshold = 8;
+
+	/*!
+	 * Counter of the identifiers handed out so far. This way, each convex
+	 * polygon gets a unique identifier assigned.
+	 *
+	 * Convex polygons may be created on multiple threads at once, for instance
+	 * while expanding the beam search. So this counter must be atomic. To
+	 * prevent all threads from contending for it, each thread takes a block of
+	 * identifiers at a time, see \ref generate_uid.
+	 */
+	static std::atomic<uint64_t> next_uid;
+
+	/*!
+	 * How many identifiers each thread takes from \ref next_uid at a time.
+	 *
+	 * The threads then only touch the shared counter once per this many convex
+	 * polygons. Identifiers that a thread doesn't use before it ends are
+	 * skipped, but with 64 bits there are plenty.
+	 */
+	static constexpr uint64_t uid_block_size = 1024;
+
+	/*!
+	 * Get a new unique identifier for a convex polygon.
+	 *
+	 * This is safe to call from multiple threads at once. Identifiers are
+	 * unique, but only increasing within each thread.
+	 * \return An identifier that no other convex polygon has.
+	 */
+	static uint64_t generate_uid() {
+		thread_local uint64_t next = 0; //The next identifier to hand out from the block of this thread.
+		thread_local uint64_t block_end = 0; //Where the block of this thread ends.
+		if(next == block_end) {
+			next = next_uid.fetch_add(uid_block_size, std::memory_order_relaxed);
+			block_end = next + uid_block_size;
+		}
+		return next++;
+	}
+
+	/*!
+	 * A number of vertices that is fixed at compile time.
+	 *
+	 * Most parts have only a few vertices. The kernels below take the number of
+	 * vertices either as a `size_t` or as one of these, so that there is a
+	 * separate instance of each kernel for each small number of vertices. In
+	 * those, the compiler knows how often every loop runs, so it can unroll
+	 * the loops completely.
+	 */
+	template<size_t N>
+	using FixedSize = std::integral_constant<size_t, N>;
+
+	/*!
+	 * Computes the area of a convex polygon with the shoelace formula. See
+	 * \ref area.
+	 * \param vertex The vertices of the convex polygon. There must be at least
+	 * 3.
+	 * \param size The number of vertices, as a `size_t` or a \ref FixedSize.
+	 * \return The area of the convex polygon.
+	 */
+	template<typename Size>
+	static area_t shoelace(const Point2* vertex, const Size size) {
+		const size_t num = size;
+		//Sum into 4 independent totals, so that consecutive additions don't need to wait for each other and the compiler can vectorise them.
+		area_t area[4] = {0, 0, 0, 0};
+		size_t i = 1;
+		for(; i + 3 < num; i += 4) {
+			for(size_t lane = 0; lane < 4; ++lane) {
+				area[lane] += static_cast<area_t>(vertex[i + lane - 1].x) * vertex[i + lane].y - static_cast<area_t>(vertex[i + lane - 1].y) * vertex[i + lane].x;
+			}
+		}
+		for(; i < num; ++i) {
+			area[0] += static_cast<area_t>(vertex[i - 1].x) * vertex[i].y - static_cast<area_t>(vertex[i - 1].y) * vertex[i].x;
+		}
+		area[0] += static_cast<area_t>(vertex[num - 1].x) * vertex[0].y - static_cast<area_t>(vertex[num - 1].y) * vertex[0].x; //Close the loop.
+		return ((area[0] + area[1]) + (area[2] + area[3])) / 2; //Instead of dividing each parallelogram's area by 2, simply divide the total by 2 afterwards.
+	}
+
+	/*!
+	 * Tests whether points are all inside of a convex polygon.
+	 * \param vertex The vertices of the convex polygon.
+	 * \param size The number of vertices, as a `size_t` or a \ref FixedSize.
+	 * \param points The points to test.
+	 * \param num_points The number of points to test.
+	 * \tparam on_edge Whether points exactly on an edge count as inside.
+	 * \return `true` if all points are inside, or `false` if any of them is
+	 * outside.
+	 */
+	template<bool on_edge, typename Size>
+	static bool encloses(const Point2* vertex, const Size size, const Point2* points, const size_t num_points) {
+		const size_t num = size;
+		for(size_t point = 0; point < num_points; ++point) {
+			//For each edge, check if the point is left of that edge. If it's not left for any of them, the point is outside.
+			for(size_t i = 0, previous = num - 1; i < num; previous = i++) { //Going from the previous vertex to each vertex instead of to the next, so that it doesn't need to wrap around.
+				const area_t left = is_left(vertex[previous], vertex[i], points[point]);
+				if(on_edge ? left < 0 : left <= 0) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/*!
+	 * Calls \ref encloses with a \ref FixedSize if the convex polygon has few
+	 * vertices.
+	 * \param vertex The vertices of the convex polygon.
+	 * \param size The number of vertices.
+	 * \param points The points to test.
+	 * \param num_points The number of points to test.
+	 * \tparam on_edge Whether points exactly on an edge count as inside.
+	 * \return `true` if all points are inside, or `false` if any of them is
+	 * outside.
+	 */
+	template<bool on_edge>
+	static bool encloses_dispatch(const Point2* vertex, const size_t size, const Point2* points, const size_t num_points) {
+		switch(size) {
+			case 3: return encloses<on_edge>(vertex, FixedSize<3>(), points, num_points);
+			case 4: return encloses<on_edge>(vertex, FixedSize<4>(), points, num_points);
+			case 5: return encloses<on_edge>(vertex, FixedSize<5>(), points, num_points);
+			case 6: return encloses<on_edge>(vertex, FixedSize<6>(), points, num_points);
+			case 7: return encloses<on_edge>(vertex, FixedSize<7>(), points, num_points);
+			case 8: return encloses<on_edge>(vertex, FixedSize<8>(), points, num_points);
+			default: return encloses<on_edge>(vertex, size, points, num_points);
+		}
+	}
+
+	/*!
+	 * Tests whether one of the edges of a convex polygon separates it from
+	 * another convex polygon, in quadratic time.
+	 *
+	 * Because the convex polygon is winding counter-clockwise, it is always
+	 * completely to the left of each of its edges. So we only need to check
+	 * whether the other convex polygon is completely to the right of an edge,
+	 * or on it. If so, that edge is a separating axis.
+	 * \param vertex The vertices of the convex polygon.
+	 * \param size The number of vertices, as a `size_t` or a \ref FixedSize.
+	 * \param other The vertices of the other convex polygon.
+	 * \param other_size The number of vertices of the other convex polygon.
+	 * \return `true` if one of the edges separates the two, or `false` if
+	 * none of them does.
+	 */
+	template<typename Size>
+	static bool separates(const Point2* vertex, const Size size, const Point2* other, const size_t other_size) {
+		const size_t num = size;
+		for(size_t i = 0, previous = num - 1; i < num; previous = i++) { //Going from the previous vertex to each vertex instead of to the next, so that it doesn't need to wrap around.
+			bool axis_overlap = false;
+			for(size_t other_vertex = 0; other_vertex < other_size; ++other_vertex) {
+				if(is_left(vertex[previous], vertex[i], other[other_vertex]) > 0) {
+					axis_overlap = true;
+					break;
+				}
+			}
+			if(!axis_overlap) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*!
+	 * Test whether one of the edges of this convex polygon separates it from
+	 * another convex polygon, in linear time.
+	 *
+	 * This uses the separating axes theorem like the quadratic collision check,
+	 * but it makes use of the convexity of the other polygon to avoid
+	 * projecting all of its vertices on every axis. Only the vertex of the
+	 * other polygon that reaches furthest past an edge needs to be projected.
+	 * As we go along the edges of this convex polygon counter-clockwise, their
+	 * normals rotate counter-clockwise too, and so does that deepest vertex
+	 * along the other convex polygon. The deepest vertex for the next edge can
+	 * then be found by walking forward from the deepest vertex for the
+	 * previous edge. In total, this walks around the other convex polygon
+	 * once, which takes O(n + m) time.
+	 * \param other The convex polygon to check for a separating edge against.
+	 *
+	 * The vertices of both convex polygons must be up to date.
+	 * \return `true` if the other convex polygon is completely outside of one
+	 * of the edges of this convex polygon, or `false` if it isn't.
+	 */
+	bool has_separating_edge(const Impl& other) const {
+		const std::vector<Point2>& other_vertices = other.vertices;
+
+		//For the first edge, find the deepest vertex of the other convex polygon the slow way.
+		size_t deepest = 0;
+		{
+			const Point2 edge_vector = vertices[1] - vertices[0];
+			const Point2 axis_vector(edge_vector.y, -edge_vector.x);
+			area_t deepest_projection = axis_vector.dot(other_vertices[0] - vertices[0]);
+			for(size_t other_vertex = 1; other_vertex < other_vertices.size(); ++other_vertex) {
+				const area_t projection = axis_vector.dot(other_vertices[other_vertex] - vertices[0]);
+				if(projection < deepest_projection) {
+					deepest = other_vertex;
+					deepest_projection = projection;
+				}
+			}
+		}
+
+		for(size_t this_edge = 0; this_edge < vertices.size(); ++this_edge) {
+			const Point2 edge_vector = vertices[(this_edge + 1) % vertices.size()] - vertices[this_edge];
+			const Point2 axis_vector(edge_vector.y, -edge_vector.x); //Rotate 90 degrees to get an axis perpendicular to this edge to project the other polygon on.
+
+			//Walk forward along the other convex polygon as long as the vertices get deeper.
+			area_t deepest_projection = axis_vector.dot(other_vertices[deepest] - vertices[this_edge]);
+			for(size_t step = 0; step < other_vertices.size(); ++step) { //Limit the number of steps, so that rounding errors can't make this loop endlessly.
+				const size_t next = (deepest + 1) % other_vertices.size();
+				const area_t next_projection = axis_vector.dot(other_vertices[next] - vertices[this_edge]);
+				if(next_projection >= deepest_projection) {
+					break;
+				}
+				deepest = next;
+				deepest_projection = next_projection;
+			}
+			if(deepest_projection >= 0) { //Even the deepest vertex is not past this edge, so this edge separates the two.
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*!
+	 * Construct the convex hull around a set of points, with whichever
+	 * algorithm is fastest for that many points.
+	 * \param points The points to construct a convex hull around.
+	 * \param result The vertices of the convex hull will be stored here. It
+	 * must not be the same list as the points.
+	 */
+	static void hull_of_points(const std::vector<Point2>& points, std::vector<Point2>& result) {
+		CONVACK_COUNT(hull_computations);
+		if(points.size() < monotone_chain_threshold) {
+			gift_wrapping(points, result);
+		} else {
+			monotone_chain(points, result);
+		}
+	}
 
 	/*!
 	 * Executes the gift wrapping algorithm on a set of points to create a
 	 * convex hull around them.
+	 * \param points The points to construct a convex hull around.
+	 * \param result The vertices of the convex hull will be stored here. It
+	 * must not be the same list as the points.
 	 */
-	static ConvexPolygon gift_wrapping(const std::vector<Point2>& points) {
+	static void gift_wrapping(const std::vector<Point2>& points, std::vector<Point2>& result) {
+		CONVACK_ZONE("ConvexPolygon::gift_wrapping");
+		result.clear();
 		if(points.size() <= 2) { //Though a triangle (3 vertices) is always convex, don't immediately return it since it could have incorrect winding.
-			return ConvexPolygon(points);
+			result.assign(points.begin(), points.end());
+			return;
 		}
 
-		std::vector<Point2> result;
 		Point2 last = *std::min_element(points.begin(), points.end(), [](const Point2& a, const Point2& b) {
 			return a.x < b.x || (a.x == b.x && a.y < b.y); //Select vertex most to negative X as starting point for the loop. The leftmost point is always in the convex hull.
 		});
@@ -285,8 +894,203 @@ private:
 
 			last = best;
 		} while(last != result[0]); //Repeat until we automatically close the loop.
+	}
 
-		return result;
+	/*!
+	 * Executes Andrew's monotone chain algorithm on a set of points to create a
+	 * convex hull around them.
+	 *
+	 * The points are sorted by their X coordinate. Then the lower half of the
+	 * convex hull is constructed by going through the points from left to
+	 * right, and the upper half by going through them from right to left. Each
+	 * new point is added to the half under construction, after removing the
+	 * last vertices of that half that would make it turn clockwise or go
+	 * straight. Sorting takes O(n log n) time, and constructing the halves
+	 * takes linear time, since every point is added and removed at most once.
+	 *
+	 * Like with gift wrapping, the result starts at the left-most vertex and
+	 * contains no colinear vertices.
+	 * \param points The points to construct a convex hull around.
+	 * \param result The vertices of the convex hull will be stored here. It
+	 * must not be the same list as the points.
+	 */
+	static void monotone_chain(const std::vector<Point2>& points, std::vector<Point2>& result) {
+		std::vector<Point2>& sorted = sorting_memory();
+		sorted.assign(points.begin(), points.end());
+		std::sort(sorted.begin(), sorted.end(), lexicographic_less);
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end()); //Overlapping points would create edges of length 0.
+		monotone_chain_sorted(sorted, result);
+	}
+
+	/*!
+	 * Executes the second part of Andrew's monotone chain algorithm, on points
+	 * that are already sorted.
+	 *
+	 * This constructs the lower and upper halves of the convex hull, in linear
+	 * time.
+	 * \param sorted The points to construct a convex hull around, sorted by
+	 * their X coordinate and then their Y coordinate, without duplicates.
+	 * \param result The vertices of the convex hull will be stored here. It
+	 * must not be the same list as the sorted points.
+	 */
+	static void monotone_chain_sorted(const std::vector<Point2>& sorted, std::vector<Point2>& result) {
+		result.clear();
+		if(sorted.size() <= 2) {
+			result.assign(sorted.begin(), sorted.end());
+			return;
+		}
+
+		result.reserve(sorted.size() + 1);
+		//The lower half, from left to right.
+		for(const Point2& point : sorted) {
+			while(result.size() >= 2 && is_left(result[result.size() - 2], result.back(), point) <= 0) {
+				result.pop_back();
+			}
+			result.push_back(point);
+		}
+		//The upper half, from right to left. The right-most point is already in the result.
+		const size_t lower_size = result.size();
+		for(size_t i = sorted.size() - 1; i-- > 0;) {
+			while(result.size() > lower_size && is_left(result[result.size() - 2], result.back(), sorted[i]) <= 0) {
+				result.pop_back();
+			}
+			result.push_back(sorted[i]);
+		}
+		result.pop_back(); //The upper half ends at the left-most point again, which is already the first vertex.
+	}
+
+	/*!
+	 * Construct the convex hull around two convex polygons in linear time.
+	 *
+	 * This is like Andrew's monotone chain algorithm, but the points don't
+	 * need to be sorted from scratch. The vertices of each convex polygon are
+	 * sorted in linear time, by merging its lower and upper halves. Then the
+	 * sorted vertices of both are merged, and the halves of the convex hull
+	 * are constructed from those.
+	 * \param a One of the convex polygons to construct a convex hull around.
+	 * \param b The other convex polygon to construct a convex hull around.
+	 * \param result The vertices of the convex hull around both of them will
+	 * be stored here. It must not be the vertices of either of them.
+	 */
+	static void merge_hulls(const ConvexPolygon& a, const ConvexPolygon& b, std::vector<Point2>& result) {
+		const std::vector<Point2>& a_vertices = a.get_vertices();
+		const std::vector<Point2>& b_vertices = b.get_vertices();
+		std::vector<Point2>& sorted = sorting_memory();
+		sorted.clear();
+		sorted.reserve(a_vertices.size() + b_vertices.size());
+		sort_vertices(a_vertices, sorted);
+		const size_t a_size = sorted.size();
+		sort_vertices(b_vertices, sorted);
+		std::inplace_merge(sorted.begin(), sorted.begin() + a_size, sorted.end(), lexicographic_less);
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end()); //Both may share vertices.
+		monotone_chain_sorted(sorted, result);
+	}
+
+	/*!
+	 * Get the memory that the current thread sorts points in to construct
+	 * convex hulls.
+	 *
+	 * Packing constructs a great number of convex hulls. Reusing this memory
+	 * means that constructing them doesn't allocate memory for the sorting.
+	 * \return A list of points that may be overwritten.
+	 */
+	static std::vector<Point2>& sorting_memory() {
+		thread_local std::vector<Point2> sorted;
+		return sorted;
+	}
+
+	/*!
+	 * Get the memory that the current thread constructs convex hulls in,
+	 * before they are stored in an existing convex polygon.
+	 *
+	 * The vertices of the convex hull are swapped with the old vertices of the
+	 * convex polygon, so the memory of those is reused for the next convex
+	 * hull.
+	 * \return A list of points that may be overwritten.
+	 */
+	static std::vector<Point2>& hull_memory() {
+		thread_local std::vector<Point2> hull;
+		return hull;
+	}
+
+	/*!
+	 * Replace the vertices of this convex polygon, as if it were constructed
+	 * from new vertices.
+	 *
+	 * This also resets the transformation and generates a new identifier.
+	 * \param new_vertices The new vertices. They are swapped with the old
+	 * vertices, so afterwards this list contains the old vertices.
+	 */
+	void replace_vertices(std::vector<Point2>& new_vertices) {
+		vertices.swap(new_vertices);
+		bounding_box = BoundingBox(vertices);
+		transformation = Transformation();
+		lazy = false;
+		lazy_vertices.reset();
+		pending = Transformation();
+		pending_rotation = false;
+		vertices_outdated = false;
+		bounding_box_outdated = false;
+		uuid = generate_uid();
+	}
+
+	/*!
+	 * Sort the vertices of a convex polygon by their X coordinate and then
+	 * their Y coordinate, in linear time.
+	 *
+	 * Going counter-clockwise from the left-most vertex to the right-most
+	 * vertex traverses the lower half in sorted order. Going clockwise
+	 * traverses the upper half in sorted order. Merging those two gives all
+	 * vertices in sorted order.
+	 * \param vertices The vertices of a convex polygon, counter-clockwise.
+	 * \param sorted The list to add the sorted vertices to.
+	 */
+	static void sort_vertices(const std::vector<Point2>& vertices, std::vector<Point2>& sorted) {
+		const size_t size = vertices.size();
+		if(size == 0) {
+			return;
+		}
+		size_t left = 0;
+		size_t right = 0;
+		for(size_t i = 1; i < size; ++i) {
+			if(lexicographic_less(vertices[i], vertices[left])) {
+				left = i;
+			}
+			if(lexicographic_less(vertices[right], vertices[i])) {
+				right = i;
+			}
+		}
+
+		sorted.push_back(vertices[left]);
+		size_t lower = (left + 1) % size; //Going counter-clockwise along the lower half.
+		size_t upper = (left + size - 1) % size; //Going clockwise along the upper half.
+		while(lower != right || upper != right) {
+			if(upper == right || (lower != right && lexicographic_less(vertices[lower], vertices[upper]))) {
+				sorted.push_back(vertices[lower]);
+				lower = (lower + 1) % size;
+			} else {
+				sorted.push_back(vertices[upper]);
+				upper = (upper + size - 1) % size;
+			}
+		}
+		if(right != left) {
+			sorted.push_back(vertices[right]);
+		}
+	}
+
+	/*!
+	 * Compare two points by their X coordinate, and then by their Y
+	 * coordinate.
+	 *
+	 * This is the order in which the monotone chain algorithm processes the
+	 * points.
+	 * \param a The point that may come first.
+	 * \param b The point that may come last.
+	 * \return `true` if point `a` comes before point `b`, or `false` if it
+	 * doesn't.
+	 */
+	static bool lexicographic_less(const Point2& a, const Point2& b) {
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
 	}
 
 	/*!
@@ -314,6 +1118,7 @@ private:
 	 * \return A convex hull around all of the polygons.
 	 */
 	static ConvexPolygon chans_algorithm(const std::vector<ConvexPolygon>& convex_polygons) {
+		CONVACK_ZONE("ConvexPolygon::chans_algorithm");
 		if(convex_polygons.empty()) {
 			return ConvexPolygon({});
 		}
@@ -324,6 +1129,7 @@ private:
 		//As a guess of the size of the output size, we'll use the largest of the polygons.
 		//Not used as "K" parameter here. Just to reserve enough vertices in the output vector!
 		size_t largest_polygon_size = 4; //Don't reserve for fewer than 4 vertices anyway.
+		size_t total_vertices = 0; //The result can never have more vertices than all of the input together.
 
 		//First find the left-most vertex among all convex polygons.
 		//This vertex is always in the convex hull.
@@ -336,6 +1142,7 @@ private:
 				continue;
 			}
 			largest_polygon_size = std::max(largest_polygon_size, vertices.size());
+			total_vertices += vertices.size();
 			//Perform a binary search to find the left-most vertex of this convex polygon.
 			size_t lower_bound = 0;
 			size_t upper_bound = vertices.size();
@@ -387,6 +1194,10 @@ private:
 					}
 				}
 			}
+			//The binary search may end up next to the left-most vertex, or past the end, if there are colinear vertices. Walk to the actual extremum.
+			lower_bound = walk_to_extremum(vertices, lower_bound % vertices.size(), [&vertices](const size_t current, const size_t candidate) {
+				return vertices[candidate].x < vertices[current].x || (vertices[candidate].x == vertices[current].x && vertices[candidate].y < vertices[current].y);
+			});
 			if(vertices[lower_bound].x < best.x || (vertices[lower_bound].x == best.x && vertices[lower_bound].y < best.y)) {
 				best = vertices[lower_bound];
 				best_vertex = lower_bound;
@@ -481,6 +1292,12 @@ private:
 					}
 				}
 
+				//The binary search may end up next to the right-most vertex, or past the end, if there are colinear or nearly colinear vertices. Walk to the actual extremum.
+				lower_bound = walk_to_extremum(vertices, lower_bound % vertices.size(), [&vertices, &last](const size_t current, const size_t candidate) {
+					const area_t how_left = is_left(last, vertices[current], vertices[candidate]);
+					return how_left < 0 || (how_left == 0 && (vertices[candidate] - last).magnitude2() > (vertices[current] - last).magnitude2());
+				});
+
 				//We've found the right-most vertex of this convex polygon (index lower_bound). Is it better than the current best?
 				const area_t how_left = is_left(last, best, vertices[lower_bound]);
 				if(how_left < 0 || (how_left == 0 && (vertices[lower_bound] - last).magnitude2() > (best - last).magnitude2())) { //Is it more to the right, or equally but farther?
@@ -494,9 +1311,39 @@ private:
 			last = best;
 			last_polygon = best_polygon;
 			last_vertex = best_vertex;
-		} while(best != result[0]); //Continue until we're looping back to the first vertex of the result.
+		} while(best != result[0] && result.size() <= total_vertices); //Continue until we're looping back to the first vertex of the result. Rounding errors must never make that loop endlessly.
+
+		return ConvexPolygon(std::move(result));
+	}
 
-		return ConvexPolygon(result);
+	/*!
+	 * Walk along the vertices of a convex polygon to find the most extreme
+	 * vertex in some measure, starting from a vertex that is close to it.
+	 *
+	 * This is used to correct the result of the binary searches in Chan's
+	 * algorithm. Those binary searches may end up next to the extremum when
+	 * there are colinear or nearly colinear vertices. Because the polygon is
+	 * convex, the measures we're searching for only have one local optimum
+	 * along the loop of vertices. So walking in whichever direction improves
+	 * the measure is guaranteed to end up at the extremum. If the starting
+	 * vertex is close to the extremum, this only takes a few steps.
+	 * \param vertices The vertices of the convex polygon.
+	 * \param start The index of the vertex to start searching from.
+	 * \param is_better A function that takes the indices of two vertices, and
+	 * returns whether the second is more extreme than the first.
+	 * \return The index of the most extreme vertex.
+	 */
+	template<typename Comparison>
+	static size_t walk_to_extremum(const std::vector<Point2>& vertices, const size_t start, const Comparison& is_better) {
+		const size_t size = vertices.size();
+		size_t result = start;
+		for(size_t step = 0; step < size && is_better(result, (result + 1) % size); ++step) {
+			result = (result + 1) % size;
+		}
+		for(size_t step = 0; step < size && is_better(result, (result + size - 1) % size); ++step) {
+			result = (result + size - 1) % size;
+		}
+		return result;
 	}
 
 	/*!
@@ -510,11 +1357,13 @@ private:
 	 * zero when it's exactly on top of that line.
 	 */
 	static area_t is_left(const Point2& a, const Point2& b, const Point2& query) {
-		return (static_cast<area_t>(b.x) - a.x) * (query.y - a.y) - (b.y - a.y) * (query.x - a.x);
+		return (static_cast<area_t>(b.x) - a.x) * (static_cast<area_t>(query.y) - a.y) - (static_cast<area_t>(b.y) - a.y) * (static_cast<area_t>(query.x) - a.x); //Widen first, so that integer coordinates don't overflow.
 	}
 };
 
-size_t ConvexPolygon::Impl::next_uid = 0;
+constexpr size_t ConvexPolygon::Impl::linear_collision_threshold;
+constexpr size_t ConvexPolygon::Impl::monotone_chain_threshold;
+std::atomic<uint64_t> ConvexPolygon::Impl::next_uid(0);
 
 //Implementations of the parent ConvexPolygon class all refers on to the PIMPL class.
 
@@ -526,17 +1375,47 @@ ConvexPolygon ConvexPolygon::convex_hull(const std::vector<ConvexPolygon>& conve
 	return ConvexPolygon::Impl::convex_hull(convex_polygons);
 }
 
+ConvexPolygon ConvexPolygon::convex_hull(const ConvexPolygon& a, const ConvexPolygon& b) {
+	return ConvexPolygon::Impl::convex_hull(a, b);
+}
+
+void ConvexPolygon::convex_hull(const std::vector<Point2>& points, ConvexPolygon& result) {
+	if(!result.pimpl) { //Was moved from.
+		result.pimpl.reset(new Impl(std::vector<Point2>()));
+	}
+	ConvexPolygon::Impl::convex_hull(points, *result.pimpl);
+}
+
+void ConvexPolygon::convex_hull(const ConvexPolygon& a, const ConvexPolygon& b, ConvexPolygon& result) {
+	if(!result.pimpl) { //Was moved from.
+		result.pimpl.reset(new Impl(std::vector<Point2>()));
+	}
+	ConvexPolygon::Impl::convex_hull(a, b, *result.pimpl);
+}
+
 ConvexPolygon::ConvexPolygon(const std::vector<Point2>& vertices) : pimpl(new Impl(vertices)) {}
 
+ConvexPolygon::ConvexPolygon(std::vector<Point2>&& vertices) : pimpl(new Impl(std::move(vertices))) {}
+
+ConvexPolygon::ConvexPolygon(const std::vector<Point2>& vertices, const Transformation& transformation) : pimpl(new Impl(vertices, transformation)) {}
+
 ConvexPolygon::ConvexPolygon(const ConvexPolygon& original) : pimpl(new Impl(*original.pimpl)) {}
 
+ConvexPolygon::ConvexPolygon(ConvexPolygon&& original) noexcept = default; //Takes over the implementation, including the transformation and identifier.
+
 ConvexPolygon::~ConvexPolygon() = default; //Defined here where there is a complete type for Impl, so that the unique_ptr can be deleted.
 
 ConvexPolygon& ConvexPolygon::operator =(const ConvexPolygon& original) {
-	pimpl = std::unique_ptr<Impl>(new Impl(original.pimpl->get_vertices()));
+	if(pimpl) {
+		*pimpl = *original.pimpl; //Copy the transformation and identifier along with the vertices, into the memory that this one already has.
+	} else { //Was moved from.
+		pimpl = std::unique_ptr<Impl>(new Impl(*original.pimpl));
+	}
 	return *this;
 }
 
+ConvexPolygon& ConvexPolygon::operator =(ConvexPolygon&& original) noexcept = default;
+
 bool ConvexPolygon::operator ==(const ConvexPolygon& other) const {
 	return *pimpl == other;
 }
@@ -545,6 +1424,14 @@ bool ConvexPolygon::operator !=(const ConvexPolygon& other) const {
 	return *pimpl != other;
 }
 
+bool ConvexPolygon::same_shape(const ConvexPolygon& other) const {
+	return pimpl->same_shape(other);
+}
+
+size_t ConvexPolygon::shape_hash() const {
+	return pimpl->shape_hash();
+}
+
 std::ostream& operator <<(std::ostream& output_stream, const ConvexPolygon& convex_polygon) {
 	return output_stream << *convex_polygon.pimpl;
 }
@@ -557,7 +1444,12 @@ bool ConvexPolygon::contains(const Point2& point) const {
 	return pimpl->contains(point);
 }
 
+bool ConvexPolygon::contains(const ConvexPolygon& other) const {
+	return pimpl->contains(*other.pimpl);
+}
+
 bool ConvexPolygon::collides(const ConvexPolygon& other) const {
+	CONVACK_ZONE("ConvexPolygon::collides");
 	return pimpl->collides(*other.pimpl);
 }
 
@@ -565,10 +1457,23 @@ const Transformation& ConvexPolygon::current_transformation() const {
 	return pimpl->current_transformation();
 }
 
+const BoundingBox& ConvexPolygon::get_bounding_box() const {
+	return pimpl->get_bounding_box();
+}
+
 const std::vector<Point2>& ConvexPolygon::get_vertices() const {
 	return pimpl->get_vertices();
 }
 
+bool ConvexPolygon::is_lazy() const {
+	return pimpl->is_lazy();
+}
+
+ConvexPolygon& ConvexPolygon::set_lazy(const bool lazy) {
+	pimpl->set_lazy(lazy);
+	return *this;
+}
+
 ConvexPolygon& ConvexPolygon::rotate(const double angle_radians) {
 	pimpl->rotate(angle_radians);
 	return *this;
@@ -579,7 +1484,7 @@ ConvexPolygon& ConvexPolygon::translate(const coordinate_t x, const coordinate_t
 	return *this;
 }
 
-size_t ConvexPolygon::uid() const {
+uint64_t ConvexPolygon::uid() const {
 	return pimpl->uid();
 }
 
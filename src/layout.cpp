@@ -0,0 +1,62 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <algorithm> //For std::max.
+
+#include "bounding_box.hpp" //To size the cells of the index.
+#include "layout.hpp" //The definitions we're implementing here.
+#include "point2.hpp" //To construct an empty convex hull.
+
+namespace convack {
+
+Layout::Layout() : index(1), convex_hull(std::vector<Point2>()), covered_area(0) {}
+
+void Layout::add(const ConvexPolygon& convex_polygon, const size_t rotation) {
+	if(convex_polygons.empty()) { //The first convex polygon determines the size of the cells.
+		const BoundingBox& bounding_box = convex_polygon.get_bounding_box();
+		index = SpatialIndex(bounding_box.empty() ? 1 : std::max(bounding_box.maximum.x - bounding_box.minimum.x, bounding_box.maximum.y - bounding_box.minimum.y));
+		convex_hull = convex_polygon;
+	} else {
+		convex_hull = ConvexPolygon::convex_hull(convex_hull, convex_polygon);
+	}
+	convex_polygons.push_back(convex_polygon);
+	rotations.push_back(rotation);
+	index.insert(&convex_polygons.back());
+	covered_area += convex_polygon.area();
+}
+
+void Layout::clear() {
+	convex_polygons.clear();
+	rotations.clear();
+	index.clear();
+	convex_hull = ConvexPolygon(std::vector<Point2>());
+	covered_area = 0;
+}
+
+bool Layout::empty() const {
+	return convex_polygons.empty();
+}
+
+const std::deque<ConvexPolygon>& Layout::get_convex_polygons() const {
+	return convex_polygons;
+}
+
+const std::vector<size_t>& Layout::get_rotations() const {
+	return rotations;
+}
+
+const SpatialIndex& Layout::get_index() const {
+	return index;
+}
+
+const ConvexPolygon& Layout::get_convex_hull() const {
+	return convex_hull;
+}
+
+area_t Layout::get_covered_area() const {
+	return covered_area;
+}
+
+}
\ No newline at end of file
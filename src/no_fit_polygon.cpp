@@ -0,0 +1,117 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <algorithm> //For std::min and std::max.
+#include <limits> //To start with an unbounded line.
+#include <utility> //To move vertex lists into convex polygons.
+
+#include "no_fit_polygon.hpp" //The definitions we're implementing here.
+#include "point2.hpp" //To compute with the vertices of the convex polygons.
+
+namespace convack {
+
+ConvexPolygon NoFitPolygon::minkowski_sum(const ConvexPolygon& a, const ConvexPolygon& b) {
+	const std::vector<Point2>& a_vertices = a.get_vertices();
+	const std::vector<Point2>& b_vertices = b.get_vertices();
+	if(a_vertices.empty() || b_vertices.empty()) {
+		return ConvexPolygon({});
+	}
+
+	//Start at the lowest vertex of both. The edges going from there are the ones with the smallest angle.
+	const size_t a_start = lowest_vertex(a_vertices);
+	const size_t b_start = lowest_vertex(b_vertices);
+	const size_t a_size = a_vertices.size();
+	const size_t b_size = b_vertices.size();
+
+	std::vector<Point2> result;
+	result.reserve(a_size + b_size);
+	size_t a_edge = 0;
+	size_t b_edge = 0;
+	while(a_edge < a_size || b_edge < b_size) {
+		const Point2& a_vertex = a_vertices[(a_start + a_edge) % a_size];
+		const Point2& b_vertex = b_vertices[(b_start + b_edge) % b_size];
+		result.push_back(a_vertex + b_vertex);
+
+		//Take the edge with the smallest angle next. If both are parallel, take both at once so that we don't get colinear vertices.
+		const Point2 a_vector = a_vertices[(a_start + a_edge + 1) % a_size] - a_vertex;
+		const Point2 b_vector = b_vertices[(b_start + b_edge + 1) % b_size] - b_vertex;
+		const area_t cross = static_cast<area_t>(a_vector.x) * b_vector.y - static_cast<area_t>(a_vector.y) * b_vector.x;
+		if(b_edge == b_size || (a_edge < a_size && cross > 0)) {
+			++a_edge;
+		} else if(a_edge == a_size || cross < 0) {
+			++b_edge;
+		} else {
+			++a_edge;
+			++b_edge;
+		}
+	}
+	return ConvexPolygon(std::move(result));
+}
+
+size_t NoFitPolygon::lowest_vertex(const std::vector<Point2>& vertices) {
+	size_t lowest = 0;
+	for(size_t i = 1; i < vertices.size(); ++i) {
+		if(vertices[i].y < vertices[lowest].y || (vertices[i].y == vertices[lowest].y && vertices[i].x < vertices[lowest].x)) {
+			lowest = i;
+		}
+	}
+	return lowest;
+}
+
+NoFitPolygon::NoFitPolygon(const ConvexPolygon& stationary, const ConvexPolygon& orbiting) : polygon({}) {
+	//Mirror the orbiting convex polygon through the origin. That's a half turn, so it keeps winding counter-clockwise.
+	std::vector<Point2> mirrored;
+	mirrored.reserve(orbiting.get_vertices().size());
+	for(const Point2& vertex : orbiting.get_vertices()) {
+		mirrored.emplace_back(-vertex.x, -vertex.y);
+	}
+	polygon = minkowski_sum(stationary, ConvexPolygon(std::move(mirrored)));
+}
+
+const ConvexPolygon& NoFitPolygon::get_polygon() const {
+	return polygon;
+}
+
+const std::vector<Point2>& NoFitPolygon::get_touching_translations() const {
+	return polygon.get_vertices();
+}
+
+bool NoFitPolygon::overlaps(const Point2& translation) const {
+	return polygon.contains(translation);
+}
+
+bool NoFitPolygon::exit_distance(const Point2& origin, const double direction_x, const double direction_y, double& distance) const {
+	const std::vector<Point2>& vertices = polygon.get_vertices();
+	if(vertices.size() < 3) {
+		return false; //Has no interior to go through.
+	}
+
+	//The no-fit polygon is the intersection of the half-planes to the left of its edges. Clip the line with each of them.
+	double lowest = std::numeric_limits<double>::lowest();
+	double highest = std::numeric_limits<double>::max();
+	for(size_t i = 0; i < vertices.size(); ++i) {
+		const Point2& start = vertices[i];
+		const Point2& end = vertices[(i + 1) % vertices.size()];
+		const double edge_x = static_cast<double>(end.x) - start.x;
+		const double edge_y = static_cast<double>(end.y) - start.y;
+		//How far the line is to the left of the edge at the origin, and how fast that changes along the line.
+		const double left_at_origin = edge_x * (static_cast<double>(origin.y) - start.y) - edge_y * (static_cast<double>(origin.x) - start.x);
+		const double left_change = edge_x * direction_y - edge_y * direction_x;
+		if(left_change > 0) {
+			lowest = std::max(lowest, -left_at_origin / left_change);
+		} else if(left_change < 0) {
+			highest = std::min(highest, -left_at_origin / left_change);
+		} else if(left_at_origin <= 0) { //Parallel to this edge, and not to the left of it.
+			return false;
+		}
+	}
+	if(lowest >= highest) {
+		return false;
+	}
+	distance = highest;
+	return true;
+}
+
+}
\ No newline at end of file
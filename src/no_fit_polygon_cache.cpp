@@ -0,0 +1,138 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <functional> //To hash the parts of the keys.
+
+#include "convex_polygon.hpp" //To get the shapes of the convex polygons.
+#include "no_fit_polygon.hpp" //To compute the no-fit polygons that are not cached yet.
+#include "no_fit_polygon_cache.hpp" //The definitions we're implementing here.
+#include "statistics.hpp" //To count the hits and misses of the packing that is looking up no-fit polygons.
+
+namespace convack {
+
+NoFitPolygonCache::NoFitPolygonCache(const size_t capacity) : capacity(capacity), hits(0), misses(0) {}
+
+std::shared_ptr<const NoFitPolygon> NoFitPolygonCache::get(const ConvexPolygon& stationary, const size_t stationary_rotation, const ConvexPolygon& orbiting, const size_t orbiting_rotation, Point2& translation) {
+	return get(stationary, stationary, stationary_rotation, orbiting, orbiting_rotation, translation);
+}
+
+std::shared_ptr<const NoFitPolygon> NoFitPolygonCache::get(const ConvexPolygon& stationary, const ConvexPolygon& stationary_shape, const size_t stationary_rotation, const ConvexPolygon& orbiting, const size_t orbiting_rotation, Point2& translation) {
+	const Point2 shape_anchor = anchor(stationary_shape);
+	const Point2 orbiting_anchor = anchor(orbiting);
+	translation = anchor(stationary) - orbiting_anchor;
+	const Key key = {stationary.uid(), stationary_rotation, orbiting.uid(), orbiting_rotation};
+	const Point2 stationary_edge = first_edge(stationary_shape);
+	const Point2 orbiting_edge = first_edge(orbiting);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		const auto found = lookup.find(key);
+		if(found != lookup.end() && same_rotation(found->second->stationary_edge, stationary_edge) && same_rotation(found->second->orbiting_edge, orbiting_edge)) {
+			++hits;
+			++Statistics::local().cache_hits; //Always counted, unlike the operations counted with CONVACK_COUNT. This is cheap compared to the lookup.
+			entries.splice(entries.begin(), entries, found->second); //Now it's the most recently used.
+			return entries.front().no_fit_polygon;
+		}
+		++misses;
+	}
+	++Statistics::local().cache_misses;
+
+	//Compute the no-fit polygon outside of the lock, so that other threads can use the cache in the meanwhile.
+	ConvexPolygon anchored_stationary(stationary_shape); //Not the translated copy, so that the result doesn't depend on which copy came first.
+	anchored_stationary.translate(-shape_anchor.x, -shape_anchor.y);
+	ConvexPolygon anchored_orbiting(orbiting);
+	anchored_orbiting.translate(-orbiting_anchor.x, -orbiting_anchor.y);
+	const std::shared_ptr<const NoFitPolygon> no_fit_polygon = std::make_shared<const NoFitPolygon>(anchored_stationary, anchored_orbiting);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if(capacity == 0) {
+		return no_fit_polygon;
+	}
+	const auto found = lookup.find(key);
+	if(found != lookup.end()) { //Another thread computed it as well in the meanwhile, or the cached one was for a different rotation.
+		entries.erase(found->second);
+		lookup.erase(found);
+	}
+	entries.push_front({key, stationary_edge, orbiting_edge, no_fit_polygon});
+	lookup[key] = entries.begin();
+	evict();
+	return no_fit_polygon;
+}
+
+void NoFitPolygonCache::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+	lookup.clear();
+}
+
+size_t NoFitPolygonCache::get_capacity() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return capacity;
+}
+
+void NoFitPolygonCache::set_capacity(const size_t new_capacity) {
+	std::lock_guard<std::mutex> lock(mutex);
+	capacity = new_capacity;
+	evict();
+}
+
+size_t NoFitPolygonCache::size() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return entries.size();
+}
+
+size_t NoFitPolygonCache::get_hits() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return hits;
+}
+
+size_t NoFitPolygonCache::get_misses() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return misses;
+}
+
+bool NoFitPolygonCache::Key::operator ==(const Key& other) const {
+	return stationary_uid == other.stationary_uid && stationary_rotation == other.stationary_rotation && orbiting_uid == other.orbiting_uid && orbiting_rotation == other.orbiting_rotation;
+}
+
+size_t NoFitPolygonCache::KeyHash::operator ()(const Key& key) const {
+	//Combine the hashes of the parts the same way as boost::hash_combine does.
+	size_t result = std::hash<uint64_t>()(key.stationary_uid);
+	result ^= std::hash<size_t>()(key.stationary_rotation) + 0x9e3779b9 + (result << 6) + (result >> 2);
+	result ^= std::hash<uint64_t>()(key.orbiting_uid) + 0x9e3779b9 + (result << 6) + (result >> 2);
+	result ^= std::hash<size_t>()(key.orbiting_rotation) + 0x9e3779b9 + (result << 6) + (result >> 2);
+	return result;
+}
+
+Point2 NoFitPolygonCache::anchor(const ConvexPolygon& convex_polygon) {
+	const std::vector<Point2>& vertices = convex_polygon.get_vertices();
+	if(vertices.empty()) {
+		return Point2(0, 0);
+	}
+	return vertices[0];
+}
+
+Point2 NoFitPolygonCache::first_edge(const ConvexPolygon& convex_polygon) {
+	const std::vector<Point2>& vertices = convex_polygon.get_vertices();
+	if(vertices.size() < 2) {
+		return Point2(0, 0);
+	}
+	return vertices[1] - vertices[0];
+}
+
+bool NoFitPolygonCache::same_rotation(const Point2& edge, const Point2& other_edge) {
+	//Translating a convex polygon shifts the rounding of its coordinates, so the edges of copies can differ by a tiny bit.
+	const double tolerance = static_cast<double>(edge.magnitude2()) * rotation_tolerance * rotation_tolerance;
+	return (edge - other_edge).magnitude2() <= tolerance;
+}
+
+void NoFitPolygonCache::evict() {
+	while(entries.size() > capacity) {
+		lookup.erase(entries.back().key);
+		entries.pop_back();
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <algorithm> //For std::max.
+#include <mutex> //To collect the statistics of multiple threads.
+
+#include "pack_statistics.hpp" //The definitions we're implementing here.
+#include "statistics.hpp" //To keep the counters of each thread.
+
+namespace convack {
+
+PackStatistics::PackStatistics() {
+	clear();
+}
+
+PackStatistics& PackStatistics::operator +=(const PackStatistics& other) {
+	candidates_generated += other.candidates_generated;
+	candidates_pruned += other.candidates_pruned;
+	score_evaluations += other.score_evaluations;
+	hull_computations += other.hull_computations;
+	collision_tests += other.collision_tests;
+	bounding_box_early_outs += other.bounding_box_early_outs;
+	cache_hits += other.cache_hits;
+	cache_misses += other.cache_misses;
+	allocations += other.allocations;
+	budget_exhausted = budget_exhausted || other.budget_exhausted;
+	depth_times.resize(std::max(depth_times.size(), other.depth_times.size()), 0);
+	for(size_t depth = 0; depth < other.depth_times.size(); ++depth) {
+		depth_times[depth] += other.depth_times[depth];
+	}
+	return *this;
+}
+
+void PackStatistics::clear() {
+	candidates_generated = 0;
+	candidates_pruned = 0;
+	score_evaluations = 0;
+	hull_computations = 0;
+	collision_tests = 0;
+	bounding_box_early_outs = 0;
+	cache_hits = 0;
+	cache_misses = 0;
+	allocations = 0;
+	depth_times.clear();
+	budget_exhausted = false;
+}
+
+std::ostream& operator <<(std::ostream& output_stream, const PackStatistics& statistics) {
+	output_stream << "candidates generated: " << statistics.candidates_generated << "\n";
+	output_stream << "candidates pruned: " << statistics.candidates_pruned << "\n";
+	output_stream << "score evaluations: " << statistics.score_evaluations << "\n";
+	output_stream << "hull computations: " << statistics.hull_computations << "\n";
+	output_stream << "collision tests: " << statistics.collision_tests << "\n";
+	output_stream << "bounding box early-outs: " << statistics.bounding_box_early_outs << "\n";
+	output_stream << "cache hits: " << statistics.cache_hits << "\n";
+	output_stream << "cache misses: " << statistics.cache_misses << "\n";
+	output_stream << "allocations: " << statistics.allocations << "\n";
+	output_stream << "budget exhausted: " << (statistics.budget_exhausted ? "yes" : "no") << "\n";
+	output_stream << "depth times:";
+	for(const double time : statistics.depth_times) {
+		output_stream << " " << time;
+	}
+	return output_stream;
+}
+
+PackStatistics& Statistics::local() {
+	thread_local PackStatistics statistics;
+	return statistics;
+}
+
+void Statistics::collect(PackStatistics& total) {
+	static std::mutex mutex; //Multiple threads may finish at the same time.
+	PackStatistics& statistics = local();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		total += statistics;
+	}
+	statistics.clear();
+}
+
+}
\ No newline at end of file
@@ -17,6 +17,10 @@ bool Point2::operator !=(const Point2& other) const {
 	return !(*this == other);
 }
 
+Point2 Point2::operator +(const Point2& other) const {
+	return Point2(x + other.x, y + other.y);
+}
+
 Point2 Point2::operator -(const Point2& other) const {
 	return Point2(x - other.x, y - other.y);
 }
@@ -26,11 +30,11 @@ std::ostream& operator <<(std::ostream& output_stream, const Point2& point) {
 }
 
 area_t Point2::dot(const Point2& other) const {
-	return x * other.x + y * other.y;
+	return static_cast<area_t>(x) * other.x + static_cast<area_t>(y) * other.y; //Widen first, so that integer coordinates don't overflow.
 }
 
 area_t Point2::magnitude2() const {
-	return x * x + y * y;
+	return static_cast<area_t>(x) * x + static_cast<area_t>(y) * y;
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <ios> //To write the timestamps in fixed notation.
+
+#include "profiling.hpp" //The definitions we're implementing here.
+
+namespace convack {
+
+std::deque<Profiler::Thread> Profiler::threads;
+std::mutex Profiler::threads_mutex;
+
+void Profiler::record(const char* name, const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end) {
+	local().events.push_back({name, start, end});
+}
+
+void Profiler::write_trace(std::ostream& output_stream) {
+	std::lock_guard<std::mutex> lock(threads_mutex);
+	const std::ios::fmtflags original_flags = output_stream.flags(); //The timestamps are written with fixed notation. Restore the caller's notation afterwards.
+	output_stream << std::fixed;
+	output_stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool first = true;
+	for(const Thread& thread : threads) {
+		for(const Event& event : thread.events) {
+			//Complete events ("X"), with their start and duration in microseconds.
+			const double start = std::chrono::duration<double, std::micro>(event.start.time_since_epoch()).count();
+			const double duration = std::chrono::duration<double, std::micro>(event.end - event.start).count();
+			output_stream << (first ? "\n" : ",\n");
+			output_stream << "{\"name\":\"" << event.name << "\",\"cat\":\"convack\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.id << ",\"ts\":" << start << ",\"dur\":" << duration << "}";
+			first = false;
+		}
+	}
+	output_stream << "\n]}\n";
+	output_stream.flags(original_flags);
+}
+
+void Profiler::clear() {
+	std::lock_guard<std::mutex> lock(threads_mutex);
+	for(Thread& thread : threads) {
+		thread.events.clear(); //Keep the threads themselves, since they still refer to their entry.
+	}
+}
+
+size_t Profiler::size() {
+	std::lock_guard<std::mutex> lock(threads_mutex);
+	size_t result = 0;
+	for(const Thread& thread : threads) {
+		result += thread.events.size();
+	}
+	return result;
+}
+
+Profiler::Thread& Profiler::local() {
+	thread_local Thread* thread = nullptr;
+	if(!thread) {
+		std::lock_guard<std::mutex> lock(threads_mutex);
+		threads.push_back({threads.size() + 1, std::vector<Event>()});
+		thread = &threads.back();
+	}
+	return *thread;
+}
+
+ProfileZone::ProfileZone(const char* name) : name(name), start(std::chrono::steady_clock::now()) {}
+
+ProfileZone::~ProfileZone() {
+	Profiler::record(name, start, std::chrono::steady_clock::now());
+}
+
+}
\ No newline at end of file
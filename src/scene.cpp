@@ -3,13 +3,23 @@
  * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
  */
 
+#include <algorithm> //For std::min and std::max.
+#include <atomic> //To distribute the packings of a batch over threads.
+#include <memory> //To share the task of an asynchronous packing with the executor.
+#include <mutex> //To share the memory for candidates between packings.
+#include <thread> //To pack batches on multiple threads.
+
 #include "beam/beam_search.hpp" //To pack polyons using the beam searching algorithm.
+#include "beam/candidate_arena.hpp" //To store the candidates of the search between packing calls.
+#include "bounding_box.hpp" //To size the cells of the obstacle index.
+#include "layout.hpp" //To continue packing from the convex polygons placed earlier.
+#include "no_fit_polygon_cache.hpp" //To reuse no-fit polygons between packing calls.
+#include "pack_statistics.hpp" //To report what the packing spent its time on.
 #include "scene.hpp" //The definitions of the implementation defined here.
+#include "spatial_index.hpp" //To index the obstacles.
 
 namespace convack {
 
-class ConvexPolygon;
-
 class Scene::Impl {
 public:
 	/*!
@@ -18,15 +28,127 @@ public:
 	 * implementation of.
 	 */
 	Impl(Scene& scene) :
-			scene(scene),
-			beam_width(10) {
+			beam_width(10),
+			num_threads(1),
+			rotations({0}),
+			time_budget(0),
+			evaluation_budget(0),
+			deterministic(false),
+			container(std::vector<Point2>()),
+			obstacle_index(1),
+			scene(scene) {
 	}
 
 	/*! @copydoc Scene::pack(std::vector<ConvexPolygon>&) const
 	 */
 	void pack(std::vector<ConvexPolygon>& convex_polygons) const {
+		PackStatistics statistics; //Not reported.
+		pack(convex_polygons, statistics);
+	}
+
+	/*! @copydoc Scene::pack(std::vector<ConvexPolygon>&, PackStatistics&) const
+	 */
+	void pack(std::vector<ConvexPolygon>& convex_polygons, PackStatistics& statistics) const {
+		statistics.clear();
 		//Choose which algorithm to use. In this case we only have one so far, but we'd like to keep the architecture open to more.
-		BeamSearch::pack(scene, convex_polygons);
+		std::unique_lock<std::mutex> arena_lock(arena_mutex, std::try_to_lock);
+		CandidateArena own_arena; //If another packing is using the arena of the scene, use a new one. It doesn't allocate anything until it's used.
+		BeamSearch::pack(scene, convex_polygons, arena_lock.owns_lock() ? arena : own_arena, no_fit_polygon_cache, statistics, num_threads); //Also counts the cache hits and misses of this packing. Other packings may use the cache at the same time.
+	}
+
+	/*! @copydoc Scene::pack_more(std::vector<ConvexPolygon>&)
+	 */
+	void pack_more(std::vector<ConvexPolygon>& convex_polygons) {
+		PackStatistics statistics; //Not reported.
+		pack_more(convex_polygons, statistics);
+	}
+
+	/*! @copydoc Scene::pack_more(std::vector<ConvexPolygon>&, PackStatistics&)
+	 */
+	void pack_more(std::vector<ConvexPolygon>& convex_polygons, PackStatistics& statistics) {
+		statistics.clear();
+		std::unique_lock<std::mutex> arena_lock(arena_mutex, std::try_to_lock);
+		CandidateArena own_arena; //If another packing is using the arena of the scene, use a new one. It doesn't allocate anything until it's used.
+		BeamSearch::pack_more(scene, convex_polygons, layout, arena_lock.owns_lock() ? arena : own_arena, no_fit_polygon_cache, statistics, num_threads); //Also counts the cache hits and misses of this packing.
+	}
+
+	/*! @copydoc Scene::get_layout() const
+	 */
+	const Layout& get_layout() const {
+		return layout;
+	}
+
+	/*! @copydoc Scene::clear_layout()
+	 */
+	void clear_layout() {
+		layout.clear();
+	}
+
+	/*! @copydoc Scene::pack_batch(std::vector<std::vector<ConvexPolygon>>&) const
+	 */
+	void pack_batch(std::vector<std::vector<ConvexPolygon>>& batch) const {
+		PackStatistics statistics; //Not reported.
+		pack_batch(batch, statistics);
+	}
+
+	/*! @copydoc Scene::pack_batch(std::vector<std::vector<ConvexPolygon>>&, PackStatistics&) const
+	 */
+	void pack_batch(std::vector<std::vector<ConvexPolygon>>& batch, PackStatistics& statistics) const {
+		statistics.clear();
+
+		size_t num_workers = num_threads;
+		if(num_workers == 0) { //Use all processor cores.
+			num_workers = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+		num_workers = std::max(std::min(num_workers, batch.size()), size_t(1)); //More threads than packings would have nothing to do.
+
+		std::atomic<size_t> next_job(0);
+		std::vector<PackStatistics> worker_statistics(num_workers);
+		const std::function<void(size_t)> work = [this, &batch, &next_job, &worker_statistics](const size_t worker) {
+			CandidateArena worker_arena; //Reused for all packings of this thread.
+			PackStatistics job_statistics;
+			for(size_t job = next_job++; job < batch.size(); job = next_job++) {
+				job_statistics.clear();
+				BeamSearch::pack(scene, batch[job], worker_arena, no_fit_polygon_cache, job_statistics, 1);
+				worker_statistics[worker] += job_statistics;
+			}
+		};
+		std::vector<std::thread> workers;
+		workers.reserve(num_workers - 1);
+		for(size_t worker = 1; worker < num_workers; ++worker) {
+			workers.emplace_back(work, worker);
+		}
+		work(0); //The current thread helps out too.
+		for(std::thread& worker : workers) {
+			worker.join();
+		}
+
+		for(const PackStatistics& worker_statistic : worker_statistics) {
+			statistics += worker_statistic; //Including the cache hits and misses of the packings in this batch, but not those of other packings using the cache at the same time.
+		}
+	}
+
+	/*! @copydoc Scene::pack_async(std::vector<ConvexPolygon>, const ProgressCallback&, const Cancellation&, const Executor&) const
+	 */
+	std::future<std::vector<ConvexPolygon>> pack_async(std::vector<ConvexPolygon> convex_polygons, const ProgressCallback& progress, const Cancellation& cancellation, const Executor& executor) const {
+		//Lambdas can't capture by moving in C++11, so share the convex polygons with the task instead of copying them once more.
+		std::shared_ptr<std::vector<ConvexPolygon>> job = std::make_shared<std::vector<ConvexPolygon>>(std::move(convex_polygons));
+		const std::function<std::vector<ConvexPolygon>()> task = [this, job, progress, cancellation]() {
+			CandidateArena job_arena; //The arena of the scene may be in use by another packing.
+			PackStatistics statistics; //Not reported.
+			BeamSearch::pack(scene, *job, job_arena, no_fit_polygon_cache, statistics, num_threads, progress, cancellation);
+			return std::move(*job);
+		};
+
+		if(!executor) {
+			return std::async(std::launch::async, task);
+		}
+		std::shared_ptr<std::packaged_task<std::vector<ConvexPolygon>()>> packaged = std::make_shared<std::packaged_task<std::vector<ConvexPolygon>()>>(task);
+		std::future<std::vector<ConvexPolygon>> result = packaged->get_future();
+		executor([packaged]() {
+			(*packaged)();
+		});
+		return result;
 	}
 
 	/*! @copydoc Scene::set_beam_width(const size_t)
@@ -41,6 +163,137 @@ public:
 		return beam_width;
 	}
 
+	/*! @copydoc Scene::set_num_threads(const size_t)
+	 */
+	void set_num_threads(const size_t new_num_threads) {
+		num_threads = new_num_threads;
+	}
+
+	/*! @copydoc Scene::get_num_threads() const
+	 */
+	size_t get_num_threads() const {
+		return num_threads;
+	}
+
+	/*! @copydoc Scene::set_rotations(const std::vector<double>&)
+	 */
+	void set_rotations(const std::vector<double>& new_rotations) {
+		rotations = new_rotations;
+	}
+
+	/*! @copydoc Scene::get_rotations() const
+	 */
+	const std::vector<double>& get_rotations() const {
+		return rotations;
+	}
+
+	/*! @copydoc Scene::set_time_budget(const double)
+	 */
+	void set_time_budget(const double new_time_budget) {
+		time_budget = new_time_budget;
+	}
+
+	/*! @copydoc Scene::get_time_budget() const
+	 */
+	double get_time_budget() const {
+		return time_budget;
+	}
+
+	/*! @copydoc Scene::set_evaluation_budget(const size_t)
+	 */
+	void set_evaluation_budget(const size_t new_evaluation_budget) {
+		evaluation_budget = new_evaluation_budget;
+	}
+
+	/*! @copydoc Scene::get_evaluation_budget() const
+	 */
+	size_t get_evaluation_budget() const {
+		return evaluation_budget;
+	}
+
+	/*! @copydoc Scene::set_deterministic(const bool)
+	 */
+	void set_deterministic(const bool new_deterministic) {
+		deterministic = new_deterministic;
+	}
+
+	/*! @copydoc Scene::is_deterministic() const
+	 */
+	bool is_deterministic() const {
+		return deterministic;
+	}
+
+	/*! @copydoc Scene::set_container(const ConvexPolygon&)
+	 */
+	void set_container(const ConvexPolygon& new_container) {
+		container = new_container;
+		container.set_lazy(false); //The threads of a packing read it at the same time, so its vertices must not be filled in lazily.
+	}
+
+	/*! @copydoc Scene::get_container() const
+	 */
+	const ConvexPolygon& get_container() const {
+		return container;
+	}
+
+	/*! @copydoc Scene::set_obstacles(const std::vector<ConvexPolygon>&)
+	 */
+	void set_obstacles(const std::vector<ConvexPolygon>& new_obstacles) {
+		obstacles = new_obstacles;
+		for(ConvexPolygon& obstacle : obstacles) {
+			obstacle.set_lazy(false); //The threads of a packing read them at the same time, so their vertices must not be filled in lazily.
+		}
+
+		//Like for the packing, the cells of the index are as large as the obstacles on average.
+		coordinate_t total_size = 0;
+		for(const ConvexPolygon& obstacle : obstacles) {
+			const BoundingBox& bounding_box = obstacle.get_bounding_box();
+			if(!bounding_box.empty()) {
+				total_size += std::max(bounding_box.maximum.x - bounding_box.minimum.x, bounding_box.maximum.y - bounding_box.minimum.y);
+			}
+		}
+		obstacle_index = SpatialIndex(obstacles.empty() ? 1 : total_size / obstacles.size());
+		for(const ConvexPolygon& obstacle : obstacles) {
+			obstacle_index.insert(&obstacle);
+		}
+	}
+
+	/*! @copydoc Scene::get_obstacles() const
+	 */
+	const std::vector<ConvexPolygon>& get_obstacles() const {
+		return obstacles;
+	}
+
+	/*! @copydoc Scene::get_obstacle_index() const
+	 */
+	const SpatialIndex& get_obstacle_index() const {
+		return obstacle_index;
+	}
+
+	/*! @copydoc Scene::set_cache_size(const size_t)
+	 */
+	void set_cache_size(const size_t new_cache_size) {
+		no_fit_polygon_cache.set_capacity(new_cache_size);
+	}
+
+	/*! @copydoc Scene::get_cache_size() const
+	 */
+	size_t get_cache_size() const {
+		return no_fit_polygon_cache.get_capacity();
+	}
+
+	/*! @copydoc Scene::get_cache_hits() const
+	 */
+	size_t get_cache_hits() const {
+		return no_fit_polygon_cache.get_hits();
+	}
+
+	/*! @copydoc Scene::get_cache_misses() const
+	 */
+	size_t get_cache_misses() const {
+		return no_fit_polygon_cache.get_misses();
+	}
+
 private:
 	/*!
 	 * How wide the beam search is searching through sub-optimal choices.
@@ -61,6 +314,93 @@ private:
 	 */
 	size_t beam_width;
 
+	/*!
+	 * How many threads the beam search may use to expand its beam.
+	 *
+	 * If this is 0, the beam search uses as many threads as there are
+	 * processor cores.
+	 */
+	size_t num_threads;
+
+	/*!
+	 * The angles that the convex polygons may be rotated over to pack them, in
+	 * radians.
+	 */
+	std::vector<double> rotations;
+
+	/*!
+	 * How many seconds the packing may take, or 0 if there is no limit.
+	 */
+	double time_budget;
+
+	/*!
+	 * How many candidate placements the packing may evaluate, or 0 if there is
+	 * no limit.
+	 */
+	size_t evaluation_budget;
+
+	/*!
+	 * Whether the packing must not depend on the speed of the computer or the
+	 * number of threads.
+	 */
+	bool deterministic;
+
+	/*!
+	 * The convex polygon that the packing must fit in, or an empty convex
+	 * polygon if the packing may grow in any direction.
+	 */
+	ConvexPolygon container;
+
+	/*!
+	 * The convex polygons that stay in place, around which the others are
+	 * packed.
+	 */
+	std::vector<ConvexPolygon> obstacles;
+
+	/*!
+	 * An index of the obstacles, to quickly test placements for collisions
+	 * with them.
+	 *
+	 * This refers to the obstacles in \ref obstacles, so it is rebuilt
+	 * whenever those change.
+	 */
+	SpatialIndex obstacle_index;
+
+	/*!
+	 * The convex polygons placed by \ref pack_more so far, which the next call
+	 * continues from.
+	 */
+	Layout layout;
+
+	/*!
+	 * Memory to store the candidates of the beam search in.
+	 *
+	 * This is kept between calls to \ref pack, so that the memory allocated
+	 * for one packing can be reused by the next one. Since this is only a
+	 * cache of memory, it may be modified during the packing even though the
+	 * scene itself is not modified.
+	 *
+	 * Only one packing at a time can use it. See \ref arena_mutex.
+	 */
+	mutable CandidateArena arena;
+
+	/*!
+	 * Held by the packing that is using the \ref arena.
+	 *
+	 * Packings that find it taken use an arena of their own instead, so that
+	 * multiple packings can run at the same time in one scene.
+	 */
+	mutable std::mutex arena_mutex;
+
+	/*!
+	 * The no-fit polygons computed during packing.
+	 *
+	 * This is kept between calls to \ref pack, so that packing the same shapes
+	 * again doesn't need to compute their no-fit polygons again. Like the
+	 * arena, this is only a cache, so it may be modified during the packing.
+	 */
+	mutable NoFitPolygonCache no_fit_polygon_cache;
+
 	/*!
 	 * A reference to the encapsulating public interface. The `Scene`.
 	 *
@@ -78,6 +418,38 @@ void Scene::pack(std::vector<ConvexPolygon>& convex_polygons) const {
 	pimpl->pack(convex_polygons);
 }
 
+void Scene::pack(std::vector<ConvexPolygon>& convex_polygons, PackStatistics& statistics) const {
+	pimpl->pack(convex_polygons, statistics);
+}
+
+void Scene::pack_more(std::vector<ConvexPolygon>& convex_polygons) {
+	pimpl->pack_more(convex_polygons);
+}
+
+void Scene::pack_more(std::vector<ConvexPolygon>& convex_polygons, PackStatistics& statistics) {
+	pimpl->pack_more(convex_polygons, statistics);
+}
+
+const Layout& Scene::get_layout() const {
+	return pimpl->get_layout();
+}
+
+void Scene::clear_layout() {
+	pimpl->clear_layout();
+}
+
+void Scene::pack_batch(std::vector<std::vector<ConvexPolygon>>& batch) const {
+	pimpl->pack_batch(batch);
+}
+
+void Scene::pack_batch(std::vector<std::vector<ConvexPolygon>>& batch, PackStatistics& statistics) const {
+	pimpl->pack_batch(batch, statistics);
+}
+
+std::future<std::vector<ConvexPolygon>> Scene::pack_async(std::vector<ConvexPolygon> convex_polygons, const ProgressCallback& progress, const Cancellation& cancellation, const Executor& executor) const {
+	return pimpl->pack_async(std::move(convex_polygons), progress, cancellation, executor);
+}
+
 void Scene::set_beam_width(const size_t new_beam_width) {
 	pimpl->set_beam_width(new_beam_width);
 }
@@ -86,4 +458,80 @@ size_t Scene::get_beam_width() const {
 	return pimpl->get_beam_width();
 }
 
+void Scene::set_num_threads(const size_t new_num_threads) {
+	pimpl->set_num_threads(new_num_threads);
+}
+
+size_t Scene::get_num_threads() const {
+	return pimpl->get_num_threads();
+}
+
+void Scene::set_rotations(const std::vector<double>& new_rotations) {
+	pimpl->set_rotations(new_rotations);
+}
+
+const std::vector<double>& Scene::get_rotations() const {
+	return pimpl->get_rotations();
+}
+
+void Scene::set_time_budget(const double new_time_budget) {
+	pimpl->set_time_budget(new_time_budget);
+}
+
+double Scene::get_time_budget() const {
+	return pimpl->get_time_budget();
+}
+
+void Scene::set_evaluation_budget(const size_t new_evaluation_budget) {
+	pimpl->set_evaluation_budget(new_evaluation_budget);
+}
+
+size_t Scene::get_evaluation_budget() const {
+	return pimpl->get_evaluation_budget();
+}
+
+void Scene::set_deterministic(const bool new_deterministic) {
+	pimpl->set_deterministic(new_deterministic);
+}
+
+bool Scene::is_deterministic() const {
+	return pimpl->is_deterministic();
+}
+
+void Scene::set_container(const ConvexPolygon& new_container) {
+	pimpl->set_container(new_container);
+}
+
+const ConvexPolygon& Scene::get_container() const {
+	return pimpl->get_container();
+}
+
+void Scene::set_obstacles(const std::vector<ConvexPolygon>& new_obstacles) {
+	pimpl->set_obstacles(new_obstacles);
+}
+
+const std::vector<ConvexPolygon>& Scene::get_obstacles() const {
+	return pimpl->get_obstacles();
+}
+
+const SpatialIndex& Scene::get_obstacle_index() const {
+	return pimpl->get_obstacle_index();
+}
+
+void Scene::set_cache_size(const size_t new_cache_size) {
+	pimpl->set_cache_size(new_cache_size);
+}
+
+size_t Scene::get_cache_size() const {
+	return pimpl->get_cache_size();
+}
+
+size_t Scene::get_cache_hits() const {
+	return pimpl->get_cache_hits();
+}
+
+size_t Scene::get_cache_misses() const {
+	return pimpl->get_cache_misses();
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <algorithm> //To sort and deduplicate the results of queries.
+#include <cmath> //To round coordinates down to cells.
+
+#include "bounding_box.hpp" //To find which cells convex polygons are in.
+#include "convex_polygon.hpp" //To test for collisions.
+#include "spatial_index.hpp" //The definitions we're implementing here.
+
+namespace convack {
+
+constexpr int64_t SpatialIndex::max_cells_per_polygon;
+
+SpatialIndex::SpatialIndex(const coordinate_t cell_size) : cell_size(cell_size > 0 ? cell_size : 1) {}
+
+void SpatialIndex::insert(const ConvexPolygon* convex_polygon) {
+	const size_t index = convex_polygons.size();
+	convex_polygons.push_back(convex_polygon);
+	const BoundingBox& bounding_box = convex_polygon->get_bounding_box();
+	if(bounding_box.empty()) {
+		return; //Can't overlap with anything, so doesn't need to be in any cell.
+	}
+
+	int64_t min_x, min_y, max_x, max_y;
+	cell_range(bounding_box, min_x, min_y, max_x, max_y);
+	if((max_x - min_x + 1) * (max_y - min_y + 1) > max_cells_per_polygon) {
+		oversized.push_back(index);
+		return;
+	}
+	for(int64_t x = min_x; x <= max_x; ++x) {
+		for(int64_t y = min_y; y <= max_y; ++y) {
+			cells[key_of(x, y)].push_back(index);
+		}
+	}
+}
+
+void SpatialIndex::query(const BoundingBox& bounding_box, std::vector<const ConvexPolygon*>& result) const {
+	std::vector<size_t> found;
+	query(bounding_box, found);
+	for(const size_t index : found) {
+		result.push_back(convex_polygons[index]);
+	}
+}
+
+void SpatialIndex::query(const BoundingBox& bounding_box, std::vector<size_t>& result) const {
+	if(bounding_box.empty()) {
+		return;
+	}
+
+	//Gather the candidates at the end of the result, so that querying repeatedly into the same list doesn't need to allocate memory.
+	const size_t start = result.size();
+	result.insert(result.end(), oversized.begin(), oversized.end());
+	int64_t min_x, min_y, max_x, max_y;
+	cell_range(bounding_box, min_x, min_y, max_x, max_y);
+	if((max_x - min_x + 1) * (max_y - min_y + 1) > static_cast<int64_t>(cells.size())) {
+		//The query covers more cells than are in use. Then it's faster to go through the cells that are in use.
+		for(const std::pair<const uint64_t, std::vector<size_t>>& cell : cells) {
+			result.insert(result.end(), cell.second.begin(), cell.second.end());
+		}
+	} else {
+		for(int64_t x = min_x; x <= max_x; ++x) {
+			for(int64_t y = min_y; y <= max_y; ++y) {
+				const std::unordered_map<uint64_t, std::vector<size_t>>::const_iterator cell = cells.find(key_of(x, y));
+				if(cell != cells.end()) {
+					result.insert(result.end(), cell->second.begin(), cell->second.end());
+				}
+			}
+		}
+	}
+
+	//Convex polygons covering multiple cells are found multiple times.
+	std::sort(result.begin() + start, result.end());
+	result.erase(std::unique(result.begin() + start, result.end()), result.end());
+	result.erase(std::remove_if(result.begin() + start, result.end(), [this, &bounding_box](const size_t index) {
+		return !convex_polygons[index]->get_bounding_box().overlaps(bounding_box);
+	}), result.end());
+}
+
+bool SpatialIndex::collides(const ConvexPolygon& convex_polygon) const {
+	const BoundingBox& bounding_box = convex_polygon.get_bounding_box();
+	if(bounding_box.empty()) {
+		return false;
+	}
+	for(const size_t index : oversized) {
+		if(convex_polygons[index]->collides(convex_polygon)) {
+			return true;
+		}
+	}
+
+	//Rather than gathering the nearby convex polygons in a list like a query does, test them right away in the cells. That doesn't need any memory.
+	int64_t min_x, min_y, max_x, max_y;
+	cell_range(bounding_box, min_x, min_y, max_x, max_y);
+	if((max_x - min_x + 1) * (max_y - min_y + 1) > static_cast<int64_t>(cells.size())) {
+		//The convex polygon covers more cells than are in use. Then it's faster to go through the cells that are in use.
+		for(const std::pair<const uint64_t, std::vector<size_t>>& cell : cells) {
+			if(collides_in_cell(convex_polygon, cell.first, cell.second)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	for(int64_t x = min_x; x <= max_x; ++x) {
+		for(int64_t y = min_y; y <= max_y; ++y) {
+			const uint64_t key = key_of(x, y);
+			const std::unordered_map<uint64_t, std::vector<size_t>>::const_iterator cell = cells.find(key);
+			if(cell != cells.end() && collides_in_cell(convex_polygon, key, cell->second)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void SpatialIndex::clear() {
+	convex_polygons.clear();
+	for(std::pair<const uint64_t, std::vector<size_t>>& cell : cells) {
+		cell.second.clear(); //Keep the cell and its memory, in case something gets inserted there again.
+	}
+	oversized.clear();
+}
+
+size_t SpatialIndex::size() const {
+	return convex_polygons.size();
+}
+
+void SpatialIndex::cell_range(const BoundingBox& bounding_box, int64_t& min_x, int64_t& min_y, int64_t& max_x, int64_t& max_y) const {
+	min_x = cell_of(bounding_box.minimum.x);
+	min_y = cell_of(bounding_box.minimum.y);
+	max_x = cell_of(bounding_box.maximum.x);
+	max_y = cell_of(bounding_box.maximum.y);
+}
+
+int64_t SpatialIndex::cell_of(const coordinate_t coordinate) const {
+	//Clamp to the range that fits in half of the key, so that far away coordinates end up in the outermost cells rather than overflowing.
+	const double cell = std::floor(static_cast<double>(coordinate) / cell_size);
+	return static_cast<int64_t>(std::max(std::min(cell, double(INT32_MAX)), double(INT32_MIN)));
+}
+
+bool SpatialIndex::collides_in_cell(const ConvexPolygon& convex_polygon, const uint64_t key, const std::vector<size_t>& cell) const {
+	const BoundingBox& bounding_box = convex_polygon.get_bounding_box();
+	for(const size_t index : cell) {
+		const BoundingBox& other_box = convex_polygons[index]->get_bounding_box();
+		if(!other_box.overlaps(bounding_box)) {
+			continue;
+		}
+		//Both bounding boxes may cover multiple cells in common. Only test them in the cell with the minimum of their overlap, so that they are tested only once.
+		const int64_t overlap_x = cell_of(std::max(other_box.minimum.x, bounding_box.minimum.x));
+		const int64_t overlap_y = cell_of(std::max(other_box.minimum.y, bounding_box.minimum.y));
+		if(key_of(overlap_x, overlap_y) == key && convex_polygons[index]->collides(convex_polygon)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+uint64_t SpatialIndex::key_of(const int64_t x, const int64_t y) {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+}
\ No newline at end of file
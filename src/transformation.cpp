@@ -17,12 +17,31 @@ Transformation::Transformation() {
 	data = {1, 0, 0, 1, 0, 0};
 }
 
+Transformation::Transformation(const std::array<double, 6>& data) : data(data) {}
+
 bool Transformation::operator ==(const Transformation& other) const {
 	return data == other.data;
 }
 
+const std::array<double, 6>& Transformation::get_data() const {
+	return data;
+}
+
 Point2 Transformation::apply(const Point2& point) const {
-	return Point2(data[0] * point.x + data[2] * point.y + data[4], data[1] * point.x + data[3] * point.y + data[5]);
+	return Point2(to_coordinate(data[0] * point.x + data[2] * point.y + data[4]), to_coordinate(data[1] * point.x + data[3] * point.y + data[5]));
+}
+
+void Transformation::apply(std::vector<Point2>& points) const {
+	//Copy the matrix to local variables, so that the compiler knows that writing the points doesn't change them.
+	const double xx = data[0], xy = data[1], yx = data[2], yy = data[3], tx = data[4], ty = data[5];
+	Point2* point = points.data();
+	const size_t size = points.size();
+	for(size_t i = 0; i < size; ++i) {
+		const double x = point[i].x;
+		const double y = point[i].y;
+		point[i].x = to_coordinate(xx * x + yx * y + tx);
+		point[i].y = to_coordinate(xy * x + yy * y + ty);
+	}
 }
 
 Transformation& Transformation::rotate(const double angle_radians) {
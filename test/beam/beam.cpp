@@ -0,0 +1,179 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <gtest/gtest.h> //To run the test.
+
+#include "beam/beam.hpp" //The unit under test.
+#include "beam/candidate_arena.hpp" //To create candidates to put in the beam.
+#include "beam/packing_candidate.hpp" //To create candidates to put in the beam.
+#include "convex_polygon.hpp" //To create candidates with different scores.
+#include "point2.hpp" //To create polygons to test with.
+
+namespace convack {
+
+/*!
+ * A fixture with some candidates with different scores.
+ */
+class BeamFixture : public testing::Test {
+public:
+	/*!
+	 * The objects that the candidates are packing.
+	 */
+	std::vector<ConvexPolygon> packed_objects;
+
+	/*!
+	 * The memory to create the candidates in.
+	 */
+	CandidateArena arena;
+
+	/*!
+	 * A candidate that packs a single square, which has a perfect score of 0.
+	 */
+	PackingCandidate* best;
+
+	/*!
+	 * A candidate that packs two squares next to each other, which also has a
+	 * perfect score of 0.
+	 */
+	PackingCandidate* tied;
+
+	/*!
+	 * A candidate that packs two squares diagonally, with a score of one third.
+	 */
+	PackingCandidate* middle;
+
+	/*!
+	 * A candidate that packs two squares far apart, with the worst score.
+	 */
+	PackingCandidate* worst;
+
+	/*!
+	 * Executed before every test in order to create or reset the fixtures.
+	 */
+	void SetUp() {
+		packed_objects.assign({
+			ConvexPolygon({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)}),
+			ConvexPolygon({Point2(10, 0), Point2(20, 0), Point2(20, 10), Point2(10, 10)}),
+			ConvexPolygon({Point2(10, 10), Point2(20, 10), Point2(20, 20), Point2(10, 20)}),
+			ConvexPolygon({Point2(90, 90), Point2(100, 90), Point2(100, 100), Point2(90, 100)})
+		});
+		best = arena.create(&packed_objects, 0, packed_objects[0], nullptr);
+		tied = arena.create(&packed_objects, 1, packed_objects[1], best);
+		middle = arena.create(&packed_objects, 2, packed_objects[2], best);
+		worst = arena.create(&packed_objects, 3, packed_objects[3], best);
+	}
+};
+
+/*!
+ * Test that the fixture's candidates have the scores they are supposed to have.
+ */
+TEST_F(BeamFixture, FixtureScores) {
+	EXPECT_EQ(best->get_score(), 0);
+	EXPECT_EQ(tied->get_score(), 0);
+	EXPECT_LT(tied->get_score(), middle->get_score());
+	EXPECT_LT(middle->get_score(), worst->get_score());
+}
+
+/*!
+ * Test inserting candidates in a beam that is not full yet.
+ */
+TEST_F(BeamFixture, InsertNotFull) {
+	Beam beam(3);
+	EXPECT_TRUE(beam.empty()) << "The beam starts off empty.";
+	EXPECT_EQ(beam.insert(worst, 0), nullptr) << "There is still room, so nothing is rejected.";
+	EXPECT_EQ(beam.insert(middle, 1), nullptr) << "There is still room, so nothing is rejected.";
+	EXPECT_EQ(beam.size(), 2);
+	EXPECT_TRUE(beam.accepts(1000, 1000)) << "There is still room, so even a bad candidate is accepted.";
+}
+
+/*!
+ * Test that the beam never holds more than its capacity.
+ */
+TEST_F(BeamFixture, Capacity) {
+	Beam beam(2);
+	EXPECT_EQ(beam.get_capacity(), 2);
+	beam.insert(middle, 0);
+	beam.insert(tied, 1);
+	EXPECT_EQ(beam.insert(worst, 2), worst) << "The beam is full and the new candidate is the worst, so it gets rejected.";
+	EXPECT_EQ(beam.size(), 2) << "The beam must not grow beyond its capacity.";
+}
+
+/*!
+ * Test that a better candidate pushes the worst candidate out of a full beam.
+ */
+TEST_F(BeamFixture, PushOutWorst) {
+	Beam beam(2);
+	beam.insert(worst, 0);
+	beam.insert(middle, 1);
+	EXPECT_EQ(beam.insert(best, 2), worst) << "The worst candidate must make room for the better one.";
+	EXPECT_EQ(beam.size(), 2);
+}
+
+/*!
+ * Test asking the beam whether a candidate would be accepted once it's full.
+ */
+TEST_F(BeamFixture, AcceptsFull) {
+	Beam beam(2);
+	beam.insert(tied, 0);
+	beam.insert(middle, 1);
+	EXPECT_TRUE(beam.accepts(middle->get_score() / 2, 2)) << "Better than the worst candidate in the beam.";
+	EXPECT_FALSE(beam.accepts(worst->get_score(), 2)) << "Worse than all candidates in the beam.";
+	EXPECT_FALSE(beam.accepts(middle->get_score(), 2)) << "Equal score to the worst candidate, but a higher order number.";
+	EXPECT_TRUE(beam.accepts(middle->get_score(), 0)) << "Equal score to the worst candidate, and a lower order number.";
+}
+
+/*!
+ * Test that ties in the score are broken by the order number, regardless of the
+ * order of insertion.
+ */
+TEST_F(BeamFixture, TieBreak) {
+	Beam beam(1);
+	beam.insert(tied, 5);
+	EXPECT_EQ(beam.insert(best, 3), tied) << "Same score, but a lower order number, so it's better.";
+	EXPECT_EQ(beam.insert(tied, 5), tied) << "Same score, but a higher order number, so it's worse.";
+	ASSERT_EQ(beam.size(), 1);
+	EXPECT_EQ(beam.take()[0], best);
+}
+
+/*!
+ * Test taking the candidates out of the beam.
+ */
+TEST_F(BeamFixture, Take) {
+	Beam beam(4);
+	beam.insert(middle, 0);
+	beam.insert(worst, 1);
+	beam.insert(tied, 3);
+	beam.insert(best, 2);
+	const std::vector<PackingCandidate*> result = beam.take();
+	ASSERT_EQ(result.size(), 4);
+	EXPECT_EQ(result[0], best) << "The best score comes first, with the lowest order number among equal scores.";
+	EXPECT_EQ(result[1], tied);
+	EXPECT_EQ(result[2], middle);
+	EXPECT_EQ(result[3], worst);
+	EXPECT_TRUE(beam.empty()) << "Taking the candidates out leaves the beam empty.";
+}
+
+/*!
+ * Test merging the candidates of one beam into another.
+ */
+TEST_F(BeamFixture, Merge) {
+	Beam beam(2);
+	beam.insert(middle, 0);
+	beam.insert(worst, 1);
+	Beam other(2);
+	other.insert(best, 2);
+	other.insert(tied, 3);
+
+	std::vector<PackingCandidate*> rejected;
+	beam.merge(other, rejected);
+	EXPECT_TRUE(other.empty()) << "All candidates are moved out of the other beam.";
+	ASSERT_EQ(rejected.size(), 2) << "Two candidates didn't fit.";
+	const std::vector<PackingCandidate*> result = beam.take();
+	ASSERT_EQ(result.size(), 2);
+	EXPECT_EQ(result[0], best);
+	EXPECT_EQ(result[1], tied);
+}
+
+}
\ No newline at end of file
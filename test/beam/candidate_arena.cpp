@@ -0,0 +1,106 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <gtest/gtest.h> //To run the test.
+
+#include "beam/candidate_arena.hpp" //The unit under test.
+#include "convex_polygon.hpp" //To create candidates to store.
+#include "point2.hpp" //To create polygons to test with.
+
+namespace convack {
+
+/*!
+ * A fixture with some objects to create candidates with.
+ */
+class CandidateArenaFixture : public testing::Test {
+public:
+	/*!
+	 * The objects that the candidates are packing.
+	 */
+	std::vector<ConvexPolygon> packed_objects;
+
+	/*!
+	 * Executed before every test in order to create or reset the fixtures.
+	 */
+	void SetUp() {
+		packed_objects.assign({
+			ConvexPolygon({Point2(0, 0), Point2(50, 0), Point2(25, 50)}),
+			ConvexPolygon({Point2(50, 0), Point2(100, 0), Point2(75, 50)})
+		});
+	}
+};
+
+/*!
+ * Test creating a candidate in the arena.
+ */
+TEST_F(CandidateArenaFixture, Create) {
+	CandidateArena arena;
+	EXPECT_EQ(arena.size(), 0) << "The arena starts off empty.";
+
+	const PackingCandidate* candidate = arena.create(&packed_objects, 0, packed_objects[0], nullptr);
+	EXPECT_EQ(arena.size(), 1) << "One candidate was created.";
+	EXPECT_EQ(candidate->get_pack_here(), packed_objects[0]) << "The arguments must be passed on to the candidate.";
+}
+
+/*!
+ * Test creating more candidates than fit in a single block.
+ */
+TEST_F(CandidateArenaFixture, CreateManyBlocks) {
+	CandidateArena arena(4); //Small blocks, so that we need multiple.
+	std::vector<PackingCandidate*> candidates;
+	for(size_t i = 0; i < 10; ++i) {
+		candidates.push_back(arena.create(&packed_objects, 0, packed_objects[0], nullptr));
+	}
+	EXPECT_EQ(arena.size(), 10);
+	for(const PackingCandidate* candidate : candidates) {
+		EXPECT_EQ(candidate->get_depth(), 1) << "Candidates in earlier blocks must not be moved or overwritten.";
+	}
+}
+
+/*!
+ * Test that releasing a candidate reuses its memory for the next candidate.
+ */
+TEST_F(CandidateArenaFixture, ReleaseReuse) {
+	CandidateArena arena;
+	PackingCandidate* first = arena.create(&packed_objects, 0, packed_objects[0], nullptr);
+	arena.release(first);
+	EXPECT_EQ(arena.size(), 0) << "The candidate has no children, so it must be destroyed immediately.";
+
+	const PackingCandidate* second = arena.create(&packed_objects, 1, packed_objects[1], nullptr);
+	EXPECT_EQ(second, first) << "The memory of the released candidate must be reused.";
+}
+
+/*!
+ * Test that parents stay alive as long as their children need them.
+ */
+TEST_F(CandidateArenaFixture, ReleaseParent) {
+	CandidateArena arena;
+	PackingCandidate* parent = arena.create(&packed_objects, 0, packed_objects[0], nullptr);
+	PackingCandidate* child = arena.create(&packed_objects, 1, packed_objects[1], parent);
+
+	arena.release(parent);
+	EXPECT_EQ(arena.size(), 2) << "The parent must stay alive while the child is still necessary.";
+	EXPECT_EQ(child->get_parent()->get_pack_here(), packed_objects[0]) << "The parent must still be intact.";
+
+	arena.release(child);
+	EXPECT_EQ(arena.size(), 0) << "When the child is released, the parent is no longer necessary either.";
+}
+
+/*!
+ * Test resetting the arena.
+ */
+TEST_F(CandidateArenaFixture, Reset) {
+	CandidateArena arena(4);
+	for(size_t i = 0; i < 10; ++i) {
+		arena.create(&packed_objects, 0, packed_objects[0], nullptr);
+	}
+	arena.reset();
+	EXPECT_EQ(arena.size(), 0) << "All candidates must be destroyed.";
+
+	arena.create(&packed_objects, 0, packed_objects[0], nullptr);
+	EXPECT_EQ(arena.size(), 1) << "The arena can be used again after resetting.";
+}
+
+}
\ No newline at end of file
@@ -3,7 +3,10 @@
  * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
  */
 
+#include <algorithm> //To find the vertices of the core in the convex hull.
+#include <cmath> //To construct a circle.
 #include <gtest/gtest.h> //To run the test.
+#include <utility> //To move the convex hull into the candidate.
 
 #include "beam/packing_candidate.hpp" //The unit under test.
 #include "convex_polygon.hpp" //To create polygons to test with.
@@ -48,7 +51,7 @@ public:
  */
 TEST_F(PackingCandidateFixture, ComputeScoreSingle) {
 	const std::vector<ConvexPolygon> packed_objects({triangle});
-	PackingCandidate candidate(&packed_objects, triangle, nullptr);
+	PackingCandidate candidate(&packed_objects, 0, triangle, nullptr);
 
 	EXPECT_EQ(candidate.get_score(), 0) << "Since there is only one object to pack, the packing is perfect.";
 }
@@ -61,10 +64,128 @@ TEST_F(PackingCandidateFixture, ComputeScoreDouble) {
 		triangle,
 		triangle.translate(50, 0)
 	});
-	PackingCandidate parent(&packed_objects, packed_objects[0], nullptr);
-	PackingCandidate child(&packed_objects, packed_objects[1], &parent);
+	PackingCandidate parent(&packed_objects, 0, packed_objects[0], nullptr);
+	PackingCandidate child(&packed_objects, 1, packed_objects[1], &parent);
 
 	EXPECT_FLOAT_EQ(child.get_score(), 1.0 / 3.0) << "One triangle was shifted by exactly its baseline. That creates a void of exactly the same area as the triangle itself. The hull then contains two triangles and one void with the same size, so one third is waste.";
 }
 
+/*!
+ * Test that a candidate with a precomputed convex hull takes the areas and score
+ * it is given, and matches a candidate that computes them itself.
+ */
+TEST_F(PackingCandidateFixture, PrecomputedScore) {
+	const std::vector<ConvexPolygon> packed_objects({
+		triangle,
+		triangle.translate(50, 0)
+	});
+	PackingCandidate parent(&packed_objects, 0, packed_objects[0], nullptr);
+	const PackingCandidate computed(&packed_objects, 1, packed_objects[1], &parent);
+	ConvexPolygon convex_hull = PackingCandidate::merge_hull(&parent, packed_objects[1]);
+	const area_t covered_area = parent.get_covered_area() + packed_objects[1].area();
+	const area_t used_area = convex_hull.area();
+	const double score = PackingCandidate::compute_score(covered_area, used_area);
+	const PackingCandidate precomputed(&packed_objects, 1, packed_objects[1], &parent, std::move(convex_hull), 2, covered_area, used_area, score);
+
+	EXPECT_EQ(precomputed.get_covered_area(), computed.get_covered_area());
+	EXPECT_EQ(precomputed.get_used_area(), computed.get_used_area());
+	EXPECT_EQ(precomputed.get_score(), computed.get_score());
+	EXPECT_EQ(precomputed.get_pack_here_rotation(), 2);
+	EXPECT_EQ(precomputed.get_depth(), 2);
+}
+
+/*!
+ * Test that the convex hull and covered area are accumulated through a chain of
+ * three candidates.
+ */
+TEST_F(PackingCandidateFixture, AccumulateChain) {
+	const std::vector<ConvexPolygon> packed_objects({
+		triangle,
+		ConvexPolygon(triangle).translate(50, 0),
+		ConvexPolygon(triangle).translate(25, 50)
+	});
+	PackingCandidate root(&packed_objects, 0, packed_objects[0], nullptr);
+	PackingCandidate middle(&packed_objects, 1, packed_objects[1], &root);
+	PackingCandidate leaf(&packed_objects, 2, packed_objects[2], &middle);
+
+	EXPECT_EQ(root.get_convex_hull(), triangle) << "With only one object packed, the convex hull is that object itself.";
+	EXPECT_FLOAT_EQ(leaf.get_covered_area(), triangle.area() * 3) << "Three triangles were packed, so the covered area is three times the area of one.";
+	EXPECT_FLOAT_EQ(leaf.get_convex_hull().area(), triangle.area() * 4) << "The three triangles together form a bigger triangle with twice the size, and four times the area.";
+	EXPECT_EQ(leaf.get_depth(), 3) << "Three objects were packed in this chain.";
+	EXPECT_FLOAT_EQ(leaf.get_score(), 0.25) << "The bigger triangle has four times the area of one triangle, but only three are covered.";
+}
+
+/*!
+ * Test that the lower bound of the score of a root is perfect, since a single
+ * convex polygon could always score perfectly.
+ */
+TEST_F(PackingCandidateFixture, ScoreLowerBoundRoot) {
+	EXPECT_EQ(PackingCandidate::score_lower_bound(nullptr, triangle, triangle, triangle.area()), 0);
+}
+
+/*!
+ * Test that the core of a small convex hull is the convex hull itself.
+ */
+TEST_F(PackingCandidateFixture, HullCoreSmall) {
+	const std::vector<ConvexPolygon> packed_objects({triangle});
+	const PackingCandidate root(&packed_objects, 0, triangle, nullptr);
+	EXPECT_EQ(root.hull_core(), triangle) << "The triangle has fewer vertices than the core could have.";
+}
+
+/*!
+ * Test that the core of a big convex hull has only a few of its vertices.
+ */
+TEST_F(PackingCandidateFixture, HullCoreCircle) {
+	const double pi = std::acos(-1);
+	std::vector<Point2> vertices;
+	for(size_t i = 0; i < 100; ++i) {
+		vertices.emplace_back(std::cos(pi * 2 / 100 * i) * 100, std::sin(pi * 2 / 100 * i) * 100);
+	}
+	const std::vector<ConvexPolygon> packed_objects({ConvexPolygon(vertices)});
+	const PackingCandidate root(&packed_objects, 0, packed_objects[0], nullptr);
+	const ConvexPolygon core = root.hull_core();
+
+	EXPECT_LE(core.get_vertices().size(), 8) << "The core has at most one vertex for each direction.";
+	EXPECT_LE(core.area(), packed_objects[0].area()) << "The core is inside of the convex hull.";
+	EXPECT_GT(core.area(), packed_objects[0].area() * 0.85) << "The core still covers most of the convex hull, for a tight bound.";
+	for(const Point2& vertex : core.get_vertices()) {
+		EXPECT_NE(std::find(vertices.begin(), vertices.end(), vertex), vertices.end()) << "The core consists of vertices of the convex hull.";
+	}
+}
+
+/*!
+ * Test that the lower bound never exceeds the actual score of a child, for
+ * convex polygons placed at various distances from the packing.
+ */
+TEST_F(PackingCandidateFixture, ScoreLowerBoundAdmissible) {
+	std::vector<ConvexPolygon> packed_objects({triangle});
+	for(int i = 0; i < 10; ++i) {
+		packed_objects.push_back(ConvexPolygon(triangle).translate(i * 10, i * 7));
+	}
+	PackingCandidate root(&packed_objects, 0, packed_objects[0], nullptr);
+	PackingCandidate parent(&packed_objects, 1, packed_objects[1], &root);
+	const ConvexPolygon core = parent.hull_core();
+	for(size_t i = 2; i < packed_objects.size(); ++i) {
+		const PackingCandidate child(&packed_objects, i, packed_objects[i], &parent);
+		EXPECT_LE(PackingCandidate::score_lower_bound(&parent, core, packed_objects[i], packed_objects[i].area()), child.get_score()) << "The bound must never discard a child that could make it into the beam.";
+	}
+}
+
+/*!
+ * Test that the lower bound is close to the actual score if the new convex
+ * polygon is far away from the packing.
+ */
+TEST_F(PackingCandidateFixture, ScoreLowerBoundFarAway) {
+	const std::vector<ConvexPolygon> packed_objects({
+		triangle,
+		ConvexPolygon(triangle).translate(1000, 0)
+	});
+	PackingCandidate root(&packed_objects, 0, packed_objects[0], nullptr);
+	PackingCandidate child(&packed_objects, 1, packed_objects[1], &root);
+
+	const double bound = PackingCandidate::score_lower_bound(&root, root.hull_core(), packed_objects[1], packed_objects[1].area());
+	EXPECT_LE(bound, child.get_score());
+	EXPECT_NEAR(bound, child.get_score(), 0.001) << "The core of a triangle is the triangle itself, so the bound is exact.";
+}
+
 }
\ No newline at end of file
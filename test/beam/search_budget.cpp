@@ -0,0 +1,45 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <gtest/gtest.h> //To run the test.
+
+#include "beam/search_budget.hpp" //The unit under test.
+
+namespace convack {
+
+/*!
+ * Test that a budget without limits never runs out.
+ */
+TEST(SearchBudget, Unlimited) {
+	SearchBudget budget(0, 0);
+	EXPECT_FALSE(budget.exhausted());
+	budget.spend(1000000);
+	EXPECT_FALSE(budget.exhausted()) << "Without limits, any number of evaluations is allowed.";
+}
+
+/*!
+ * Test running out of evaluations.
+ */
+TEST(SearchBudget, Evaluations) {
+	SearchBudget budget(0, 10);
+	budget.spend(9);
+	EXPECT_FALSE(budget.exhausted()) << "There is still one evaluation left.";
+	budget.spend(1);
+	EXPECT_TRUE(budget.exhausted());
+}
+
+/*!
+ * Test running out of time.
+ */
+TEST(SearchBudget, Time) {
+	SearchBudget budget(0.000000001, 0);
+	while(!budget.exhausted()) {} //Waits one nanosecond.
+	EXPECT_TRUE(budget.exhausted()) << "Once exhausted, the budget stays exhausted.";
+
+	SearchBudget long_budget(1000, 0);
+	EXPECT_FALSE(long_budget.exhausted()) << "This budget lasts a long time.";
+}
+
+}
\ No newline at end of file
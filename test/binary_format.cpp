@@ -0,0 +1,143 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <cstring> //To modify the written data.
+#include <gtest/gtest.h> //To run the test.
+
+#include "binary_format.hpp" //The unit under test.
+#include "convex_polygon.hpp" //To write and read convex polygons.
+#include "point2.hpp" //To construct convex polygons.
+#include "transformation.hpp" //To check that transformations are preserved.
+
+namespace convack {
+
+/*!
+ * A fixture with a few convex polygons written to a buffer.
+ */
+class BinaryFormatFixture : public testing::Test {
+public:
+	/*!
+	 * The convex polygons that were written.
+	 */
+	std::vector<ConvexPolygon> convex_polygons;
+
+	/*!
+	 * The buffer the convex polygons were written to.
+	 */
+	std::vector<char> buffer;
+
+	/*!
+	 * Executed before every test in order to create or reset the fixtures.
+	 */
+	void SetUp() {
+		convex_polygons.assign({
+			ConvexPolygon({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)}),
+			ConvexPolygon({Point2(0, 0), Point2(20, 0), Point2(10, 15)}),
+			ConvexPolygon({Point2(0, 0), Point2(5, 0), Point2(8, 4), Point2(5, 8), Point2(0, 8)})
+		});
+		convex_polygons[1].translate(30, 40);
+		BinaryFormat::write(convex_polygons, buffer);
+	}
+};
+
+/*!
+ * Test writing convex polygons and viewing them again.
+ */
+TEST_F(BinaryFormatFixture, RoundTrip) {
+	BinaryFormat view;
+	ASSERT_TRUE(view.load(buffer.data(), buffer.size()));
+	ASSERT_EQ(view.size(), convex_polygons.size());
+	for(size_t i = 0; i < convex_polygons.size(); ++i) {
+		const ConvexPolygonView convex_polygon = view[i];
+		EXPECT_EQ(convex_polygon.uid, convex_polygons[i].uid());
+		EXPECT_EQ(convex_polygon.transformation, convex_polygons[i].current_transformation());
+		ASSERT_EQ(convex_polygon.num_vertices, convex_polygons[i].get_vertices().size());
+		for(size_t vertex = 0; vertex < convex_polygon.num_vertices; ++vertex) {
+			EXPECT_EQ(convex_polygon.vertices[vertex], convex_polygons[i].get_vertices()[vertex]);
+		}
+	}
+}
+
+/*!
+ * Test that the views point into the buffer, rather than to a copy.
+ */
+TEST_F(BinaryFormatFixture, ZeroCopy) {
+	BinaryFormat view;
+	ASSERT_TRUE(view.load(buffer.data(), buffer.size()));
+	const char* vertices = reinterpret_cast<const char*>(view[1].vertices);
+	EXPECT_GE(vertices, buffer.data());
+	EXPECT_LT(vertices, buffer.data() + buffer.size());
+}
+
+/*!
+ * Test creating convex polygons from the views.
+ */
+TEST_F(BinaryFormatFixture, ToConvexPolygons) {
+	BinaryFormat view;
+	ASSERT_TRUE(view.load(buffer.data(), buffer.size()));
+	const std::vector<ConvexPolygon> result = view.to_convex_polygons();
+	ASSERT_EQ(result.size(), convex_polygons.size());
+	for(size_t i = 0; i < result.size(); ++i) {
+		EXPECT_EQ(result[i], convex_polygons[i]);
+		EXPECT_EQ(result[i].current_transformation(), convex_polygons[i].current_transformation()) << "The transformation must be restored, to report where the convex polygon was packed.";
+		EXPECT_NE(result[i].uid(), convex_polygons[i].uid()) << "Identifiers are only unique within one process, so new ones are generated.";
+	}
+}
+
+/*!
+ * Test writing no convex polygons at all.
+ */
+TEST(BinaryFormat, Empty) {
+	std::vector<char> buffer;
+	BinaryFormat::write(std::vector<ConvexPolygon>(), buffer);
+	BinaryFormat view;
+	ASSERT_TRUE(view.load(buffer.data(), buffer.size()));
+	EXPECT_EQ(view.size(), 0);
+}
+
+/*!
+ * Test that data without the right header is rejected.
+ */
+TEST_F(BinaryFormatFixture, WrongHeader) {
+	BinaryFormat view;
+	buffer[0] = 'X';
+	EXPECT_FALSE(view.load(buffer.data(), buffer.size())) << "The magic characters don't match.";
+	buffer[0] = 'C';
+	buffer[4]++;
+	EXPECT_FALSE(view.load(buffer.data(), buffer.size())) << "The version doesn't match.";
+	EXPECT_EQ(view.size(), 0) << "After failing to load, the view is empty.";
+}
+
+/*!
+ * Test that truncated data is rejected.
+ */
+TEST_F(BinaryFormatFixture, Truncated) {
+	BinaryFormat view;
+	EXPECT_FALSE(view.load(buffer.data(), buffer.size() - 1));
+	EXPECT_FALSE(view.load(buffer.data(), 10)) << "Not even the header is complete.";
+}
+
+/*!
+ * Test that data that isn't aligned is rejected, since it can't be viewed in
+ * place.
+ */
+TEST_F(BinaryFormatFixture, Misaligned) {
+	std::vector<char> shifted(buffer.size() + 1);
+	std::memcpy(shifted.data() + 1, buffer.data(), buffer.size());
+	BinaryFormat view;
+	EXPECT_FALSE(view.load(shifted.data() + 1, buffer.size()));
+}
+
+/*!
+ * Test that records with vertices beyond the end of the data are rejected.
+ */
+TEST_F(BinaryFormatFixture, VerticesOutOfRange) {
+	uint64_t first_vertex = 100;
+	std::memcpy(buffer.data() + 32 + 72 + 8, &first_vertex, sizeof(first_vertex)); //The first vertex of the second record.
+	BinaryFormat view;
+	EXPECT_FALSE(view.load(buffer.data(), buffer.size()));
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <gtest/gtest.h> //To run the test.
+#include <thread> //To cancel from a different thread.
+
+#include "cancellation.hpp" //The unit under test.
+
+namespace convack {
+
+/*!
+ * Test that a new cancellation is not cancelled.
+ */
+TEST(Cancellation, Construct) {
+	const Cancellation cancellation;
+	EXPECT_FALSE(cancellation.is_cancelled());
+}
+
+/*!
+ * Test that copies of a cancellation see each other's cancellation.
+ */
+TEST(Cancellation, Copies) {
+	Cancellation original;
+	const Cancellation copy = original;
+	const Cancellation unrelated;
+	original.cancel();
+	EXPECT_TRUE(original.is_cancelled());
+	EXPECT_TRUE(copy.is_cancelled()) << "Copies share their state.";
+	EXPECT_FALSE(unrelated.is_cancelled()) << "Other cancellations are not affected.";
+}
+
+/*!
+ * Test cancelling from a different thread.
+ */
+TEST(Cancellation, OtherThread) {
+	Cancellation cancellation;
+	std::thread([cancellation]() mutable {
+		cancellation.cancel();
+	}).join();
+	EXPECT_TRUE(cancellation.is_cancelled());
+}
+
+}
\ No newline at end of file
@@ -7,8 +7,12 @@
 #include <cmath> //To calculate correct rotation matrices.
 #include <gtest/gtest.h> //To run the test.
 #include <random> //For fuzz testing.
+#include <thread> //To create convex polygons on multiple threads.
+#include <unordered_set> //To find duplicate identifiers.
+#include <utility> //To test moving convex polygons.
 #include <vector> //To store vertices of test polygons.
 
+#include "bounding_box.hpp" //To test the bounding boxes of convex polygons.
 #include "convex_polygon.hpp" //The unit under test.
 #include "point2.hpp" //To construct convex polygons and vertices for testing.
 #include "transformation.hpp" //To test tracking of transformations.
@@ -65,7 +69,7 @@ public:
 
 		colinear.clear();
 		for(size_t i = 0; i < 100; ++i) {
-			colinear.emplace_back(1.1 * i, 2.2 * i);
+			colinear.emplace_back(11 * i, 22 * i); //Whole units, so that they are exactly colinear in fixed point too.
 		}
 
 		circle.clear();
@@ -103,6 +107,22 @@ TEST_F(ConvexPolygonFixture, ConstructCopy) {
 	EXPECT_EQ(original.get_vertices(), copy.get_vertices()) << "The copy must be an exact copy.";
 }
 
+/*!
+ * Tests copy assignment, also into a convex polygon that was moved from.
+ */
+TEST_F(ConvexPolygonFixture, AssignCopy) {
+	const ConvexPolygon original(star);
+	ConvexPolygon copy(triangle);
+	copy.translate(10, 10);
+	copy = original;
+	EXPECT_EQ(original.get_vertices(), copy.get_vertices()) << "The copy must be an exact copy.";
+	EXPECT_EQ(original.uid(), copy.uid()) << "The identifier is copied along.";
+
+	ConvexPolygon moved_to(std::move(copy));
+	copy = original;
+	EXPECT_EQ(original.get_vertices(), copy.get_vertices()) << "A convex polygon that was moved from can be assigned to again.";
+}
+
 /*!
  * Test equality of two empty convex polygons.
  */
@@ -162,6 +182,62 @@ TEST_F(ConvexPolygonFixture, EqualityRotation) {
 	EXPECT_EQ(a, b) << "The two convex polygons cover the same area, even though the loop starts in a different spot along the contour.";
 }
 
+/*!
+ * Tests equality and shape comparisons when the lowest vertex occurs more than
+ * once in the loop, so it can't be used to line up the loops.
+ */
+TEST(ConvexPolygon, EqualityRepeatedLowestVertex) {
+	const ConvexPolygon a({Point2(0, 0), Point2(10, 0), Point2(0, 0), Point2(5, 10)});
+	const ConvexPolygon b({Point2(0, 0), Point2(5, 10), Point2(0, 0), Point2(10, 0)}); //Same loop, starting at the second copy of the lowest vertex.
+	const ConvexPolygon c({Point2(0, 0), Point2(10, 0), Point2(5, 10), Point2(0, 0)}); //Same vertices, but not a rotation of the same loop.
+	ConvexPolygon translated(b);
+	translated.translate(16, -32);
+
+	EXPECT_EQ(a, b) << "The loop starts at a different copy of the lowest vertex, but it's the same loop.";
+	EXPECT_NE(a, c) << "The vertices are in a different order along the loop.";
+	EXPECT_TRUE(a.same_shape(translated)) << "Only the start of the loop and the position are different.";
+	EXPECT_FALSE(a.same_shape(c)) << "The vertices are in a different order along the loop.";
+	EXPECT_EQ(a.shape_hash(), translated.shape_hash()) << "Convex polygons with the same shape must have the same hash.";
+}
+
+/*!
+ * Tests that translated convex polygons have the same shape, but are not equal.
+ */
+TEST_F(ConvexPolygonFixture, SameShapeTranslated) {
+	const ConvexPolygon a(triangle);
+	ConvexPolygon b(triangle);
+	b.translate(16, -32); //Powers of two, so that the translation is exact.
+
+	EXPECT_NE(a, b) << "The convex polygons are in different places.";
+	EXPECT_TRUE(a.same_shape(b)) << "Only the position is different, not the shape.";
+	EXPECT_EQ(a.shape_hash(), b.shape_hash()) << "Convex polygons with the same shape must have the same hash.";
+}
+
+/*!
+ * Tests that the shape doesn't depend on where the loop of vertices starts.
+ */
+TEST_F(ConvexPolygonFixture, SameShapeRotation) {
+	const ConvexPolygon a(triangle);
+	ConvexPolygon b({triangle[1], triangle[2], triangle[0]});
+	b.translate(-8, 4);
+
+	EXPECT_TRUE(a.same_shape(b)) << "The loop starts in a different spot along the contour, but that doesn't change the shape.";
+	EXPECT_EQ(a.shape_hash(), b.shape_hash()) << "Convex polygons with the same shape must have the same hash.";
+}
+
+/*!
+ * Tests that convex polygons with different shapes are recognised as such.
+ */
+TEST_F(ConvexPolygonFixture, SameShapeDifferent) {
+	const ConvexPolygon a(triangle);
+	const ConvexPolygon b({Point2(0, 0), Point2(50, 0), Point2(20, 50)}); //The top is shifted a bit.
+	const ConvexPolygon c(star);
+
+	EXPECT_FALSE(a.same_shape(b)) << "Even though they have the same number of vertices and area, the shape is different.";
+	EXPECT_FALSE(a.same_shape(c)) << "They have a different number of vertices.";
+	EXPECT_TRUE(ConvexPolygon({}).same_shape(ConvexPolygon({}))) << "Empty convex polygons all have the same shape.";
+}
+
 /*!
  * Tests getting the convex hull of an empty set of vertices.
  */
@@ -245,7 +321,7 @@ TEST_F(ConvexPolygonFixture, ConvexHullTriangleReversed) {
  */
 TEST_F(ConvexPolygonFixture, ConvexHullColinearForwardOrder) {
 	const ConvexPolygon result = ConvexPolygon::convex_hull(colinear);
-	const ConvexPolygon ground_truth({Point2(0.0, 0.0), Point2(1.1 * 99, 2.2 * 99)});
+	const ConvexPolygon ground_truth({Point2(0.0, 0.0), Point2(11 * 99, 22 * 99)});
 	EXPECT_EQ(result, ground_truth);
 }
 
@@ -260,7 +336,7 @@ TEST_F(ConvexPolygonFixture, ConvexHullColinearForwardOrder) {
 TEST_F(ConvexPolygonFixture, ConvexHullColinearBackwardOrder) {
 	std::reverse(colinear.begin(), colinear.end());
 	const ConvexPolygon result = ConvexPolygon::convex_hull(colinear);
-	const ConvexPolygon ground_truth({Point2(0.0, 0.0), Point2(1.1 * 99, 2.2 * 99)});
+	const ConvexPolygon ground_truth({Point2(0.0, 0.0), Point2(11 * 99, 22 * 99)});
 	EXPECT_EQ(result, ground_truth);
 }
 
@@ -281,7 +357,7 @@ TEST_F(ConvexPolygonFixture, ConvexHullColinearRandomOrder) {
 	for(size_t i = 0; i < num_shuffle; ++i) {
 		std::shuffle(colinear.begin(), colinear.end(), randomiser); //Use a fixed seed so the tests are deterministic.
 		const ConvexPolygon result = ConvexPolygon::convex_hull(colinear);
-		const ConvexPolygon ground_truth({Point2(0.0, 0.0), Point2(1.1 * 99, 2.2 * 99)});
+		const ConvexPolygon ground_truth({Point2(0.0, 0.0), Point2(11 * 99, 22 * 99)});
 		EXPECT_EQ(result, ground_truth);
 	}
 }
@@ -303,6 +379,41 @@ TEST(ConvexPolygon, ConvexHullSinglePoint) {
 	EXPECT_EQ(result.get_vertices()[0], Point2(42, 69)) << "The coordinates for all of the points were this. That must be retained.";
 }
 
+/*!
+ * Tests taking the convex hull of large random point clouds.
+ *
+ * This is a fuzz test. The result must be convex, must only consist of input
+ * points and must enclose all input points. The random number generator is
+ * seeded, so the test is still deterministic.
+ */
+TEST(ConvexPolygon, ConvexHullRandom) {
+	constexpr size_t num_tests = 100; //How often to repeat the test with random points. Increase to catch more cases, but slower tests.
+	std::default_random_engine randomiser{42}; //Use a fixed seed so the tests are deterministic.
+	std::uniform_int_distribution<size_t> num_points(3, 2000);
+	std::uniform_real_distribution<double> position(-100, 100);
+	for(size_t test = 0; test < num_tests; ++test) {
+		std::vector<Point2> points;
+		const size_t size = num_points(randomiser);
+		for(size_t i = 0; i < size; ++i) {
+			points.emplace_back(position(randomiser), position(randomiser));
+		}
+		const ConvexPolygon convex_hull = ConvexPolygon::convex_hull(points);
+		const std::vector<Point2>& result = convex_hull.get_vertices();
+		ASSERT_GE(result.size(), 3) << "Random points are almost never all colinear.";
+
+		for(size_t vertex = 0; vertex < result.size(); ++vertex) {
+			EXPECT_NE(std::find(points.begin(), points.end(), result[vertex]), points.end()) << "All vertices of the convex hull must be input points.";
+			const Point2& a = result[vertex];
+			const Point2& b = result[(vertex + 1) % result.size()];
+			const Point2& c = result[(vertex + 2) % result.size()];
+			EXPECT_GT((static_cast<area_t>(b.x) - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x), 0) << "The convex hull must turn counter-clockwise at every vertex.";
+			for(const Point2& point : points) {
+				ASSERT_GE((static_cast<area_t>(b.x) - a.x) * (point.y - a.y) - (b.y - a.y) * (point.x - a.x), 0) << "All input points must be inside of the convex hull.";
+			}
+		}
+	}
+}
+
 /*!
  * Test taking the convex hull of an empty set of convex polygons.
  */
@@ -337,6 +448,7 @@ TEST_F(ConvexPolygonFixture, ConvexPolyHullTwoTriangles) {
 	EXPECT_EQ(ConvexPolygon::convex_hull(two), ground_truth);
 }
 
+#ifndef CONVACK_FIXED_POINT //The circle has a radius of 1, which is too small for whole units.
 /*!
  * Test taking the convex hull around two circles, offset from each other.
  *
@@ -364,6 +476,7 @@ TEST_F(ConvexPolygonFixture, ConvexPolyHullTwoCircles) {
 
 	EXPECT_EQ(ConvexPolygon::convex_hull(pair), ground_truth);
 }
+#endif
 
 /*!
  * Test taking the convex hull around four triangles.
@@ -433,6 +546,175 @@ TEST_F(ConvexPolygonFixture, ConvexPolyHullColinear) {
 	EXPECT_EQ(ConvexPolygon::convex_hull(colinear), ground_truth) << "The result should be completely simplified with no extra vertices halfway between two colinear segments.";
 }
 
+/*!
+ * Test taking the convex hull of convex polygons in random positions.
+ *
+ * This is a fuzz test. The result is compared to the convex hull around all of
+ * the vertices of the convex polygons, which must be the same. The random
+ * number generator is seeded, so the test is still deterministic.
+ */
+TEST(ConvexPolygon, ConvexPolyHullRandom) {
+	constexpr size_t num_tests = 1000; //How often to repeat the test with random polygons. Increase to catch more cases, but slower tests.
+	std::default_random_engine randomiser{42}; //Use a fixed seed so the tests are deterministic.
+	std::uniform_int_distribution<size_t> num_sides(3, 12);
+	std::uniform_real_distribution<double> position(-30, 30);
+	std::uniform_real_distribution<double> radius(1, 20);
+	constexpr double pi = std::acos(-1);
+	for(size_t test = 0; test < num_tests; ++test) {
+		std::vector<ConvexPolygon> polygons;
+		std::vector<Point2> all_vertices;
+		for(size_t polygon = 0; polygon < 2; ++polygon) {
+			const size_t sides = num_sides(randomiser);
+			const double polygon_radius = radius(randomiser);
+			const double offset_x = position(randomiser);
+			const double offset_y = position(randomiser);
+			std::vector<Point2> vertices;
+			for(size_t i = 0; i < sides; ++i) {
+				const double angle = pi * 2 / sides * i;
+				vertices.emplace_back(std::cos(angle) * polygon_radius + offset_x, std::sin(angle) * polygon_radius + offset_y);
+			}
+			all_vertices.insert(all_vertices.end(), vertices.begin(), vertices.end());
+			polygons.push_back(ConvexPolygon::convex_hull(vertices)); //With fixed point coordinates, rounding the vertices to whole units may make them concave.
+		}
+		const ConvexPolygon result = ConvexPolygon::convex_hull(polygons);
+		const ConvexPolygon ground_truth = ConvexPolygon::convex_hull(all_vertices);
+		EXPECT_NEAR(result.area(), ground_truth.area(), ground_truth.area() * 0.0001) << "The convex hull around the polygons must be the same as the convex hull around all of their vertices.";
+	}
+}
+
+/*!
+ * Test merging the convex hull of two convex polygons when either is empty.
+ */
+TEST_F(ConvexPolygonFixture, ConvexPairHullEmpty) {
+	const ConvexPolygon empty({});
+	EXPECT_TRUE(ConvexPolygon::convex_hull(empty, empty).get_vertices().empty());
+	EXPECT_EQ(ConvexPolygon::convex_hull(empty, ConvexPolygon(triangle)), ConvexPolygon(triangle)) << "Nothing is added by the empty convex polygon.";
+	EXPECT_EQ(ConvexPolygon::convex_hull(ConvexPolygon(triangle), empty), ConvexPolygon(triangle)) << "Nothing is added by the empty convex polygon.";
+}
+
+/*!
+ * Test merging the convex hull of two triangles, offset from each other.
+ */
+TEST_F(ConvexPolygonFixture, ConvexPairHullTwoTriangles) {
+	const ConvexPolygon ground_truth({
+		Point2(0, 0),
+		Point2(50, 0),
+		Point2(150, 10),
+		Point2(125, 60),
+		Point2(25, 50),
+	});
+	EXPECT_EQ(ConvexPolygon::convex_hull(ConvexPolygon(triangle), ConvexPolygon(triangle).translate(100, 10)), ground_truth);
+}
+
+#ifndef CONVACK_FIXED_POINT //The circle has a radius of 1, which is too small for whole units.
+/*!
+ * Test merging the convex hull of two circles, which have many vertices.
+ */
+TEST_F(ConvexPolygonFixture, ConvexPairHullTwoCircles) {
+	const std::vector<ConvexPolygon> pair {
+		ConvexPolygon(circle),
+		ConvexPolygon(circle).translate(100, 0)
+	};
+	EXPECT_EQ(ConvexPolygon::convex_hull(pair[0], pair[1]), ConvexPolygon::convex_hull(pair)) << "Merging two convex polygons must give the same result as the convex hull around a list of them.";
+}
+#endif
+
+/*!
+ * Test merging the convex hull of two convex polygons of which one is inside
+ * the other, or they overlap.
+ */
+TEST_F(ConvexPolygonFixture, ConvexPairHullOverlapping) {
+	const ConvexPolygon big(triangle);
+	ConvexPolygon small(circle);
+	small.translate(25, 15);
+	EXPECT_EQ(ConvexPolygon::convex_hull(big, small), big) << "The circle is inside the triangle, so it doesn't change the convex hull.";
+	EXPECT_EQ(ConvexPolygon::convex_hull(small, big), big) << "The order doesn't matter.";
+
+	const ConvexPolygon ground_truth({
+		Point2(0, 0),
+		Point2(50, 0),
+		Point2(75, 25),
+		Point2(50, 75),
+		Point2(25, 50)
+	});
+	EXPECT_EQ(ConvexPolygon::convex_hull(ConvexPolygon(triangle), ConvexPolygon(triangle).translate(25, 25)), ground_truth);
+}
+
+/*!
+ * Test merging the convex hull of two convex polygons that share an edge, so
+ * that some of their vertices become colinear.
+ */
+TEST(ConvexPolygon, ConvexPairHullColinear) {
+	const ConvexPolygon left({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)});
+	const ConvexPolygon right({Point2(10, 0), Point2(20, 0), Point2(20, 10), Point2(10, 10)});
+	const ConvexPolygon ground_truth({Point2(0, 0), Point2(20, 0), Point2(20, 10), Point2(0, 10)});
+	EXPECT_EQ(ConvexPolygon::convex_hull(left, right), ground_truth) << "The shared vertices are halfway along the edges of the convex hull, so they must be removed.";
+}
+
+/*!
+ * Test merging the convex hull of two convex polygons in random positions.
+ *
+ * This is a fuzz test. The result is compared to the convex hull around all of
+ * the vertices of both.
+ */
+TEST(ConvexPolygon, ConvexPairHullRandom) {
+	constexpr size_t num_tests = 1000;
+	std::default_random_engine randomiser{42}; //Use a fixed seed so the tests are deterministic.
+	std::uniform_int_distribution<size_t> num_sides(3, 12);
+	std::uniform_real_distribution<double> position(-30, 30);
+	std::uniform_real_distribution<double> radius(1, 20);
+	std::uniform_real_distribution<double> phase(0, 1);
+	constexpr double pi = std::acos(-1);
+	for(size_t test = 0; test < num_tests; ++test) {
+		std::vector<ConvexPolygon> polygons;
+		std::vector<Point2> all_vertices;
+		for(size_t polygon = 0; polygon < 2; ++polygon) {
+			const size_t sides = num_sides(randomiser);
+			const double polygon_radius = radius(randomiser);
+			const double offset_x = position(randomiser);
+			const double offset_y = position(randomiser);
+			const double start_angle = phase(randomiser) * pi * 2;
+			std::vector<Point2> vertices;
+			for(size_t i = 0; i < sides; ++i) {
+				const double angle = start_angle + pi * 2 / sides * i;
+				vertices.emplace_back(std::cos(angle) * polygon_radius + offset_x, std::sin(angle) * polygon_radius + offset_y);
+			}
+			all_vertices.insert(all_vertices.end(), vertices.begin(), vertices.end());
+			polygons.push_back(ConvexPolygon::convex_hull(vertices)); //With fixed point coordinates, rounding the vertices to whole units may make them concave.
+		}
+		const ConvexPolygon result = ConvexPolygon::convex_hull(polygons[0], polygons[1]);
+		const ConvexPolygon ground_truth = ConvexPolygon::convex_hull(all_vertices);
+		EXPECT_NEAR(result.area(), ground_truth.area(), ground_truth.area() * 0.0001) << "The merged convex hull must be the same as the convex hull around all of their vertices.";
+		EXPECT_TRUE(result.contains(polygons[0]) && result.contains(polygons[1])) << "Both convex polygons must be inside the merged convex hull. Rounded vertices may also lie on its edges, which still counts as inside.";
+	}
+}
+
+/*!
+ * Test constructing convex hulls in existing convex polygons.
+ */
+TEST_F(ConvexPolygonFixture, ConvexHullInExisting) {
+	ConvexPolygon result(circle);
+	result.translate(-1000, -1000);
+	ConvexPolygon::convex_hull(star, result);
+	EXPECT_EQ(result, ConvexPolygon::convex_hull(star)) << "The old vertices and transformation of the result must be replaced.";
+
+	ConvexPolygon small(circle);
+	small.translate(100, 0);
+	ConvexPolygon::convex_hull(ConvexPolygon(triangle), small, result);
+	EXPECT_EQ(result, ConvexPolygon::convex_hull(ConvexPolygon(triangle), small));
+
+	ConvexPolygon big(triangle);
+	const uint64_t uid = big.uid();
+	ConvexPolygon::convex_hull(big, small, big);
+	EXPECT_EQ(big, result) << "The result may be one of the convex polygons to merge.";
+	EXPECT_NE(big.uid(), uid) << "The convex hull is a new convex polygon.";
+
+	ConvexPolygon moved_from(triangle);
+	const ConvexPolygon moved_to(std::move(moved_from));
+	ConvexPolygon::convex_hull(moved_to, small, moved_from);
+	EXPECT_EQ(moved_from, result) << "A convex polygon that was moved from can be reused too.";
+}
+
 /*!
  * Test computing the area of an empty convex polygon.
  */
@@ -464,11 +746,13 @@ TEST_F(ConvexPolygonFixture, AreaTriangle) {
 	EXPECT_DOUBLE_EQ(ConvexPolygon(triangle).area(), 50.0 * 50.0 / 2) << "This is a triangle with base 50 and height 50.";
 }
 
+#ifndef CONVACK_FIXED_POINT //The circle has a radius of 1, which is too small for whole units.
 TEST_F(ConvexPolygonFixture, AreaCircle) {
 	constexpr double pi = std::acos(-1);
 	constexpr area_t ground_truth = 100.0 * std::sin(pi * 2 / 100) / 2; //Formula for area of a regular polygon (100 vertices, radius 1.0);
 	EXPECT_NEAR(ConvexPolygon(circle).area(), ground_truth, 0.000005) << "This shape is a regular polygon with 100 sides and radius 1.";
 }
+#endif
 
 /*!
  * Test collision between two empty convex polygons.
@@ -592,6 +876,116 @@ TEST_F(ConvexPolygonFixture, CollidesThrough) {
 	EXPECT_TRUE(b.collides(a)) << "The inverse always gives the same result.";
 }
 
+#ifndef CONVACK_FIXED_POINT //The circle has a radius of 1, which is too small for whole units.
+/*!
+ * Test collision between two large convex polygons at various distances.
+ *
+ * These convex polygons have enough vertices to use the linear collision check.
+ */
+TEST_F(ConvexPolygonFixture, CollidesCircles) {
+	const ConvexPolygon a(circle);
+
+	ConvexPolygon overlapping(circle);
+	overlapping.translate(1.999, 0);
+	EXPECT_TRUE(a.collides(overlapping)) << "The circles overlap a tiny bit.";
+	EXPECT_TRUE(overlapping.collides(a)) << "The inverse always gives the same result.";
+
+	ConvexPolygon touching(circle);
+	touching.translate(2, 0);
+	EXPECT_FALSE(a.collides(touching)) << "The circles touch only with one vertex, which is not considered a collision.";
+	EXPECT_FALSE(touching.collides(a)) << "The inverse always gives the same result.";
+
+	ConvexPolygon apart(circle);
+	apart.translate(2.001, 0);
+	EXPECT_FALSE(a.collides(apart)) << "The circles are a tiny bit apart.";
+	EXPECT_FALSE(apart.collides(a)) << "The inverse always gives the same result.";
+}
+
+/*!
+ * Test collision between a large and a small convex polygon.
+ */
+TEST_F(ConvexPolygonFixture, CollidesCircleTriangle) {
+	ConvexPolygon large(circle);
+	large.rotate(0.1).translate(25, 20); //Move it inside of the triangle.
+	const ConvexPolygon small(triangle);
+	EXPECT_TRUE(large.collides(small)) << "The circle is completely inside the triangle.";
+	EXPECT_TRUE(small.collides(large)) << "The inverse always gives the same result.";
+
+	large.translate(0, 100);
+	EXPECT_FALSE(large.collides(small)) << "The circle is far above the triangle.";
+	EXPECT_FALSE(small.collides(large)) << "The inverse always gives the same result.";
+}
+#endif
+
+/*!
+ * Test whether any edge of one convex polygon separates it from another, by
+ * projecting all vertices on all edges.
+ *
+ * This is the most direct application of the separating axes theorem, used as
+ * ground truth for the collision tests.
+ * \param a The convex polygon whose edges to test.
+ * \param b The convex polygon to project on those edges.
+ * \return `true` if there is an edge of `a` that separates it from `b`.
+ */
+bool has_separating_edge(const ConvexPolygon& a, const ConvexPolygon& b) {
+	const std::vector<Point2>& a_vertices = a.get_vertices();
+	for(size_t edge = 0; edge < a_vertices.size(); ++edge) {
+		const Point2 edge_vector = a_vertices[(edge + 1) % a_vertices.size()] - a_vertices[edge];
+		const Point2 axis_vector(edge_vector.y, -edge_vector.x);
+		bool separating = true;
+		for(const Point2& vertex : b.get_vertices()) {
+			if(axis_vector.dot(vertex - a_vertices[edge]) < 0) {
+				separating = false;
+				break;
+			}
+		}
+		if(separating) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*!
+ * Test collision between random pairs of large convex polygons.
+ *
+ * This is a fuzz test. The result is compared to projecting all vertices on all
+ * edges, which must give the same result. The random number generator is
+ * seeded, so the test is still deterministic.
+ */
+TEST(ConvexPolygon, CollidesRandom) {
+	constexpr size_t num_tests = 1000; //How often to repeat the test with random polygons. Increase to catch more cases, but slower tests.
+	std::default_random_engine randomiser{42}; //Use a fixed seed so the tests are deterministic.
+	std::uniform_int_distribution<size_t> num_sides(3, 200);
+	std::uniform_real_distribution<double> position(-30, 30);
+	std::uniform_real_distribution<double> radius(1, 20);
+	std::uniform_real_distribution<double> phase(0, 1);
+	constexpr double pi = std::acos(-1);
+	size_t num_colliding = 0;
+	for(size_t test = 0; test < num_tests; ++test) {
+		std::vector<ConvexPolygon> polygons;
+		for(size_t polygon = 0; polygon < 2; ++polygon) {
+			const size_t sides = num_sides(randomiser);
+			const double polygon_radius = radius(randomiser);
+			const double offset_x = position(randomiser);
+			const double offset_y = position(randomiser);
+			const double start_angle = phase(randomiser);
+			std::vector<Point2> vertices;
+			for(size_t i = 0; i < sides; ++i) {
+				const double angle = pi * 2 / sides * (i + start_angle);
+				vertices.emplace_back(std::cos(angle) * polygon_radius + offset_x, std::sin(angle) * polygon_radius + offset_y);
+			}
+			polygons.push_back(ConvexPolygon::convex_hull(vertices)); //With fixed point coordinates, rounding the vertices to whole units may make them concave.
+		}
+		const bool ground_truth = !has_separating_edge(polygons[0], polygons[1]) && !has_separating_edge(polygons[1], polygons[0]);
+		EXPECT_EQ(polygons[0].collides(polygons[1]), ground_truth) << "Test " << test << ": The collision check must agree with projecting all vertices on all edges.";
+		EXPECT_EQ(polygons[1].collides(polygons[0]), ground_truth) << "Test " << test << ": The inverse always gives the same result.";
+		num_colliding += ground_truth;
+	}
+	EXPECT_GT(num_colliding, 0) << "The fuzz test must cover colliding cases.";
+	EXPECT_LT(num_colliding, num_tests) << "The fuzz test must cover non-colliding cases.";
+}
+
 /*!
  * Tests that an empty convex polygon never contains any points.
  */
@@ -647,6 +1041,144 @@ TEST_F(ConvexPolygonFixture, ContainsEdge) {
 	EXPECT_FALSE(polygon.contains(Point2(80, 0))) << "This point is aligned with the line through one of the edges, but is actually completely outside of the triangle.";
 }
 
+/*!
+ * Tests whether a point inside the bounding box of a convex polygon, but
+ * outside of the convex polygon itself, is correctly identified as outside.
+ */
+TEST_F(ConvexPolygonFixture, ContainsBoundingBox) {
+	EXPECT_FALSE(ConvexPolygon(triangle).contains(Point2(2, 40))) << "This point is inside the bounding box of the triangle, but not inside the triangle itself.";
+}
+
+/*!
+ * Tests that an empty convex polygon doesn't contain any convex polygon.
+ */
+TEST_F(ConvexPolygonFixture, ContainsPolygonEmpty) {
+	const ConvexPolygon empty({});
+	EXPECT_FALSE(empty.contains(ConvexPolygon(triangle))) << "An empty convex polygon has no room for anything.";
+	EXPECT_FALSE(ConvexPolygon(triangle).contains(empty)) << "An empty convex polygon has no bounding box, so it isn't anywhere.";
+}
+
+/*!
+ * Tests whether a convex polygon completely inside another is correctly
+ * identified as inside.
+ */
+TEST_F(ConvexPolygonFixture, ContainsPolygonInside) {
+	const ConvexPolygon inner({Point2(20, 10), Point2(30, 10), Point2(25, 20)});
+	EXPECT_TRUE(ConvexPolygon(triangle).contains(inner)) << "The small triangle is completely inside the big one.";
+	EXPECT_FALSE(inner.contains(ConvexPolygon(triangle))) << "The big triangle doesn't fit in the small one.";
+}
+
+/*!
+ * Tests that a convex polygon which touches the boundary of another from the
+ * inside is still considered inside.
+ */
+TEST_F(ConvexPolygonFixture, ContainsPolygonTouching) {
+	const ConvexPolygon polygon(triangle);
+	EXPECT_TRUE(polygon.contains(polygon)) << "A convex polygon just fits inside of itself.";
+	const ConvexPolygon bottom({Point2(10, 0), Point2(40, 0), Point2(25, 10)});
+	EXPECT_TRUE(polygon.contains(bottom)) << "Lying on the bottom edge is still inside.";
+}
+
+/*!
+ * Tests whether a convex polygon that sticks out of another is correctly
+ * identified as outside.
+ */
+TEST_F(ConvexPolygonFixture, ContainsPolygonStickingOut) {
+	const ConvexPolygon polygon(triangle);
+	const ConvexPolygon below({Point2(20, -1), Point2(30, 10), Point2(25, 20)});
+	EXPECT_FALSE(polygon.contains(below)) << "One vertex sticks out of the bottom, which is also outside the bounding box.";
+	const ConvexPolygon corner({Point2(2, 40), Point2(10, 38), Point2(20, 30)});
+	EXPECT_FALSE(polygon.contains(corner)) << "This is inside the bounding box of the triangle, but not inside the triangle itself.";
+}
+
+/*!
+ * Test the geometry of convex polygons with few vertices, which have kernels
+ * for their specific number of vertices, as well as slightly larger ones which
+ * don't.
+ */
+TEST(ConvexPolygon, SmallVertexCounts) {
+	const double pi = std::acos(-1);
+	for(size_t num_vertices = 3; num_vertices <= 10; ++num_vertices) {
+		std::vector<Point2> vertices;
+		for(size_t i = 0; i < num_vertices; ++i) {
+			const double angle = 2.0 * pi / num_vertices * i;
+			vertices.emplace_back(std::cos(angle) * 10, std::sin(angle) * 10);
+		}
+		const ConvexPolygon regular(vertices);
+		area_t twice_area = 0; //The shoelace formula, without any of the specialised kernels.
+		for(size_t i = 0, previous = num_vertices - 1; i < num_vertices; previous = i++) {
+			twice_area += static_cast<area_t>(vertices[previous].x) * vertices[i].y - static_cast<area_t>(vertices[i].x) * vertices[previous].y;
+		}
+		EXPECT_NEAR(regular.area(), twice_area / 2, 0.0001) << "Regular polygon with " << num_vertices << " vertices.";
+#ifndef CONVACK_FIXED_POINT //Rounding the vertices to whole units changes the area too much.
+		const area_t ground_truth = num_vertices * 100 * std::sin(pi * 2 / num_vertices) / 2; //Formula for the area of a regular polygon.
+		EXPECT_NEAR(regular.area(), ground_truth, 0.0001) << "Regular polygon with " << num_vertices << " vertices.";
+#endif
+
+		EXPECT_TRUE(regular.contains(Point2(0, 0))) << "The centre is inside, with " << num_vertices << " vertices.";
+		EXPECT_TRUE(regular.contains(Point2(9, 0))) << "Close to the first vertex is inside, with " << num_vertices << " vertices.";
+		EXPECT_FALSE(regular.contains(Point2(11, 0))) << "Beyond the first vertex is outside, with " << num_vertices << " vertices.";
+		EXPECT_FALSE(regular.contains(vertices.back())) << "The vertices are on the boundary, with " << num_vertices << " vertices.";
+		EXPECT_TRUE(regular.contains(regular)) << "The boundary may touch, with " << num_vertices << " vertices.";
+
+		ConvexPolygon near(vertices);
+		near.translate(5, 0);
+		EXPECT_TRUE(regular.collides(near)) << "Overlapping, with " << num_vertices << " vertices.";
+		EXPECT_FALSE(regular.contains(near)) << "Sticking out, with " << num_vertices << " vertices.";
+		ConvexPolygon far(vertices);
+		far.translate(15, 15);
+		EXPECT_FALSE(regular.collides(far)) << "Bounding boxes overlap, but the polygons don't, with " << num_vertices << " vertices.";
+	}
+}
+
+/*!
+ * Test collision between two convex polygons whose bounding boxes only touch.
+ */
+TEST(ConvexPolygon, CollidesBoundingBoxTouching) {
+	const ConvexPolygon a({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)});
+	const ConvexPolygon b({Point2(10, 0), Point2(20, 0), Point2(20, 10), Point2(10, 10)});
+
+	EXPECT_FALSE(a.collides(b)) << "The squares share an edge, but have no area of overlap.";
+	EXPECT_FALSE(b.collides(a)) << "The inverse always gives the same result.";
+}
+
+/*!
+ * Test the bounding box of an empty convex polygon.
+ */
+TEST(ConvexPolygon, BoundingBoxEmpty) {
+	EXPECT_TRUE(ConvexPolygon({}).get_bounding_box().empty()) << "There are no vertices, so the bounding box is empty.";
+}
+
+/*!
+ * Test the bounding box of a convex polygon right after constructing it.
+ */
+TEST_F(ConvexPolygonFixture, BoundingBox) {
+	const BoundingBox& bounding_box = ConvexPolygon(triangle).get_bounding_box();
+	EXPECT_EQ(bounding_box.minimum, Point2(0, 0)) << "The lowest X and Y coordinates of the triangle are both 0.";
+	EXPECT_EQ(bounding_box.maximum, Point2(50, 50)) << "The highest X and Y coordinates of the triangle are both 50.";
+}
+
+/*!
+ * Test that the bounding box moves along when translating a convex polygon.
+ */
+TEST_F(ConvexPolygonFixture, BoundingBoxTranslate) {
+	ConvexPolygon polygon(triangle);
+	polygon.translate(42, 69);
+	EXPECT_EQ(polygon.get_bounding_box(), BoundingBox(polygon.get_vertices())) << "The bounding box must be updated to enclose the translated vertices.";
+	EXPECT_EQ(polygon.get_bounding_box().minimum, Point2(42, 69));
+}
+
+/*!
+ * Test that the bounding box is updated when rotating a convex polygon.
+ */
+TEST_F(ConvexPolygonFixture, BoundingBoxRotate) {
+	ConvexPolygon polygon(triangle);
+	constexpr double pi = std::acos(-1);
+	polygon.rotate(pi / 2);
+	EXPECT_EQ(polygon.get_bounding_box(), BoundingBox(polygon.get_vertices())) << "The bounding box must be updated to enclose the rotated vertices.";
+	EXPECT_NEAR(polygon.get_bounding_box().minimum.x, -50, 0.0001) << "The right-most vertex is rotated to the negative X side.";
+}
+
 /*!
  * Test tracking the current transformation through multiple transformations.
  */
@@ -705,4 +1237,169 @@ TEST_F(ConvexPolygonFixture, Rotate) {
 	}
 }
 
+
+/*!
+ * Test that convex polygons don't transform lazily unless asked to.
+ */
+TEST_F(ConvexPolygonFixture, LazyDefault) {
+	ConvexPolygon polygon(triangle);
+	EXPECT_FALSE(polygon.is_lazy()) << "By default, transformations are applied right away.";
+	polygon.set_lazy(true);
+	EXPECT_TRUE(polygon.is_lazy());
+	polygon.set_lazy(false);
+	EXPECT_FALSE(polygon.is_lazy());
+}
+
+/*!
+ * Test translating a lazy convex polygon.
+ */
+TEST_F(ConvexPolygonFixture, LazyTranslate) {
+	ConvexPolygon eager(triangle);
+	eager.translate(42, 69);
+	ConvexPolygon lazy(triangle);
+	lazy.set_lazy(true).translate(42, 69);
+
+	EXPECT_EQ(lazy.get_bounding_box(), eager.get_bounding_box()) << "The bounding box must be translated along.";
+	EXPECT_EQ(lazy.get_vertices(), eager.get_vertices()) << "A single translation gives exactly the same vertices, whether it's lazy or not.";
+	EXPECT_EQ(lazy.current_transformation(), eager.current_transformation()) << "The transformation is tracked in the same way.";
+}
+
+#ifndef CONVACK_FIXED_POINT //The circle has a radius of 1, which is too small for whole units.
+/*!
+ * Test rotating and translating a lazy convex polygon multiple times.
+ */
+TEST_F(ConvexPolygonFixture, LazyRotate) {
+	ConvexPolygon eager(circle);
+	eager.rotate(1).translate(3, 4).rotate(-0.5);
+	ConvexPolygon lazy(circle);
+	lazy.set_lazy(true).rotate(1).translate(3, 4).rotate(-0.5);
+
+	ASSERT_EQ(lazy.get_vertices().size(), eager.get_vertices().size()) << "Transformations don't create or destroy vertices.";
+	for(size_t vertex = 0; vertex < lazy.get_vertices().size(); ++vertex) {
+		EXPECT_NEAR(lazy.get_vertices()[vertex].x, eager.get_vertices()[vertex].x, 0.0001) << "Except for rounding errors, the vertices must be the same.";
+		EXPECT_NEAR(lazy.get_vertices()[vertex].y, eager.get_vertices()[vertex].y, 0.0001) << "Except for rounding errors, the vertices must be the same.";
+	}
+	EXPECT_EQ(lazy.get_bounding_box(), BoundingBox(lazy.get_vertices())) << "The bounding box must enclose the rotated vertices.";
+	EXPECT_NEAR(lazy.area(), eager.area(), eager.area() * 0.0001) << "The area is not changed by rotating or translating.";
+}
+#endif
+
+/*!
+ * Test copying a lazy convex polygon.
+ */
+TEST_F(ConvexPolygonFixture, LazyCopy) {
+	ConvexPolygon original(triangle);
+	original.set_lazy(true).translate(10, 0);
+	ConvexPolygon copy(original);
+	copy.translate(0, 10);
+
+	EXPECT_TRUE(copy.is_lazy()) << "The copy is lazy too.";
+	EXPECT_EQ(copy.get_vertices()[0], Point2(10, 10)) << "The copy got translated twice.";
+	EXPECT_EQ(original.get_vertices()[0], Point2(10, 0)) << "Translating the copy doesn't affect the original.";
+}
+
+/*!
+ * Test collision with a lazy convex polygon.
+ */
+TEST_F(ConvexPolygonFixture, LazyCollides) {
+	const ConvexPolygon eager(triangle);
+	ConvexPolygon lazy(triangle);
+	lazy.set_lazy(true).translate(25, 25);
+	EXPECT_TRUE(eager.collides(lazy)) << "They overlap, just like in the non-lazy test.";
+	EXPECT_TRUE(lazy.collides(eager)) << "The inverse always gives the same result.";
+
+	lazy.translate(5, 15);
+	EXPECT_FALSE(eager.collides(lazy)) << "Now they only touch, just like in the non-lazy test.";
+	EXPECT_FALSE(lazy.collides(eager)) << "The inverse always gives the same result.";
+	EXPECT_TRUE(lazy.contains(Point2(40, 50))) << "The point is inside the translated triangle.";
+}
+
+/*!
+ * Test turning lazy transformations off again.
+ */
+TEST_F(ConvexPolygonFixture, LazyDisable) {
+	ConvexPolygon polygon(triangle);
+	polygon.set_lazy(true).translate(42, 69);
+	polygon.set_lazy(false);
+	polygon.translate(1, 1);
+
+	const ConvexPolygon ground_truth({
+		Point2(43, 70),
+		Point2(93, 70),
+		Point2(68, 120)
+	});
+	EXPECT_EQ(polygon, ground_truth) << "The pending transformation must be applied when turning lazy transformations off, and later transformations are applied right away.";
+}
+
+/*!
+ * Test that copies keep the identifier and new convex polygons get a new one.
+ */
+TEST_F(ConvexPolygonFixture, Uid) {
+	const ConvexPolygon original(triangle);
+	const ConvexPolygon copy(original);
+	EXPECT_EQ(copy.uid(), original.uid()) << "Copies retain the identifier.";
+	const ConvexPolygon other(triangle);
+	EXPECT_NE(other.uid(), original.uid()) << "A new convex polygon gets a new identifier, even with the same vertices.";
+}
+
+/*!
+ * Test that convex polygons created on multiple threads at once get unique
+ * identifiers.
+ */
+TEST_F(ConvexPolygonFixture, UidMultithreaded) {
+	constexpr size_t num_threads = 4;
+	constexpr size_t per_thread = 5000; //More than one block of identifiers per thread.
+	std::vector<std::vector<uint64_t>> uids(num_threads);
+	std::vector<std::thread> threads;
+	for(size_t thread = 0; thread < num_threads; ++thread) {
+		threads.emplace_back([this, &uids, thread]() {
+			for(size_t i = 0; i < per_thread; ++i) {
+				uids[thread].push_back(ConvexPolygon(triangle).uid());
+			}
+		});
+	}
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+
+	std::unordered_set<uint64_t> unique;
+	for(const std::vector<uint64_t>& thread_uids : uids) {
+		unique.insert(thread_uids.begin(), thread_uids.end());
+	}
+	EXPECT_EQ(unique.size(), num_threads * per_thread) << "No two convex polygons may get the same identifier.";
+}
+
+/*!
+ * Test moving a convex polygon into a new one.
+ */
+TEST_F(ConvexPolygonFixture, Move) {
+	ConvexPolygon original(triangle);
+	original.translate(10, 20);
+	const uint64_t uid = original.uid();
+	const Transformation transformation = original.current_transformation();
+	const std::vector<Point2> vertices = original.get_vertices();
+
+	const ConvexPolygon moved(std::move(original));
+	EXPECT_EQ(moved.uid(), uid) << "Moving retains the identifier, like copying.";
+	EXPECT_EQ(moved.current_transformation(), transformation);
+	EXPECT_EQ(moved.get_vertices(), vertices);
+
+	ConvexPolygon assigned(star);
+	assigned = ConvexPolygon(moved);
+	EXPECT_EQ(assigned.uid(), uid) << "Move assignment also retains the identifier.";
+	EXPECT_EQ(assigned.get_vertices(), vertices);
+}
+
+/*!
+ * Test constructing a convex polygon by taking over a list of vertices.
+ */
+TEST_F(ConvexPolygonFixture, MoveVertices) {
+	std::vector<Point2> vertices(triangle);
+	const Point2* data = vertices.data();
+	const ConvexPolygon polygon(std::move(vertices));
+	EXPECT_EQ(polygon.get_vertices(), triangle);
+	EXPECT_EQ(polygon.get_vertices().data(), data) << "The vertices must be taken over, not copied.";
+	EXPECT_EQ(polygon.get_bounding_box(), BoundingBox(triangle)) << "The bounding box must be computed from the vertices that were taken over.";
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <gtest/gtest.h> //To run the test.
+
+#include "convex_polygon.hpp" //To add to the layout.
+#include "layout.hpp" //The unit under test.
+#include "point2.hpp" //To construct convex polygons.
+#include "spatial_index.hpp" //To test collisions with the layout.
+
+namespace convack {
+
+/*!
+ * Test the state of a layout before anything was added.
+ */
+TEST(Layout, Empty) {
+	const Layout layout;
+	EXPECT_TRUE(layout.empty());
+	EXPECT_TRUE(layout.get_convex_polygons().empty());
+	EXPECT_TRUE(layout.get_convex_hull().get_vertices().empty()) << "There is nothing to make a convex hull around.";
+	EXPECT_EQ(layout.get_covered_area(), 0);
+	EXPECT_EQ(layout.get_index().size(), 0);
+}
+
+/*!
+ * Test that adding convex polygons keeps the convex hull, covered area and
+ * index up to date.
+ */
+TEST(Layout, Add) {
+	Layout layout;
+	const ConvexPolygon square({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)});
+	layout.add(square, 0);
+	EXPECT_FALSE(layout.empty());
+	EXPECT_EQ(layout.get_convex_hull(), square) << "With one convex polygon, the convex hull is that convex polygon itself.";
+
+	const ConvexPolygon next({Point2(10, 0), Point2(20, 0), Point2(20, 10), Point2(10, 10)});
+	layout.add(next, 3);
+	ASSERT_EQ(layout.get_convex_polygons().size(), 2);
+	ASSERT_EQ(layout.get_rotations().size(), 2);
+	EXPECT_EQ(layout.get_rotations()[1], 3) << "The rotation of each convex polygon is remembered.";
+	EXPECT_EQ(layout.get_covered_area(), 200);
+	EXPECT_EQ(layout.get_convex_hull().area(), 200) << "The two squares form a rectangle together.";
+	EXPECT_TRUE(layout.get_index().collides(ConvexPolygon({Point2(15, 5), Point2(25, 5), Point2(25, 15)}))) << "The index must contain the second square.";
+}
+
+/*!
+ * Test that the index still finds the first convex polygons after the layout
+ * has grown a lot.
+ */
+TEST(Layout, AddMany) {
+	Layout layout;
+	for(int i = 0; i < 1000; ++i) {
+		layout.add(ConvexPolygon({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)}).translate(i * 10, 0), 0);
+	}
+	EXPECT_EQ(layout.get_index().size(), 1000);
+	EXPECT_TRUE(layout.get_index().collides(ConvexPolygon({Point2(2, 2), Point2(8, 2), Point2(8, 8)}))) << "The first square must still be found, even though many were added after it.";
+	EXPECT_EQ(layout.get_convex_hull().get_vertices().size(), 4) << "The convex hull around a row of squares is a rectangle.";
+}
+
+/*!
+ * Test clearing a layout.
+ */
+TEST(Layout, Clear) {
+	Layout layout;
+	layout.add(ConvexPolygon({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)}), 0);
+	layout.clear();
+	EXPECT_TRUE(layout.empty());
+	EXPECT_TRUE(layout.get_rotations().empty());
+	EXPECT_EQ(layout.get_covered_area(), 0);
+	EXPECT_EQ(layout.get_index().size(), 0);
+	EXPECT_TRUE(layout.get_convex_hull().get_vertices().empty());
+}
+
+}
\ No newline at end of file
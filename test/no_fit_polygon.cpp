@@ -0,0 +1,148 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <cmath> //To construct regular polygons.
+#include <gtest/gtest.h> //To run the test.
+#include <limits> //To check whether coordinates are integers.
+#include <random> //To generate random translations.
+#include <vector> //To construct convex polygons.
+
+#include "convex_polygon.hpp" //To construct no-fit polygons.
+#include "coordinate.hpp" //To round translations to coordinates.
+#include "no_fit_polygon.hpp" //The unit under test.
+#include "point2.hpp" //To construct convex polygons.
+
+namespace convack {
+
+/*!
+ * Fixture with some convex polygons to compute no-fit polygons of.
+ */
+class NoFitPolygonFixture : public testing::Test {
+public:
+	/*!
+	 * A square of 10 by 10 units, with its lower left corner on the origin.
+	 */
+	ConvexPolygon square;
+
+	/*!
+	 * A triangle of 20 units wide and 10 units high.
+	 */
+	ConvexPolygon triangle;
+
+	/*!
+	 * A regular hexagon with a radius of 10, around the origin.
+	 */
+	ConvexPolygon hexagon;
+
+	NoFitPolygonFixture() : square({}), triangle({}), hexagon({}) {}
+
+	/*!
+	 * Prepare to run a test. This creates the fixture members.
+	 */
+	void SetUp() {
+		square = ConvexPolygon({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)});
+		triangle = ConvexPolygon({Point2(0, 0), Point2(20, 0), Point2(10, 10)});
+		const double pi = std::acos(-1);
+		std::vector<Point2> vertices;
+		for(size_t i = 0; i < 6; ++i) {
+			vertices.emplace_back(std::cos(pi / 3 * i) * 10, std::sin(pi / 3 * i) * 10);
+		}
+		hexagon = ConvexPolygon(vertices);
+	}
+};
+
+/*!
+ * Test the Minkowski sum of two squares, which is a bigger square.
+ */
+TEST_F(NoFitPolygonFixture, MinkowskiSumSquares) {
+	ConvexPolygon moved(square);
+	moved.translate(5, 5);
+	const ConvexPolygon sum = NoFitPolygon::minkowski_sum(square, moved);
+	const std::vector<Point2> expected = {Point2(5, 5), Point2(25, 5), Point2(25, 25), Point2(5, 25)};
+	EXPECT_EQ(sum.get_vertices(), expected) << "Parallel edges get merged, so there are only 4 vertices.";
+}
+
+/*!
+ * Test that the area of a Minkowski sum is correct.
+ *
+ * The area of the Minkowski sum of a convex polygon with a mirror image of
+ * itself is 4 times the area if it's centrally symmetric, like a square or a
+ * hexagon.
+ */
+TEST_F(NoFitPolygonFixture, MinkowskiSumArea) {
+	EXPECT_NEAR(NoFitPolygon(square, square).get_polygon().area(), square.area() * 4, 0.01);
+	EXPECT_NEAR(NoFitPolygon(hexagon, hexagon).get_polygon().area(), hexagon.area() * 4, 0.01);
+	EXPECT_EQ(NoFitPolygon(triangle, square).get_polygon().get_vertices().size(), 6) << "The base of the triangle is parallel to the top and bottom of the square, so those edges merge.";
+}
+
+/*!
+ * Test the Minkowski sum with an empty convex polygon.
+ */
+TEST_F(NoFitPolygonFixture, MinkowskiSumEmpty) {
+	EXPECT_TRUE(NoFitPolygon::minkowski_sum(square, ConvexPolygon({})).get_vertices().empty());
+	EXPECT_TRUE(NoFitPolygon::minkowski_sum(ConvexPolygon({}), square).get_vertices().empty());
+}
+
+/*!
+ * Test that translating by a touching translation makes the convex polygons
+ * touch, but not collide.
+ */
+TEST_F(NoFitPolygonFixture, TouchingTranslations) {
+	const NoFitPolygon no_fit_polygon(hexagon, triangle);
+	for(const Point2& translation : no_fit_polygon.get_touching_translations()) {
+		ConvexPolygon moved(triangle);
+		moved.translate(translation.x, translation.y);
+		EXPECT_FALSE(hexagon.collides(moved)) << "At " << translation << " the convex polygons must only touch.";
+		const double inwards = std::numeric_limits<coordinate_t>::is_integer ? 0.5 : 0.01; //Whole units can't move a hundredth of the way, so then move halfway.
+		moved.translate(to_coordinate(-translation.x * inwards), to_coordinate(-translation.y * inwards)); //The origin is inside of the no-fit polygon, so this moves it inside a bit.
+		EXPECT_TRUE(hexagon.collides(moved)) << "Slightly further in from " << translation << " the convex polygons must overlap.";
+	}
+}
+
+/*!
+ * Test that the no-fit polygon predicts overlap the same way as testing for
+ * collisions does, for random translations.
+ */
+TEST_F(NoFitPolygonFixture, OverlapsRandom) {
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> distribution(-40, 40);
+	const NoFitPolygon no_fit_polygon(hexagon, triangle);
+	for(size_t i = 0; i < 1000; ++i) {
+		const Point2 translation(distribution(generator), distribution(generator));
+		ConvexPolygon moved(triangle);
+		moved.translate(translation.x, translation.y);
+		EXPECT_EQ(no_fit_polygon.overlaps(translation), hexagon.collides(moved)) << "Translated by " << translation << ".";
+	}
+}
+
+/*!
+ * Test finding where a line of translations leaves the no-fit polygon.
+ */
+TEST_F(NoFitPolygonFixture, ExitDistance) {
+	const NoFitPolygon no_fit_polygon(square, square); //A square from -10 to 10 in both dimensions.
+	double distance = -1;
+	ASSERT_TRUE(no_fit_polygon.exit_distance(Point2(0, 0), 1, 0, distance));
+	EXPECT_NEAR(distance, 10, 0.0001) << "Moving right, the square touches the other at 10 units.";
+	ASSERT_TRUE(no_fit_polygon.exit_distance(Point2(0, 0), 0, -1, distance));
+	EXPECT_NEAR(distance, 10, 0.0001) << "Moving down, the square touches the other at 10 units.";
+	const double diagonal = std::sqrt(0.5);
+	ASSERT_TRUE(no_fit_polygon.exit_distance(Point2(0, 0), diagonal, diagonal, distance));
+	EXPECT_NEAR(distance, std::sqrt(200), 0.0001) << "Moving diagonally, the squares touch at the corners.";
+	ASSERT_TRUE(no_fit_polygon.exit_distance(Point2(-30, 5), 1, 0, distance));
+	EXPECT_NEAR(distance, 40, 0.0001) << "Starting outside of the no-fit polygon, the line leaves it on the far side.";
+}
+
+/*!
+ * Test lines of translations that don't go through the no-fit polygon.
+ */
+TEST_F(NoFitPolygonFixture, ExitDistanceMiss) {
+	const NoFitPolygon no_fit_polygon(square, square); //A square from -10 to 10 in both dimensions.
+	double distance = -1;
+	EXPECT_FALSE(no_fit_polygon.exit_distance(Point2(0, 20), 1, 0, distance)) << "The line passes above the no-fit polygon.";
+	EXPECT_FALSE(no_fit_polygon.exit_distance(Point2(0, 10), 1, 0, distance)) << "The line only grazes the no-fit polygon, so the squares slide along each other.";
+	EXPECT_EQ(distance, -1) << "Nothing was found, so the distance must not be changed.";
+}
+
+}
\ No newline at end of file
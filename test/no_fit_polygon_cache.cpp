@@ -0,0 +1,187 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <gtest/gtest.h> //To run the test.
+#include <memory> //To get no-fit polygons from the cache.
+#include <thread> //To use the cache from multiple threads.
+#include <vector> //To construct convex polygons.
+
+#include "convex_polygon.hpp" //To compute no-fit polygons of.
+#include "no_fit_polygon.hpp" //To compare cached no-fit polygons with computed ones.
+#include "no_fit_polygon_cache.hpp" //The unit under test.
+#include "point2.hpp" //To construct convex polygons.
+
+namespace convack {
+
+/*!
+ * Fixture with some convex polygons to cache the no-fit polygons of.
+ */
+class NoFitPolygonCacheFixture : public testing::Test {
+public:
+	/*!
+	 * A square of 10 by 10 units, with its lower left corner on the origin.
+	 */
+	ConvexPolygon square;
+
+	/*!
+	 * A triangle of 20 units wide and 10 units high.
+	 */
+	ConvexPolygon triangle;
+
+	NoFitPolygonCacheFixture() : square({}), triangle({}) {}
+
+	/*!
+	 * Prepare to run a test. This creates the fixture members.
+	 */
+	void SetUp() {
+		square = ConvexPolygon({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)});
+		triangle = ConvexPolygon({Point2(0, 0), Point2(20, 0), Point2(10, 10)});
+	}
+};
+
+/*!
+ * Test that the second request for the same pair of shapes is a hit.
+ */
+TEST_F(NoFitPolygonCacheFixture, HitAndMiss) {
+	NoFitPolygonCache cache;
+	Point2 translation(0, 0);
+	const std::shared_ptr<const NoFitPolygon> first = cache.get(square, 0, triangle, 0, translation);
+	EXPECT_EQ(cache.get_hits(), 0);
+	EXPECT_EQ(cache.get_misses(), 1) << "The cache was empty.";
+	const std::shared_ptr<const NoFitPolygon> second = cache.get(square, 0, triangle, 0, translation);
+	EXPECT_EQ(cache.get_hits(), 1) << "The same pair was requested again.";
+	EXPECT_EQ(cache.get_misses(), 1);
+	EXPECT_EQ(first, second) << "A hit returns the cached no-fit polygon itself.";
+	EXPECT_EQ(cache.size(), 1);
+
+	cache.get(triangle, 0, square, 0, translation);
+	EXPECT_EQ(cache.get_misses(), 2) << "The no-fit polygon depends on which convex polygon is stationary.";
+	cache.get(square, 1, triangle, 0, translation);
+	EXPECT_EQ(cache.get_misses(), 3) << "A different rotation index is a different shape.";
+}
+
+/*!
+ * Test that translated copies reuse the no-fit polygon, and that it gives the
+ * correct result after translating it to where the copies are.
+ */
+TEST_F(NoFitPolygonCacheFixture, TranslatedCopies) {
+	NoFitPolygonCache cache;
+	Point2 translation(0, 0);
+	cache.get(square, 0, triangle, 0, translation);
+
+	ConvexPolygon moved_square(square);
+	moved_square.translate(30, -20);
+	ConvexPolygon moved_triangle(triangle);
+	moved_triangle.translate(-5, 12);
+	const std::shared_ptr<const NoFitPolygon> cached = cache.get(moved_square, 0, moved_triangle, 0, translation);
+	EXPECT_EQ(cache.get_hits(), 1) << "Copies retain their identifier, and translating them doesn't change their shape.";
+
+	ConvexPolygon expected = NoFitPolygon(moved_square, moved_triangle).get_polygon();
+	ConvexPolygon result(cached->get_polygon());
+	result.translate(translation.x, translation.y);
+	EXPECT_EQ(result, expected) << "Translated to the actual positions, it must be the no-fit polygon of the copies.";
+}
+
+/*!
+ * Test that the cached no-fit polygon is computed from the shape that copies
+ * were translated from, so it doesn't depend on which copy was looked up first.
+ */
+TEST_F(NoFitPolygonCacheFixture, ShapeOfCopies) {
+	ConvexPolygon shape({Point2(0.1, 0.3), Point2(10.7, 0.2), Point2(5.3, 9.9)});
+	ConvexPolygon first_copy(shape);
+	first_copy.translate(1000.3, -700.1); //Far away, so that the coordinates round differently.
+	ConvexPolygon second_copy(shape);
+	second_copy.translate(-30.9, 12.7);
+
+	NoFitPolygonCache first_cache;
+	NoFitPolygonCache second_cache;
+	Point2 first_translation(0, 0);
+	Point2 second_translation(0, 0);
+	const std::shared_ptr<const NoFitPolygon> first = first_cache.get(first_copy, shape, 0, square, 0, first_translation);
+	const std::shared_ptr<const NoFitPolygon> second = second_cache.get(second_copy, shape, 0, square, 0, second_translation);
+	EXPECT_EQ(first->get_polygon().get_vertices(), second->get_polygon().get_vertices()) << "Both are computed from the same shape, whichever copy asked for it.";
+	EXPECT_EQ(first_translation, first_copy.get_vertices()[0] - square.get_vertices()[0]) << "The translation is still to where the copy actually is.";
+	EXPECT_EQ(second_translation, second_copy.get_vertices()[0] - square.get_vertices()[0]) << "The translation is still to where the copy actually is.";
+
+	Point2 translation(0, 0);
+	EXPECT_EQ(first_cache.get(second_copy, shape, 0, square, 0, translation), first) << "Other copies of the same shape reuse it.";
+	EXPECT_EQ(translation, second_translation);
+}
+
+/*!
+ * Test that a rotated copy is not mistaken for the original, even with the
+ * same rotation index.
+ */
+TEST_F(NoFitPolygonCacheFixture, RotatedCopy) {
+	NoFitPolygonCache cache;
+	Point2 translation(0, 0);
+	cache.get(square, 0, triangle, 0, translation);
+
+	ConvexPolygon rotated_triangle(triangle);
+	rotated_triangle.rotate(1);
+	cache.get(square, 0, rotated_triangle, 0, translation);
+	EXPECT_EQ(cache.get_hits(), 0) << "The shape is different, so the cached no-fit polygon can't be used.";
+	EXPECT_EQ(cache.size(), 1) << "The no-fit polygon of the rotated copy replaces the old one.";
+}
+
+/*!
+ * Test that the least recently used no-fit polygon is forgotten when the cache
+ * is full.
+ */
+TEST_F(NoFitPolygonCacheFixture, LeastRecentlyUsed) {
+	NoFitPolygonCache cache(2);
+	Point2 translation(0, 0);
+	cache.get(square, 0, triangle, 0, translation);
+	cache.get(triangle, 0, square, 0, translation);
+	cache.get(square, 0, triangle, 0, translation); //Now the other one is the least recently used.
+	cache.get(square, 0, square, 0, translation); //Pushes out the least recently used one.
+	EXPECT_EQ(cache.size(), 2) << "The cache must not grow beyond its capacity.";
+	EXPECT_EQ(cache.get_misses(), 3);
+
+	cache.get(square, 0, triangle, 0, translation);
+	EXPECT_EQ(cache.get_misses(), 3) << "This one was used recently, so it was kept.";
+	cache.get(triangle, 0, square, 0, translation);
+	EXPECT_EQ(cache.get_misses(), 4) << "This one was used least recently, so it was forgotten.";
+
+	cache.set_capacity(1);
+	EXPECT_EQ(cache.size(), 1) << "Reducing the capacity forgets the least recently used ones.";
+	cache.clear();
+	EXPECT_EQ(cache.size(), 0);
+}
+
+/*!
+ * Test that nothing is cached with a capacity of 0.
+ */
+TEST_F(NoFitPolygonCacheFixture, Disabled) {
+	NoFitPolygonCache cache(0);
+	Point2 translation(0, 0);
+	EXPECT_NE(cache.get(square, 0, triangle, 0, translation), nullptr) << "Even without caching, the no-fit polygon is computed.";
+	cache.get(square, 0, triangle, 0, translation);
+	EXPECT_EQ(cache.size(), 0);
+	EXPECT_EQ(cache.get_misses(), 2) << "Nothing is cached, so everything is a miss.";
+}
+
+/*!
+ * Test using the cache from multiple threads at the same time.
+ */
+TEST_F(NoFitPolygonCacheFixture, Multithreaded) {
+	NoFitPolygonCache cache(1);
+	std::vector<std::thread> threads;
+	for(size_t thread = 0; thread < 4; ++thread) {
+		threads.emplace_back([&]() {
+			Point2 translation(0, 0);
+			for(size_t i = 0; i < 1000; ++i) {
+				cache.get(i % 2 ? square : triangle, 0, square, 0, translation);
+			}
+		});
+	}
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(cache.get_hits() + cache.get_misses(), 4000) << "Every request is counted once.";
+	EXPECT_EQ(cache.size(), 1);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <gtest/gtest.h> //To run the test.
+#include <sstream> //To test streaming the statistics.
+
+#include "pack_statistics.hpp" //The unit under test.
+
+namespace convack {
+
+/*!
+ * Test that new statistics start at 0.
+ */
+TEST(PackStatistics, Construct) {
+	const PackStatistics statistics;
+	EXPECT_EQ(statistics.candidates_generated, 0);
+	EXPECT_EQ(statistics.collision_tests, 0);
+	EXPECT_EQ(statistics.allocations, 0);
+	EXPECT_TRUE(statistics.depth_times.empty());
+	EXPECT_FALSE(statistics.budget_exhausted);
+}
+
+/*!
+ * Test adding statistics together.
+ */
+TEST(PackStatistics, Add) {
+	PackStatistics a;
+	a.candidates_generated = 10;
+	a.cache_hits = 3;
+	a.depth_times = {1.0, 2.0};
+	PackStatistics b;
+	b.candidates_generated = 5;
+	b.cache_misses = 7;
+	b.depth_times = {0.5, 0.5, 0.5};
+
+	a += b;
+	EXPECT_EQ(a.candidates_generated, 15);
+	EXPECT_EQ(a.cache_hits, 3);
+	EXPECT_EQ(a.cache_misses, 7);
+	ASSERT_EQ(a.depth_times.size(), 3) << "The longest of the two searches determines the number of depths.";
+	EXPECT_EQ(a.depth_times[0], 1.5);
+	EXPECT_EQ(a.depth_times[1], 2.5);
+	EXPECT_EQ(a.depth_times[2], 0.5);
+	EXPECT_FALSE(a.budget_exhausted);
+	b.budget_exhausted = true;
+	a += b;
+	EXPECT_TRUE(a.budget_exhausted) << "If any of the searches ran out of budget, the total did too.";
+}
+
+/*!
+ * Test clearing the statistics.
+ */
+TEST(PackStatistics, Clear) {
+	PackStatistics statistics;
+	statistics.score_evaluations = 42;
+	statistics.depth_times = {1.0};
+	statistics.clear();
+	EXPECT_EQ(statistics.score_evaluations, 0);
+	EXPECT_TRUE(statistics.depth_times.empty());
+}
+
+/*!
+ * Test writing the statistics to a stream.
+ */
+TEST(PackStatistics, Stream) {
+	PackStatistics statistics;
+	statistics.hull_computations = 12345;
+	std::stringstream stream;
+	stream << statistics;
+	EXPECT_NE(stream.str().find("hull computations: 12345"), std::string::npos) << "The summary must contain the counters.";
+}
+
+}
\ No newline at end of file
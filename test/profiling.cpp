@@ -0,0 +1,80 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <chrono> //To record events with a known duration.
+#include <gtest/gtest.h> //To run the test.
+#include <sstream> //To write the trace to a string.
+#include <thread> //To record events on multiple threads.
+
+#include "profiling.hpp" //The unit under test.
+
+namespace convack {
+
+/*!
+ * Test recording an event and writing it to a trace.
+ */
+TEST(Profiling, Record) {
+	Profiler::clear();
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Profiler::record("recorded", start, start + std::chrono::microseconds(5));
+	EXPECT_EQ(Profiler::size(), 1);
+
+	std::stringstream trace;
+	Profiler::write_trace(trace);
+	EXPECT_NE(trace.str().find("{\"name\":\"recorded\",\"cat\":\"convack\",\"ph\":\"X\""), std::string::npos) << "The event is written as a complete event with its name.";
+	EXPECT_NE(trace.str().find("\"dur\":5.000000}"), std::string::npos) << "The duration is written in microseconds.";
+}
+
+/*!
+ * Test that a zone records an event when it ends.
+ */
+TEST(Profiling, Zone) {
+	Profiler::clear();
+	{
+		const ProfileZone zone("zone");
+		EXPECT_EQ(Profiler::size(), 0) << "The zone hasn't ended yet.";
+	}
+	EXPECT_EQ(Profiler::size(), 1);
+}
+
+/*!
+ * Test forgetting the events recorded so far.
+ */
+TEST(Profiling, Clear) {
+	{
+		const ProfileZone zone("zone");
+	}
+	Profiler::clear();
+	EXPECT_EQ(Profiler::size(), 0);
+	std::stringstream trace;
+	Profiler::write_trace(trace);
+	EXPECT_EQ(trace.str(), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n") << "Without events, the trace is still a valid document.";
+}
+
+/*!
+ * Test that the events of each thread are kept, also after the thread ended.
+ */
+TEST(Profiling, Threads) {
+	Profiler::clear();
+	{
+		const ProfileZone zone("main");
+	}
+	std::thread worker([]() {
+		const ProfileZone zone("worker");
+	});
+	worker.join();
+	EXPECT_EQ(Profiler::size(), 2);
+
+	std::stringstream trace;
+	Profiler::write_trace(trace);
+	const std::string text = trace.str();
+	const size_t main_tid = text.find("\"tid\":", text.find("\"main\""));
+	const size_t worker_tid = text.find("\"tid\":", text.find("\"worker\""));
+	ASSERT_NE(main_tid, std::string::npos);
+	ASSERT_NE(worker_tid, std::string::npos);
+	EXPECT_NE(text.substr(main_tid, text.find(',', main_tid) - main_tid), text.substr(worker_tid, text.find(',', worker_tid) - worker_tid)) << "Each thread gets its own row in the trace.";
+}
+
+}
\ No newline at end of file
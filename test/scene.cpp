@@ -0,0 +1,784 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <cmath> //To construct regular polygons.
+#include <deque> //To check the layout of convex polygons packed in groups.
+#include <gtest/gtest.h> //To run the test.
+#include <random> //To generate convex polygons with arbitrary coordinates.
+#include <thread> //To run packings on a custom executor.
+#include <vector> //To store the convex polygons to pack.
+
+#include "bounding_box.hpp" //To check where convex polygons were left.
+#include "cancellation.hpp" //To test cancelling packings.
+#include "convex_polygon.hpp" //To create convex polygons to pack.
+#include "layout.hpp" //To check the layout of convex polygons packed in groups.
+#include "pack_progress.hpp" //To test reporting progress.
+#include "pack_statistics.hpp" //To test measuring the packing.
+#include "point2.hpp" //To create convex polygons to pack.
+#include "scene.hpp" //The unit under test.
+#include "transformation.hpp" //To check the reported transformations.
+
+namespace convack {
+
+/*!
+ * Fixture with some convex polygons to pack.
+ */
+class SceneFixture : public testing::Test {
+public:
+	/*!
+	 * Regular polygons with 3 to 10 sides, all around the coordinate origin so
+	 * that they all overlap before packing.
+	 */
+	std::vector<ConvexPolygon> regular_polygons;
+
+	/*!
+	 * Prepare to run a test. This creates the fixture members.
+	 */
+	void SetUp() {
+		regular_polygons.clear();
+		const double pi = std::acos(-1);
+		for(size_t num_sides = 3; num_sides <= 10; ++num_sides) {
+			std::vector<Point2> vertices;
+			for(size_t i = 0; i < num_sides; ++i) {
+				const double angle = 2.0 * pi / num_sides * i;
+				vertices.emplace_back(std::cos(angle) * 10, std::sin(angle) * 10);
+			}
+			regular_polygons.emplace_back(vertices);
+		}
+	}
+
+	/*!
+	 * Create regular polygons of random sizes in random places.
+	 *
+	 * Unlike the regular polygons of the fixture, their coordinates are not
+	 * nicely rounded, so the placements of their copies round differently.
+	 * That's where the number of threads could affect the packing.
+	 * \param seed The seed for the random generator, so that the tests are
+	 * deterministic.
+	 * \return 25 convex polygons with 3 to 8 vertices.
+	 */
+	static std::vector<ConvexPolygon> random_polygons(const unsigned int seed) {
+		std::mt19937 generator(seed);
+		std::uniform_int_distribution<size_t> num_sides(3, 8);
+		std::uniform_real_distribution<double> radius(1, 10);
+		std::uniform_real_distribution<double> position(-50, 50);
+		std::uniform_real_distribution<double> phase(0, 1);
+		const double pi = std::acos(-1);
+		std::vector<ConvexPolygon> result;
+		for(size_t polygon = 0; polygon < 25; ++polygon) {
+			const size_t sides = num_sides(generator);
+			const double polygon_radius = radius(generator);
+			const double offset_x = position(generator);
+			const double offset_y = position(generator);
+			const double start_angle = phase(generator);
+			std::vector<Point2> vertices;
+			for(size_t i = 0; i < sides; ++i) {
+				const double angle = 2.0 * pi / sides * (i + start_angle);
+				vertices.emplace_back(std::cos(angle) * polygon_radius + offset_x, std::sin(angle) * polygon_radius + offset_y);
+			}
+			result.push_back(ConvexPolygon::convex_hull(vertices)); //With fixed point coordinates, rounding the vertices to whole units may make them concave.
+		}
+		return result;
+	}
+};
+
+/*!
+ * Test packing an empty set of convex polygons.
+ */
+TEST(Scene, PackEmpty) {
+	std::vector<ConvexPolygon> empty;
+	Scene().pack(empty);
+	EXPECT_TRUE(empty.empty()) << "Nothing was there to pack, so nothing was packed.";
+}
+
+/*!
+ * Test packing a single convex polygon.
+ */
+TEST(Scene, PackSingle) {
+	const ConvexPolygon original({Point2(0, 0), Point2(50, 0), Point2(25, 50)});
+	std::vector<ConvexPolygon> single({original});
+	Scene().pack(single);
+
+	ASSERT_EQ(single.size(), 1) << "The list of convex polygons must keep its size.";
+	EXPECT_EQ(single[0].area(), original.area()) << "Packing only moves convex polygons. It doesn't change their shape.";
+}
+
+/*!
+ * Test that packed convex polygons don't overlap each other.
+ */
+TEST_F(SceneFixture, PackNoCollisions) {
+	Scene().pack(regular_polygons);
+
+	for(size_t i = 0; i < regular_polygons.size(); ++i) {
+		for(size_t j = i + 1; j < regular_polygons.size(); ++j) {
+			EXPECT_FALSE(regular_polygons[i].collides(regular_polygons[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+/*!
+ * Test that packing keeps the order of the convex polygons, and reports how
+ * they were moved.
+ */
+TEST_F(SceneFixture, PackKeepsOrder) {
+	const std::vector<ConvexPolygon> original = regular_polygons;
+	Scene().pack(regular_polygons);
+
+	ASSERT_EQ(regular_polygons.size(), original.size()) << "No convex polygons must be added or removed.";
+	for(size_t i = 0; i < regular_polygons.size(); ++i) {
+		EXPECT_EQ(regular_polygons[i].uid(), original[i].uid()) << "The convex polygons must still be in their original order.";
+		const std::vector<Point2>& vertices = regular_polygons[i].get_vertices();
+		const std::vector<Point2>& original_vertices = original[i].get_vertices();
+		ASSERT_EQ(vertices.size(), original_vertices.size());
+		for(size_t vertex = 0; vertex < vertices.size(); ++vertex) {
+			const Point2 transformed = regular_polygons[i].current_transformation().apply(original_vertices[vertex]);
+			EXPECT_NEAR(transformed.x, vertices[vertex].x, 0.001) << "The transformation must describe how the convex polygon was moved.";
+			EXPECT_NEAR(transformed.y, vertices[vertex].y, 0.001) << "The transformation must describe how the convex polygon was moved.";
+		}
+	}
+}
+
+/*!
+ * Test that packing with multiple threads gives the same result as packing
+ * with a single thread.
+ */
+TEST_F(SceneFixture, PackMultithreaded) {
+	std::vector<ConvexPolygon> single_threaded = regular_polygons;
+	Scene single_scene;
+	single_scene.set_num_threads(1);
+	single_scene.pack(single_threaded);
+
+	std::vector<ConvexPolygon> multi_threaded = regular_polygons;
+	Scene multi_scene;
+	multi_scene.set_num_threads(4);
+	multi_scene.pack(multi_threaded);
+
+	ASSERT_EQ(single_threaded.size(), multi_threaded.size());
+	for(size_t i = 0; i < single_threaded.size(); ++i) {
+		EXPECT_EQ(single_threaded[i].get_vertices(), multi_threaded[i].get_vertices()) << "The packing must not depend on the number of threads.";
+	}
+}
+
+/*!
+ * Test that the merged beam doesn't depend on the number of threads, for convex
+ * polygons with arbitrary coordinates. Without a budget, this holds even if the
+ * packing isn't set to be deterministic.
+ */
+TEST(Scene, PackMultithreadedRandom) {
+	for(unsigned int seed = 0; seed < 3; ++seed) {
+		std::vector<ConvexPolygon> single_threaded = SceneFixture::random_polygons(seed);
+		Scene single_scene;
+		single_scene.set_beam_width(8);
+		single_scene.set_num_threads(1);
+		single_scene.pack(single_threaded);
+
+		std::vector<ConvexPolygon> multi_threaded = SceneFixture::random_polygons(seed);
+		Scene multi_scene;
+		multi_scene.set_beam_width(8);
+		multi_scene.set_num_threads(8);
+		multi_scene.pack(multi_threaded);
+
+		ASSERT_EQ(single_threaded.size(), multi_threaded.size());
+		for(size_t i = 0; i < single_threaded.size(); ++i) {
+			EXPECT_EQ(single_threaded[i].get_vertices(), multi_threaded[i].get_vertices()) << "Seed " << seed << ": The packing must not depend on the number of threads.";
+		}
+	}
+}
+
+/*!
+ * Test packing lazy convex polygons with multiple threads. Their pending
+ * transformations must be applied before the threads read them.
+ */
+TEST(Scene, PackLazyMultithreaded) {
+	std::vector<ConvexPolygon> eager;
+	std::vector<ConvexPolygon> lazy;
+	for(size_t i = 0; i < 8; ++i) {
+		ConvexPolygon rectangle(std::vector<Point2>{Point2(0, 0), Point2(10, 0), Point2(10, 5), Point2(0, 5)});
+		eager.push_back(rectangle);
+		eager.back().translate(i * 3, i * 2);
+		rectangle.set_lazy(true);
+		rectangle.translate(i * 3, i * 2); //Leave the translation pending.
+		lazy.push_back(rectangle);
+	}
+	Scene scene;
+	scene.set_num_threads(4);
+	scene.pack(eager);
+	scene.pack(lazy);
+
+	ASSERT_EQ(eager.size(), lazy.size());
+	for(size_t i = 0; i < eager.size(); ++i) {
+		EXPECT_EQ(eager[i].get_vertices(), lazy[i].get_vertices()) << "Lazy convex polygons must be packed the same as eager ones.";
+	}
+}
+
+/*!
+ * Test packing from multiple threads at the same time in one scene.
+ */
+TEST_F(SceneFixture, PackConcurrently) {
+	const Scene scene;
+	std::vector<ConvexPolygon> expected = regular_polygons;
+	scene.pack(expected);
+
+	std::vector<std::vector<ConvexPolygon>> results(4, regular_polygons);
+	std::vector<std::thread> threads;
+	for(std::vector<ConvexPolygon>& result : results) {
+		threads.emplace_back([&scene, &result]() {
+			scene.pack(result);
+		});
+	}
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+	for(const std::vector<ConvexPolygon>& result : results) {
+		for(size_t i = 0; i < expected.size(); ++i) {
+			EXPECT_EQ(result[i].get_vertices(), expected[i].get_vertices()) << "Packings at the same time must not disturb each other.";
+		}
+	}
+}
+
+/*!
+ * Test that packing copies of the same shapes reuses their no-fit polygons.
+ */
+TEST_F(SceneFixture, PackCache) {
+	Scene scene;
+	std::vector<ConvexPolygon> copies(4, regular_polygons[1]); //Four copies of a square.
+	scene.pack(copies);
+	EXPECT_GT(scene.get_cache_hits(), 0) << "The no-fit polygon of a square with a square is needed repeatedly.";
+	EXPECT_EQ(scene.get_cache_misses(), 1) << "All copies have the same shape, so only one no-fit polygon needs to be computed.";
+
+	scene.set_cache_size(0);
+	EXPECT_EQ(scene.get_cache_size(), 0);
+	const size_t misses = scene.get_cache_misses();
+	copies.assign(4, regular_polygons[1]);
+	scene.pack(copies);
+	EXPECT_GT(scene.get_cache_misses(), misses) << "Without a cache, everything must be computed again.";
+	for(size_t i = 0; i < copies.size(); ++i) {
+		for(size_t j = i + 1; j < copies.size(); ++j) {
+			EXPECT_FALSE(copies[i].collides(copies[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+
+/*!
+ * Test packing many copies of the same shapes.
+ *
+ * Copies are interchangeable, so the packing treats them as one. Each of them
+ * must still be packed.
+ */
+TEST_F(SceneFixture, PackCopies) {
+	std::vector<ConvexPolygon> copies;
+	for(size_t i = 0; i < 6; ++i) {
+		copies.push_back(regular_polygons[0]); //Triangles.
+		copies.push_back(regular_polygons[3]); //Hexagons.
+	}
+	const std::vector<ConvexPolygon> original = copies;
+	Scene().pack(copies);
+
+	for(size_t i = 0; i < copies.size(); ++i) {
+		EXPECT_NEAR(copies[i].area(), original[i].area(), 0.01) << "Every copy keeps its shape.";
+		for(size_t j = i + 1; j < copies.size(); ++j) {
+			EXPECT_FALSE(copies[i].collides(copies[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+
+/*!
+ * Test packing with multiple allowed rotations.
+ */
+TEST_F(SceneFixture, PackRotations) {
+	Scene scene;
+	const double pi = std::acos(-1);
+	scene.set_rotations({0, pi / 2, pi, pi * 3 / 2});
+	EXPECT_EQ(scene.get_rotations().size(), 4);
+	const std::vector<ConvexPolygon> original = regular_polygons;
+	scene.pack(regular_polygons);
+
+	for(size_t i = 0; i < regular_polygons.size(); ++i) {
+		EXPECT_NEAR(regular_polygons[i].area(), original[i].area(), 0.01) << "Rotating doesn't change the shape.";
+		const std::vector<Point2>& vertices = regular_polygons[i].get_vertices();
+		const std::vector<Point2>& original_vertices = original[i].get_vertices();
+		ASSERT_EQ(vertices.size(), original_vertices.size());
+		for(size_t vertex = 0; vertex < vertices.size(); ++vertex) {
+			const Point2 transformed = regular_polygons[i].current_transformation().apply(original_vertices[vertex]);
+			EXPECT_NEAR(transformed.x, vertices[vertex].x, 0.001) << "The transformation must describe how the convex polygon was rotated and moved.";
+			EXPECT_NEAR(transformed.y, vertices[vertex].y, 0.001) << "The transformation must describe how the convex polygon was rotated and moved.";
+		}
+		for(size_t j = i + 1; j < regular_polygons.size(); ++j) {
+			EXPECT_FALSE(regular_polygons[i].collides(regular_polygons[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+
+/*!
+ * Test packing convex polygons into a container.
+ */
+TEST(Scene, PackContainer) {
+	Scene scene;
+	const ConvexPolygon container({Point2(0, 0), Point2(35, 0), Point2(35, 35), Point2(0, 35)});
+	scene.set_container(container);
+	EXPECT_EQ(scene.get_container().get_vertices().size(), 4);
+	std::vector<ConvexPolygon> squares(9, ConvexPolygon({Point2(100, 100), Point2(110, 100), Point2(110, 110), Point2(100, 110)}));
+	scene.pack(squares);
+
+	for(size_t i = 0; i < squares.size(); ++i) {
+		EXPECT_TRUE(container.contains(squares[i])) << "Nine squares of 10 by 10 fit in a container of 35 by 35.";
+		for(size_t j = i + 1; j < squares.size(); ++j) {
+			EXPECT_FALSE(squares[i].collides(squares[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+/*!
+ * Test packing more convex polygons than fit in the container.
+ */
+TEST(Scene, PackContainerFull) {
+	Scene scene;
+	const ConvexPolygon container({Point2(0, 0), Point2(15, 0), Point2(15, 15), Point2(0, 15)});
+	scene.set_container(container);
+	const ConvexPolygon square({Point2(100, 100), Point2(110, 100), Point2(110, 110), Point2(100, 110)});
+	std::vector<ConvexPolygon> squares(2, square);
+	scene.pack(squares);
+
+	const size_t num_packed = container.contains(squares[0]) + container.contains(squares[1]);
+	EXPECT_EQ(num_packed, 1) << "Only one square fits in the container.";
+	const ConvexPolygon& left_out = container.contains(squares[0]) ? squares[1] : squares[0];
+	EXPECT_EQ(left_out.get_bounding_box(), square.get_bounding_box()) << "The square that doesn't fit must be left where it was.";
+}
+
+/*!
+ * Test that nothing is packed if nothing fits in the container.
+ */
+TEST(Scene, PackContainerTooSmall) {
+	Scene scene;
+	scene.set_container(ConvexPolygon({Point2(0, 0), Point2(5, 0), Point2(5, 5), Point2(0, 5)}));
+	const ConvexPolygon square({Point2(100, 100), Point2(110, 100), Point2(110, 110), Point2(100, 110)});
+	std::vector<ConvexPolygon> squares(1, square);
+	scene.pack(squares);
+	EXPECT_EQ(squares[0].get_bounding_box(), square.get_bounding_box()) << "The square doesn't fit, so it must be left where it was.";
+}
+
+/*!
+ * Test packing convex polygons around obstacles.
+ */
+TEST_F(SceneFixture, PackObstacles) {
+	Scene scene;
+	const std::vector<ConvexPolygon> obstacles({
+		ConvexPolygon({Point2(-5, -5), Point2(5, -5), Point2(5, 5), Point2(-5, 5)}),
+		ConvexPolygon({Point2(20, -5), Point2(30, -5), Point2(30, 5), Point2(20, 5)})
+	});
+	scene.set_obstacles(obstacles);
+	ASSERT_EQ(scene.get_obstacles().size(), 2);
+	scene.pack(regular_polygons);
+
+	for(size_t i = 0; i < regular_polygons.size(); ++i) {
+		for(const ConvexPolygon& obstacle : obstacles) {
+			EXPECT_FALSE(regular_polygons[i].collides(obstacle)) << "Packed convex polygon " << i << " must not overlap with the obstacles.";
+		}
+		for(size_t j = i + 1; j < regular_polygons.size(); ++j) {
+			EXPECT_FALSE(regular_polygons[i].collides(regular_polygons[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+/*!
+ * Test packing into a container with an obstacle in the middle.
+ */
+TEST(Scene, PackContainerObstacles) {
+	Scene scene;
+	const ConvexPolygon container({Point2(0, 0), Point2(40, 0), Point2(40, 40), Point2(0, 40)});
+	scene.set_container(container);
+	const ConvexPolygon obstacle({Point2(15, 15), Point2(25, 15), Point2(25, 25), Point2(15, 25)});
+	scene.set_obstacles({obstacle});
+	std::vector<ConvexPolygon> squares(4, ConvexPolygon({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)}));
+	scene.pack(squares);
+
+	for(size_t i = 0; i < squares.size(); ++i) {
+		EXPECT_TRUE(container.contains(squares[i])) << "There is plenty of room around the obstacle.";
+		EXPECT_FALSE(squares[i].collides(obstacle)) << "Packed convex polygon " << i << " must not overlap with the obstacle.";
+		for(size_t j = i + 1; j < squares.size(); ++j) {
+			EXPECT_FALSE(squares[i].collides(squares[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+/*!
+ * Test packing convex polygons that arrive in multiple groups.
+ */
+TEST_F(SceneFixture, PackMore) {
+	Scene scene;
+	std::vector<ConvexPolygon> first(regular_polygons.begin(), regular_polygons.begin() + 4);
+	scene.pack_more(first);
+	ASSERT_EQ(scene.get_layout().get_convex_polygons().size(), 4) << "The packed convex polygons are committed to the layout.";
+
+	std::vector<ConvexPolygon> second(regular_polygons.begin() + 4, regular_polygons.end());
+	PackStatistics statistics;
+	scene.pack_more(second, statistics);
+	EXPECT_EQ(statistics.depth_times.size(), second.size()) << "The search only needs to decide where the new convex polygons go.";
+
+	const std::deque<ConvexPolygon>& layout = scene.get_layout().get_convex_polygons();
+	ASSERT_EQ(layout.size(), regular_polygons.size());
+	for(size_t i = 0; i < first.size(); ++i) {
+		EXPECT_EQ(layout[i].get_vertices(), first[i].get_vertices()) << "The convex polygons packed earlier must not move.";
+	}
+	for(size_t i = 0; i < layout.size(); ++i) {
+		for(size_t j = i + 1; j < layout.size(); ++j) {
+			EXPECT_FALSE(layout[i].collides(layout[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap, even if they were packed in different groups.";
+		}
+	}
+}
+
+/*!
+ * Test that clearing the layout makes the next packing start from scratch.
+ */
+TEST_F(SceneFixture, PackMoreClear) {
+	Scene scene;
+	std::vector<ConvexPolygon> first = regular_polygons;
+	scene.pack_more(first);
+	scene.clear_layout();
+	EXPECT_TRUE(scene.get_layout().empty());
+
+	std::vector<ConvexPolygon> again = regular_polygons;
+	scene.pack_more(again);
+	for(size_t i = 0; i < first.size(); ++i) {
+		EXPECT_EQ(again[i].get_vertices(), first[i].get_vertices()) << "Without the earlier layout, the same convex polygons are packed the same way.";
+	}
+}
+
+/*!
+ * Test that packing normally doesn't use nor change the layout.
+ */
+TEST_F(SceneFixture, PackIgnoresLayout) {
+	Scene scene;
+	std::vector<ConvexPolygon> committed = regular_polygons;
+	scene.pack_more(committed);
+	std::vector<ConvexPolygon> separate = regular_polygons;
+	scene.pack(separate);
+	EXPECT_EQ(scene.get_layout().get_convex_polygons().size(), regular_polygons.size()) << "Normal packing doesn't commit to the layout.";
+	for(size_t i = 0; i < separate.size(); ++i) {
+		EXPECT_EQ(separate[i].get_vertices(), committed[i].get_vertices()) << "Normal packing starts from scratch.";
+	}
+}
+
+/*!
+ * Test that a packing that runs out of its budget still packs everything.
+ */
+TEST_F(SceneFixture, PackEvaluationBudget) {
+	Scene scene;
+	scene.set_evaluation_budget(1);
+	EXPECT_EQ(scene.get_evaluation_budget(), 1);
+	PackStatistics statistics;
+	scene.pack(regular_polygons, statistics);
+
+	EXPECT_TRUE(statistics.budget_exhausted) << "One evaluation is not enough for a beam search over 8 convex polygons.";
+	EXPECT_EQ(statistics.depth_times.size(), regular_polygons.size()) << "The convex polygons that didn't fit in the budget must still be packed.";
+	for(size_t i = 0; i < regular_polygons.size(); ++i) {
+		for(size_t j = i + 1; j < regular_polygons.size(); ++j) {
+			EXPECT_FALSE(regular_polygons[i].collides(regular_polygons[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+/*!
+ * Test that a time budget that runs out right away still packs everything.
+ */
+TEST_F(SceneFixture, PackTimeBudget) {
+	Scene scene;
+	scene.set_time_budget(0.000000001);
+	EXPECT_EQ(scene.get_time_budget(), 0.000000001);
+	scene.pack(regular_polygons);
+
+	for(size_t i = 0; i < regular_polygons.size(); ++i) {
+		for(size_t j = i + 1; j < regular_polygons.size(); ++j) {
+			EXPECT_FALSE(regular_polygons[i].collides(regular_polygons[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+/*!
+ * Test that a budget that doesn't run out gives the same packing as no budget.
+ */
+TEST_F(SceneFixture, PackBudgetSufficient) {
+	std::vector<ConvexPolygon> unlimited = regular_polygons;
+	Scene().pack(unlimited);
+
+	Scene scene;
+	scene.set_evaluation_budget(1000000000);
+	PackStatistics statistics;
+	scene.pack(regular_polygons, statistics);
+	EXPECT_FALSE(statistics.budget_exhausted);
+	for(size_t i = 0; i < regular_polygons.size(); ++i) {
+		EXPECT_EQ(regular_polygons[i].get_vertices(), unlimited[i].get_vertices()) << "The budget didn't run out, so the search is the same.";
+	}
+}
+
+/*!
+ * Test that a deterministic packing that runs out of its budget gives the same
+ * result regardless of the number of threads.
+ */
+TEST_F(SceneFixture, PackDeterministic) {
+	Scene scene;
+	scene.set_deterministic(true);
+	EXPECT_TRUE(scene.is_deterministic());
+	scene.set_beam_width(8);
+	scene.set_evaluation_budget(100);
+
+	std::vector<std::vector<ConvexPolygon>> results;
+	for(const size_t num_threads : {1, 2, 8}) {
+		std::vector<ConvexPolygon> convex_polygons = regular_polygons;
+		scene.set_num_threads(num_threads);
+		PackStatistics statistics;
+		scene.pack(convex_polygons, statistics);
+		EXPECT_TRUE(statistics.budget_exhausted) << "The budget must run out halfway, or this wouldn't test anything.";
+		results.push_back(convex_polygons);
+	}
+	for(size_t i = 0; i < regular_polygons.size(); ++i) {
+		EXPECT_EQ(results[1][i].get_vertices(), results[0][i].get_vertices()) << "The packing must not depend on the number of threads.";
+		EXPECT_EQ(results[2][i].get_vertices(), results[0][i].get_vertices()) << "The packing must not depend on the number of threads.";
+		EXPECT_EQ(results[2][i].current_transformation(), results[0][i].current_transformation());
+	}
+}
+
+/*!
+ * Test that deterministic packings of convex polygons with arbitrary coordinates
+ * give the same result regardless of the number of threads, with or without a
+ * budget.
+ */
+TEST(Scene, PackDeterministicRandom) {
+	for(unsigned int seed = 0; seed < 3; ++seed) {
+		for(const size_t evaluation_budget : {0, 2000}) {
+			std::vector<std::vector<ConvexPolygon>> results;
+			for(const size_t num_threads : {1, 2, 8}) {
+				std::vector<ConvexPolygon> convex_polygons = SceneFixture::random_polygons(seed);
+				Scene scene;
+				scene.set_deterministic(true);
+				scene.set_beam_width(8);
+				scene.set_evaluation_budget(evaluation_budget);
+				scene.set_num_threads(num_threads);
+				scene.pack(convex_polygons);
+				results.push_back(convex_polygons);
+			}
+			for(size_t i = 0; i < results[0].size(); ++i) {
+				EXPECT_EQ(results[1][i].get_vertices(), results[0][i].get_vertices()) << "Seed " << seed << ", budget " << evaluation_budget << ": The packing must not depend on the number of threads.";
+				EXPECT_EQ(results[2][i].get_vertices(), results[0][i].get_vertices()) << "Seed " << seed << ", budget " << evaluation_budget << ": The packing must not depend on the number of threads.";
+			}
+		}
+	}
+}
+
+/*!
+ * Test packing a batch of lists of convex polygons.
+ */
+TEST_F(SceneFixture, PackBatch) {
+	std::vector<std::vector<ConvexPolygon>> batch;
+	for(size_t i = 0; i < 6; ++i) {
+		batch.push_back(std::vector<ConvexPolygon>(regular_polygons.begin(), regular_polygons.begin() + i));
+	}
+	std::vector<std::vector<ConvexPolygon>> separate = batch;
+	for(std::vector<ConvexPolygon>& job : separate) {
+		Scene().pack(job);
+	}
+
+	Scene scene;
+	scene.set_num_threads(3);
+	PackStatistics statistics;
+	scene.pack_batch(batch, statistics);
+	EXPECT_GT(statistics.cache_hits, 0) << "The lists have the same shapes, so they can reuse each other's no-fit polygons.";
+	ASSERT_EQ(batch.size(), separate.size());
+	for(size_t job = 0; job < batch.size(); ++job) {
+		ASSERT_EQ(batch[job].size(), separate[job].size());
+		for(size_t i = 0; i < batch[job].size(); ++i) {
+			EXPECT_EQ(batch[job][i].get_vertices(), separate[job][i].get_vertices()) << "Packing in a batch must give the same result as packing separately.";
+		}
+	}
+}
+
+/*!
+ * Test that a batch only counts the cache lookups of its own packings, even if
+ * another packing uses the cache of the scene at the same time.
+ */
+TEST_F(SceneFixture, PackBatchStatisticsConcurrently) {
+	std::vector<std::vector<ConvexPolygon>> batch;
+	size_t lookups = 0;
+	for(size_t i = 1; i < 6; ++i) {
+		batch.push_back(std::vector<ConvexPolygon>(regular_polygons.begin(), regular_polygons.begin() + i));
+		std::vector<ConvexPolygon> separate = batch.back();
+		PackStatistics statistics;
+		Scene().pack(separate, statistics);
+		lookups += statistics.cache_hits + statistics.cache_misses;
+	}
+
+	Scene scene;
+	scene.set_num_threads(3);
+	std::thread other([this, &scene]() {
+		std::vector<ConvexPolygon> convex_polygons = regular_polygons;
+		scene.pack(convex_polygons);
+	});
+	PackStatistics statistics;
+	scene.pack_batch(batch, statistics);
+	other.join();
+	EXPECT_EQ(statistics.cache_hits + statistics.cache_misses, lookups) << "The lookups of the other packing must not be counted.";
+}
+
+/*!
+ * Test packing an empty batch.
+ */
+TEST(Scene, PackBatchEmpty) {
+	std::vector<std::vector<ConvexPolygon>> batch;
+	Scene().pack_batch(batch);
+	EXPECT_TRUE(batch.empty());
+}
+
+/*!
+ * Test that an asynchronous packing gives the same result as a blocking one.
+ */
+TEST_F(SceneFixture, PackAsync) {
+	const Scene scene;
+	std::future<std::vector<ConvexPolygon>> future = scene.pack_async(regular_polygons);
+	scene.pack(regular_polygons); //At the same time in the same scene.
+	const std::vector<ConvexPolygon> result = future.get();
+
+	ASSERT_EQ(result.size(), regular_polygons.size());
+	for(size_t i = 0; i < result.size(); ++i) {
+		EXPECT_EQ(result[i].get_vertices(), regular_polygons[i].get_vertices()) << "Packing asynchronously must not change the result.";
+	}
+}
+
+/*!
+ * Test reporting the progress of an asynchronous packing.
+ */
+TEST_F(SceneFixture, PackAsyncProgress) {
+	std::vector<PackProgress> reports;
+	const std::vector<ConvexPolygon> result = Scene().pack_async(regular_polygons, [&reports](const PackProgress& progress) {
+		reports.push_back(progress);
+	}).get();
+
+	ASSERT_EQ(reports.size(), regular_polygons.size()) << "Progress is reported once for each depth.";
+	for(size_t i = 0; i < reports.size(); ++i) {
+		EXPECT_EQ(reports[i].depth, i + 1);
+		EXPECT_EQ(reports[i].num_convex_polygons, regular_polygons.size());
+		EXPECT_GE(reports[i].best_score, 0);
+	}
+}
+
+/*!
+ * Test cancelling an asynchronous packing.
+ */
+TEST_F(SceneFixture, PackAsyncCancel) {
+	Cancellation cancellation;
+	size_t num_reports = 0;
+	const std::vector<ConvexPolygon> result = Scene().pack_async(regular_polygons, [&cancellation, &num_reports](const PackProgress&) {
+		++num_reports;
+		cancellation.cancel(); //Cancel as soon as the packing has started.
+	}, cancellation).get();
+
+	EXPECT_EQ(num_reports, 1) << "The packing must stop at the first opportunity after it was cancelled.";
+	ASSERT_EQ(result.size(), regular_polygons.size());
+	for(size_t i = 0; i < result.size(); ++i) {
+		EXPECT_EQ(result[i].get_vertices(), regular_polygons[i].get_vertices()) << "A cancelled packing leaves the convex polygons unpacked.";
+	}
+}
+
+/*!
+ * Test cancelling an asynchronous packing while it completes the best candidate
+ * greedily, after its budget ran out.
+ */
+TEST_F(SceneFixture, PackAsyncCancelGreedy) {
+	Scene scene;
+	scene.set_evaluation_budget(1); //Runs out at the first depth, so the rest is completed greedily.
+	scene.set_deterministic(true);
+	Cancellation cancellation;
+	size_t num_reports = 0;
+	const std::vector<ConvexPolygon> result = scene.pack_async(regular_polygons, [&cancellation, &num_reports](const PackProgress& progress) {
+		++num_reports;
+		if(progress.depth == 3) {
+			cancellation.cancel(); //Cancel halfway through completing the packing.
+		}
+	}, cancellation).get();
+
+	EXPECT_EQ(num_reports, 3) << "The greedy completion must stop at the first opportunity after it was cancelled.";
+	ASSERT_EQ(result.size(), regular_polygons.size());
+	for(size_t i = 0; i < result.size(); ++i) {
+		EXPECT_EQ(result[i].get_vertices(), regular_polygons[i].get_vertices()) << "A cancelled packing leaves the convex polygons unpacked.";
+	}
+}
+
+/*!
+ * Test running an asynchronous packing on an executor of the caller.
+ */
+TEST_F(SceneFixture, PackAsyncExecutor) {
+	const Scene scene; //Must outlive the packing.
+	std::vector<std::thread> threads;
+	std::future<std::vector<ConvexPolygon>> future = scene.pack_async(regular_polygons, ProgressCallback(), Cancellation(), [&threads](std::function<void()> task) {
+		threads.emplace_back(task);
+	});
+	ASSERT_EQ(threads.size(), 1) << "The packing must be given to the executor.";
+	const std::vector<ConvexPolygon> result = future.get();
+	threads[0].join();
+
+	ASSERT_EQ(result.size(), regular_polygons.size());
+	for(size_t i = 0; i < result.size(); ++i) {
+		for(size_t j = i + 1; j < result.size(); ++j) {
+			EXPECT_FALSE(result[i].collides(result[j])) << "Packed convex polygons " << i << " and " << j << " must not overlap.";
+		}
+	}
+}
+
+/*!
+ * Test measuring what the packing spent its time on.
+ */
+TEST_F(SceneFixture, PackStatistics) {
+	PackStatistics statistics;
+	statistics.collision_tests = 1000000; //Must be cleared before packing.
+	Scene().pack(regular_polygons, statistics);
+
+	EXPECT_EQ(statistics.depth_times.size(), regular_polygons.size()) << "There is one depth for each convex polygon packed.";
+	for(const double time : statistics.depth_times) {
+		EXPECT_GE(time, 0);
+	}
+	EXPECT_GT(statistics.cache_misses, 0) << "The cache was empty, so no-fit polygons had to be computed.";
+#ifdef CONVACK_STATISTICS
+	EXPECT_GT(statistics.candidates_generated, 0);
+	EXPECT_GT(statistics.candidates_pruned, 0) << "The beam is too narrow for all candidates.";
+	EXPECT_GT(statistics.score_evaluations, 0);
+	EXPECT_GT(statistics.hull_computations, 0);
+	EXPECT_GT(statistics.collision_tests, 0);
+	EXPECT_GT(statistics.allocations, 0) << "A new scene has no memory for candidates yet.";
+#else
+	EXPECT_EQ(statistics.collision_tests, 0) << "Without the statistics option, operations are not counted.";
+#endif
+}
+
+/*!
+ * Test that packings in the same scene at the same time only count their own
+ * lookups in the cache of the scene.
+ */
+TEST_F(SceneFixture, PackStatisticsConcurrently) {
+	PackStatistics alone;
+	std::vector<ConvexPolygon> convex_polygons = regular_polygons;
+	Scene().pack(convex_polygons, alone);
+	const size_t lookups = alone.cache_hits + alone.cache_misses;
+	ASSERT_GT(lookups, 0);
+
+	const Scene scene;
+	std::vector<PackStatistics> statistics(4);
+	std::vector<std::thread> threads;
+	for(size_t i = 0; i < statistics.size(); ++i) {
+		threads.emplace_back([this, &scene, &statistics, i]() {
+			std::vector<ConvexPolygon> copy = regular_polygons;
+			scene.pack(copy, statistics[i]);
+		});
+	}
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+	for(const PackStatistics& packing : statistics) {
+		EXPECT_EQ(packing.cache_hits + packing.cache_misses, lookups) << "Each packing looks up the same no-fit polygons as on its own, regardless of the other packings.";
+	}
+}
+
+}
@@ -0,0 +1,217 @@
+/*
+ * Library to pack convex polygons into arbitrary shapes.
+ * Any copyright is dedicated to the public domain. See LICENSE.md for more details.
+ */
+
+#include <gtest/gtest.h> //To run the test.
+#include <vector> //To store the convex polygons to index.
+
+#include "bounding_box.hpp" //To query the index.
+#include "convex_polygon.hpp" //To store in the index.
+#include "point2.hpp" //To construct convex polygons and bounding boxes.
+#include "spatial_index.hpp" //The unit under test.
+
+namespace convack {
+
+/*!
+ * Fixture with a grid of squares to put in the index.
+ */
+class SpatialIndexFixture : public testing::Test {
+public:
+	/*!
+	 * A 10 by 10 grid of squares of 10 by 10 units, with 5 units between them.
+	 */
+	std::vector<ConvexPolygon> squares;
+
+	/*!
+	 * Prepare to run a test. This creates the fixture members.
+	 */
+	void SetUp() {
+		squares.clear();
+		for(size_t x = 0; x < 10; ++x) {
+			for(size_t y = 0; y < 10; ++y) {
+				ConvexPolygon square({Point2(0, 0), Point2(10, 0), Point2(10, 10), Point2(0, 10)});
+				square.translate(x * 15, y * 15);
+				squares.push_back(square);
+			}
+		}
+	}
+
+	/*!
+	 * Create a bounding box from its corners.
+	 * \param min_x The lowest X coordinate of the bounding box.
+	 * \param min_y The lowest Y coordinate of the bounding box.
+	 * \param max_x The highest X coordinate of the bounding box.
+	 * \param max_y The highest Y coordinate of the bounding box.
+	 * \return A bounding box with those corners.
+	 */
+	BoundingBox box(const coordinate_t min_x, const coordinate_t min_y, const coordinate_t max_x, const coordinate_t max_y) {
+		return BoundingBox({Point2(min_x, min_y), Point2(max_x, max_y)});
+	}
+};
+
+/*!
+ * Test querying an empty index.
+ */
+TEST_F(SpatialIndexFixture, QueryEmpty) {
+	const SpatialIndex index(10);
+	std::vector<const ConvexPolygon*> result;
+	index.query(box(-1000, -1000, 1000, 1000), result);
+	EXPECT_TRUE(result.empty()) << "There is nothing in the index to find.";
+	EXPECT_FALSE(index.collides(squares[0])) << "There is nothing in the index to collide with.";
+}
+
+/*!
+ * Test inserting convex polygons in the index.
+ */
+TEST_F(SpatialIndexFixture, Insert) {
+	SpatialIndex index(10);
+	for(const ConvexPolygon& square : squares) {
+		index.insert(&square);
+	}
+	EXPECT_EQ(index.size(), squares.size()) << "All squares were inserted.";
+
+	index.clear();
+	EXPECT_EQ(index.size(), 0) << "After clearing, the index is empty.";
+}
+
+/*!
+ * Test finding a single convex polygon.
+ */
+TEST_F(SpatialIndexFixture, QuerySingle) {
+	SpatialIndex index(10);
+	for(const ConvexPolygon& square : squares) {
+		index.insert(&square);
+	}
+	std::vector<const ConvexPolygon*> result;
+	index.query(box(31, 46, 32, 47), result); //Inside of the square at 30,45.
+	ASSERT_EQ(result.size(), 1) << "Only one square is in this area.";
+	EXPECT_EQ(result[0], &squares[2 * 10 + 3]) << "This is the square at 30,45.";
+}
+
+/*!
+ * Test finding convex polygons in between the grid of squares.
+ */
+TEST_F(SpatialIndexFixture, QueryGap) {
+	SpatialIndex index(10);
+	for(const ConvexPolygon& square : squares) {
+		index.insert(&square);
+	}
+	std::vector<const ConvexPolygon*> result;
+	index.query(box(11, 11, 14, 14), result);
+	EXPECT_TRUE(result.empty()) << "This area is in the gap between the squares.";
+	index.query(box(10, 10, 15, 15), result);
+	EXPECT_TRUE(result.empty()) << "This area only touches the squares, which is not considered to be overlapping.";
+}
+
+/*!
+ * Test finding multiple convex polygons in a larger area.
+ */
+TEST_F(SpatialIndexFixture, QueryMultiple) {
+	SpatialIndex index(10);
+	for(const ConvexPolygon& square : squares) {
+		index.insert(&square);
+	}
+	std::vector<const ConvexPolygon*> result;
+	index.query(box(5, 5, 20, 20), result);
+	ASSERT_EQ(result.size(), 4) << "This area overlaps with the squares at 0,0, 0,15, 15,0 and 15,15.";
+	EXPECT_EQ(result[0], &squares[0]) << "The results are in the order in which they were inserted.";
+	EXPECT_EQ(result[1], &squares[1]);
+	EXPECT_EQ(result[2], &squares[10]);
+	EXPECT_EQ(result[3], &squares[11]);
+
+	result.clear();
+	index.query(box(-1000, -1000, 1000, 1000), result);
+	EXPECT_EQ(result.size(), squares.size()) << "All squares are in this huge area, and each is found only once.";
+}
+
+/*!
+ * Test finding the indices of convex polygons, rather than the convex polygons
+ * themselves.
+ */
+TEST_F(SpatialIndexFixture, QueryIndices) {
+	SpatialIndex index(10);
+	for(const ConvexPolygon& square : squares) {
+		index.insert(&square);
+	}
+	std::vector<size_t> result;
+	index.query(box(5, 5, 20, 20), result);
+	ASSERT_EQ(result.size(), 4) << "This area overlaps with the squares at 0,0, 0,15, 15,0 and 15,15.";
+	EXPECT_EQ(result[0], 0) << "The indices are in the order in which the squares were inserted.";
+	EXPECT_EQ(result[1], 1);
+	EXPECT_EQ(result[2], 10);
+	EXPECT_EQ(result[3], 11);
+}
+
+/*!
+ * Test finding a convex polygon that is much larger than the cells.
+ */
+TEST_F(SpatialIndexFixture, QueryOversized) {
+	SpatialIndex index(1);
+	const ConvexPolygon huge({Point2(0, 0), Point2(1000, 0), Point2(1000, 1000), Point2(0, 1000)});
+	index.insert(&huge);
+	std::vector<const ConvexPolygon*> result;
+	index.query(box(500, 500, 501, 501), result);
+	ASSERT_EQ(result.size(), 1) << "The huge square covers this area.";
+	EXPECT_EQ(result[0], &huge);
+
+	result.clear();
+	index.query(box(2000, 2000, 2001, 2001), result);
+	EXPECT_TRUE(result.empty()) << "The huge square doesn't extend this far.";
+}
+
+/*!
+ * Test collision against the convex polygons in the index.
+ */
+TEST_F(SpatialIndexFixture, Collides) {
+	SpatialIndex index(10);
+	for(const ConvexPolygon& square : squares) {
+		index.insert(&square);
+	}
+	ConvexPolygon probe({Point2(0, 0), Point2(4, 0), Point2(4, 4), Point2(0, 4)});
+	probe.translate(10.5, 10.5);
+	EXPECT_FALSE(index.collides(probe)) << "The probe is in the gap between the squares.";
+	probe.translate(5, 5);
+	EXPECT_TRUE(index.collides(probe)) << "The probe is now inside of the square at 15,15.";
+}
+
+/*!
+ * Test collision against convex polygons that cover multiple cells, also when
+ * the probe covers more cells than are in use.
+ */
+TEST_F(SpatialIndexFixture, CollidesAcrossCells) {
+	SpatialIndex index(5);
+	index.insert(&squares[0]); //Covers 3 by 3 cells.
+	const ConvexPolygon small_probe({Point2(4, 4), Point2(6, 4), Point2(6, 6), Point2(4, 6)});
+	EXPECT_TRUE(index.collides(small_probe)) << "The probe is inside of the square, on the border between its cells.";
+
+	const ConvexPolygon gap_strip({Point2(-100, 11), Point2(300, 11), Point2(300, 14), Point2(-100, 14)});
+	EXPECT_FALSE(index.collides(gap_strip)) << "The strip passes above the square.";
+	const ConvexPolygon crossing_strip({Point2(-100, 5), Point2(300, 5), Point2(300, 8), Point2(-100, 8)});
+	EXPECT_TRUE(index.collides(crossing_strip)) << "The strip goes through the square.";
+}
+
+/*!
+ * Test filling the index again after clearing it.
+ */
+TEST_F(SpatialIndexFixture, ClearAndRefill) {
+	SpatialIndex index(10);
+	for(const ConvexPolygon& square : squares) {
+		index.insert(&square);
+	}
+	index.clear();
+	EXPECT_EQ(index.size(), 0);
+	std::vector<size_t> result;
+	index.query(box(-1000, -1000, 1000, 1000), result);
+	EXPECT_TRUE(result.empty()) << "The cells are kept, but they must not contain anything any more.";
+	EXPECT_FALSE(index.collides(squares[0]));
+
+	index.insert(&squares[11]);
+	index.query(box(10, 10, 40, 40), result);
+	ASSERT_EQ(result.size(), 1) << "Only the square inserted after clearing is in the index.";
+	EXPECT_EQ(result[0], 0) << "Indices start over after clearing.";
+	EXPECT_TRUE(index.collides(squares[11]));
+	EXPECT_FALSE(index.collides(squares[0]));
+}
+
+}
@@ -5,6 +5,7 @@
 
 #include <cmath> //To construct turns in radians.
 #include <gtest/gtest.h> //To run the test.
+#include <vector> //To transform lists of points.
 
 #include "point2.hpp" //To create points to transform.
 #include "transformation.hpp" //The unit under test.
@@ -73,4 +74,41 @@ TEST(Transformation, RotationTranslation) {
 	expect_points_eq(transformation.apply(Point2(5, 0)), Point2(-5, 10), "First rotate half a turn, which moves the point to -5,0, then translate further towards positive Y.");
 }
 
+/*!
+ * Test transforming a list of points at once.
+ *
+ * This must give exactly the same result as transforming the points one by one.
+ */
+TEST(Transformation, ApplyList) {
+	const Transformation transformation = Transformation().translate(5, -2).rotate(1.234).translate(0.5, 0.25);
+	std::vector<Point2> points;
+	for(size_t i = 0; i < 37; ++i) { //Some number of points that isn't a multiple of any vector size.
+		points.emplace_back(i * 1.5, 100.0 - i * i);
+	}
+	std::vector<Point2> transformed = points;
+	transformation.apply(transformed);
+
+	ASSERT_EQ(transformed.size(), points.size()) << "Transforming doesn't create or destroy points.";
+	for(size_t i = 0; i < points.size(); ++i) {
+		EXPECT_EQ(transformed[i], transformation.apply(points[i])) << "Transforming a list of points must give the same result as transforming each point.";
+	}
+}
+
+
+/*!
+ * Test that transforming points rounds to the nearest coordinate.
+ */
+TEST(Transformation, Rounding) {
+	const double pi = std::acos(-1);
+	const Transformation rotation = Transformation().rotate(pi / 4);
+	const Point2 result = rotation.apply(Point2(10, 0));
+#ifdef CONVACK_FIXED_POINT
+	EXPECT_EQ(result, Point2(7, 7)) << "The rotated point is at (7.07, 7.07), which is nearest to (7, 7).";
+	EXPECT_EQ(Transformation().rotate(pi).apply(Point2(10, 0)), Point2(-10, 0)) << "Rounding to the nearest coordinate, not truncating, is why this doesn't end up at (-9, 0).";
+#else
+	EXPECT_NEAR(result.x, std::sqrt(50.0), 0.0001) << "Floating point coordinates don't get rounded.";
+	EXPECT_NEAR(result.y, std::sqrt(50.0), 0.0001) << "Floating point coordinates don't get rounded.";
+#endif
+}
+
 }
\ No newline at end of file